@@ -0,0 +1,5 @@
+/// @file
+
+// Prepended to thekernel1.cl/thekernel2.cl (or velocity_verlet1.cl/velocity_verlet2.cl) when
+// SLEEPING is enabled: the kernels then run over the compacted active node indexes only.
+#define ACTIVE_SET
@@ -0,0 +1,186 @@
+/// @file
+
+// Backward Euler, 1st kernel: right hand side and Jacobi preconditioner of the linear system
+// (M + dt*C - dt^2*K)*dV = dt*(F_n + dt*K*V_n), solved for the velocity increment "dV"
+// by the conjugate gradient kernels (cg_*.cl). "K" is the stiffness matrix d(F)/d(P), never assembled.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        PARAMETER float*    dt_simulation,                      // Simulation time step [s].
+                        __global float4*    solution,                           // CG solution: velocity increment [m/s].
+                        __global float4*    residual,                           // CG residual [N*s].
+                        __global float4*    direction,                          // CG search direction [m/s].
+                        __global float4*    product,                            // CG system matrix times search direction [N*s].
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner [1/kg].
+                        __global float*     partial,                            // CG partial sums [#].
+                        __global float*     scalars)                            // CG scalars [#].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////// SYNERGIC MOLECULE: KINEMATIC VARIABLES /////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      P   = position[gid];                                              // Position @ t_n [m].
+  float4      V   = velocity[gid];                                              // Velocity @ t_n [m/s].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////// SYNERGIC MOLECULE: DYNAMIC VARIABLES ///////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      m   = mass[PARAM(gid)];                                           // Mass [kg].
+  float4      g   = gravity[PARAM(gid)];                                        // Gravity [m/s^2]
+  float4      C   = friction[PARAM(gid)];                                       // Friction coefficient.
+  float4      fr  = freedom[gid];                                               // Freedom flag [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////// SYNERGIC MOLECULE: LINK INDEXES /////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  // NOTE: 1. the index of a non-existing particle friend must be set to the index of the particle.
+  int4        neighbours = neighbour[gid];                                      // Getting neighbour indexes (single load) [#]...
+  long        n_R = neighbours.x;                                               // Setting right neighbour index [#]...
+  long        n_U = neighbours.y;                                               // Setting up neighbour index [#]...
+  long        n_L = neighbours.z;                                               // Setting left neighbour index [#]...
+  long        n_D = neighbours.w;                                               // Setting down neighbour index [#]...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////// SYNERGIC MOLECULE: LINKED PARTICLE POSITIONS /////////////////  t_n
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      P_R = position[n_R];                                              // Right neighbour position [m].
+  float4      P_U = position[n_U];                                              // Up neighbour position [m].
+  float4      P_L = position[n_L];                                              // Left neighbour position [m].
+  float4      P_D = position[n_D];                                              // Down neighbour position [m].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////// SYNERGIC MOLECULE: LINKED PARTICLE VELOCITIES ////////////////  t_n
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      V_R = velocity[n_R];                                              // Right neighbour velocity [m/s].
+  float4      V_U = velocity[n_U];                                              // Up neighbour velocity [m/s].
+  float4      V_L = velocity[n_L];                                              // Left neighbour velocity [m/s].
+  float4      V_D = velocity[n_D];                                              // Down neighbour velocity [m/s].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////// SYNERGIC MOLECULE: LINK RESTING DISTANCES /////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      resting_R = resting[PARAM(n_R)];                                  // Setting right neighbour resting position [m]...
+  float4      resting_U = resting[PARAM(n_U)];                                  // Setting up neighbour resting position [m]...
+  float4      resting_L = resting[PARAM(n_L)];                                  // Setting left neighbour resting position [m]...
+  float4      resting_D = resting[PARAM(n_D)];                                  // Setting down neighbour resting position [m]...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////// SYNERGIC MOLECULE: LINK STIFFNESS ///////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  // NOTE: the stiffness of a non-existing link must reset to 0.
+  float4      k_R = stiffness[PARAM(n_R)];                                      // Setting right neighbour stiffness...
+  float4      k_U = stiffness[PARAM(n_U)];                                      // Setting up neighbour stiffness...
+  float4      k_L = stiffness[PARAM(n_L)];                                      // Setting left neighbour stiffness...
+  float4      k_D = stiffness[PARAM(n_D)];                                      // Setting down neighbour stiffness...
+
+  //////////////////////////////////////////////////////////////////////////////
+  ////////////////////////// BACKWARD EULER: LINEAR SYSTEM /////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  // TIME STEP:
+  float dt = dt_simulation[PARAM(gid)];                                         // Setting simulation time step [s]...
+
+  // NEIGHBOURS DISPLACEMENTS:
+  float4      D_R;                                                              // Right neighbour displacement [m]...
+  float4      D_U;                                                              // Up neighbour displacement [m]...
+  float4      D_L;                                                              // Left neighbour displacement [m]...
+  float4      D_D;                                                              // Down neighbour displacement [m]...
+
+  // NODE FORCE:
+  float4      F;                                                                // Node force @ t_n [N].
+
+  // STIFFNESS MATRIX TERMS:
+  float4      KV;                                                               // Stiffness matrix times velocity [N/s].
+  float4      KD;                                                               // Stiffness matrix diagonal [N/m].
+
+  // LINEAR SYSTEM:
+  float4      b;                                                                // Right hand side [N*s].
+  float4      M;                                                                // Inverse Jacobi preconditioner [1/kg].
+
+  // COMPUTING LINK DISPLACEMENTS:
+  link_displacements(
+                      P_R,                                                      // Right neighbour position [m].
+                      P_U,                                                      // Up neighbour position [m].
+                      P_L,                                                      // Left neighbour position [m].
+                      P_D,                                                      // Down neighbour position [m].
+                      P,                                                        // Position [m].
+                      resting_R,                                                // Right neighbour resting position [m].
+                      resting_U,                                                // Up neighbour resting position [m].
+                      resting_L,                                                // Left neighbour resting position [m].
+                      resting_D,                                                // Down neighbour resting position [m].
+                      fr,                                                       // Freedom flag [#].
+                      &D_R,                                                     // Right neighbour displacement [m].
+                      &D_U,                                                     // Up neighbour displacement [m].
+                      &D_L,                                                     // Left neighbour displacement [m].
+                      &D_D                                                      // Down neighbour displacement [m].
+                    );
+
+  // COMPUTING NODE FORCE:
+  F = node_force  (
+                    k_R,                                                        // Right neighbour stiffness.
+                    k_U,                                                        // Up neighbour stiffness.
+                    k_L,                                                        // Left neighbour stiffness.
+                    k_D,                                                        // Down neighbour stiffness.
+                    D_R,                                                        // Right neighbour displacement [m].
+                    D_U,                                                        // Up neighbour displacement [m].
+                    D_L,                                                        // Left neighbour displacement [m].
+                    D_D,                                                        // Down neighbour displacement [m].
+                    C,                                                          // Friction coefficient.
+                    V,                                                          // Velocity [m/s].
+                    m,                                                          // Mass [kg].
+                    g,                                                          // Gravity [m/s^2].
+                    fr                                                          // Freedom flag [#].
+                  );
+
+  // COMPUTING STIFFNESS MATRIX TIMES VELOCITY ("x" = horizontal links, "y" = vertical links):
+  KV = link_jacobian(P_R - P, resting_R.x, k_R.x, V_R - V) +
+       link_jacobian(P_U - P, resting_U.y, k_U.y, V_U - V) +
+       link_jacobian(P_L - P, resting_L.x, k_L.x, V_L - V) +
+       link_jacobian(P_D - P, resting_D.y, k_D.y, V_D - V);
+
+  // COMPUTING STIFFNESS MATRIX DIAGONAL:
+  KD = link_jacobian_diagonal(P_R - P, resting_R.x, k_R.x) +
+       link_jacobian_diagonal(P_U - P, resting_U.y, k_U.y) +
+       link_jacobian_diagonal(P_L - P, resting_L.x, k_L.x) +
+       link_jacobian_diagonal(P_D - P, resting_D.y, k_D.y);
+
+  // COMPUTING RIGHT HAND SIDE (constrained nodes have no increment):
+  b = fr*dt*(F + dt*KV);                                                        // Computing right hand side [N*s]...
+  b.w = 0.0f;                                                                   // Nullifying 4th projective component...
+
+  // COMPUTING INVERSE JACOBI PRECONDITIONER:
+  M = fr/(m.x + dt*C.x + dt*dt*KD);                                             // Computing inverse diagonal [1/kg]...
+  M.w = 0.0f;                                                                   // Nullifying 4th projective component...
+
+  // INITIALIZING CONJUGATE GRADIENT (dV = 0, search direction reset by the 1st "cg_direction"):
+  solution[gid] = (float4)(0.0f, 0.0f, 0.0f, 0.0f);                             // Initializing solution [m/s]...
+  residual[gid] = b;                                                            // Initializing residual [N*s]...
+  direction[gid] = (float4)(0.0f, 0.0f, 0.0f, 0.0f);                            // Initializing search direction [m/s]...
+  product[gid] = (float4)(0.0f, 0.0f, 0.0f, 0.0f);                              // Initializing matrix product [N*s]...
+  preconditioner[gid] = M;                                                      // Setting preconditioner [1/kg]...
+
+  if(gid == 0)
+  {
+    scalars[CG_RZ] = 1.0f;                                                      // Resetting residual norm...
+    scalars[CG_RZ0] = -1.0f;                                                    // Resetting initial residual norm...
+    scalars[CG_ALPHA] = 0.0f;                                                   // Resetting step length...
+    scalars[CG_BETA] = 0.0f;                                                    // Resetting direction update factor...
+    scalars[CG_DONE] = 0.0f;                                                    // Resetting convergence flag...
+    scalars[CG_ITER] = 0.0f;                                                    // Resetting # of iterations...
+  }
+}
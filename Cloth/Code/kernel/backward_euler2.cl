@@ -0,0 +1,73 @@
+/// @file
+
+// Backward Euler, 2nd kernel: V_(n+1) = V_n + dV and P_(n+1) = P_n + dt*V_(n+1), with the velocity
+// increment "dV" solved by the conjugate gradient kernels.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        PARAMETER float*    dt_simulation,                      // Simulation time step [s].
+                        __global float4*    solution,                           // CG solution: velocity increment [m/s].
+                        __global float4*    residual,                           // CG residual [N*s].
+                        __global float4*    direction,                          // CG search direction [m/s].
+                        __global float4*    product,                            // CG system matrix times search direction [N*s].
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner [1/kg].
+                        __global float*     partial,                            // CG partial sums [#].
+                        __global float*     scalars)                            // CG scalars [#].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////// SYNERGIC MOLECULE: KINEMATIC VARIABLES /////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      P   = position[gid];                                              // Position @ t_n [m].
+  float4      V   = velocity[gid];                                              // Velocity @ t_n [m/s].
+  float4      dV  = solution[gid];                                              // Velocity increment [m/s].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////// SYNERGIC MOLECULE: DYNAMIC VARIABLES ///////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      fr  = freedom[gid];                                               // Freedom flag [#].
+  float4      col = depth[gid];                                                 // Current node color.
+
+  //////////////////////////////////////////////////////////////////////////////
+  ////////////////////////// BACKWARD EULER INTEGRATION ////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  // TIME STEP:
+  float dt = dt_simulation[PARAM(gid)];                                         // Setting simulation time step [s]...
+
+  // NODE ACCELERATION:
+  float4      A   = dV/dt;                                                      // Node acceleration [m/s^2].
+
+  // UPDATING VELOCITY AND POSITION:
+  V += fr*dV;                                                                   // Computing velocity @ t_(n+1) [m/s]...
+  P += fr*V*dt;                                                                 // Computing position @ t_(n+1) [m]...
+
+  // FIXING PROJECTIVE SPACE:
+  fix_projective_space(&P);                                                     // Fixing position [m]...
+  fix_projective_space(&V);                                                     // Fixing velocity [m/s]...
+  fix_projective_space(&A);                                                     // Fixing acceleration [m/s^2]...
+
+  // ASSIGNING DEPTH COLOR:
+  assign_color(&col, &P);                                                       // Assigning depth color [#]...
+
+  // UPDATING KINEMATICS:
+  position[gid] = P;                                                            // Updating position [m]...
+  velocity[gid] = V;                                                            // Updating velocity [m/s]...
+  acceleration[gid] = A;                                                        // Updating acceleration [m/s^2]...
+  depth[gid] = col;                                                             // Updating color [#]...
+}
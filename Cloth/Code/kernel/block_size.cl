@@ -0,0 +1,8 @@
+/// @file
+
+// Temporal blocking sizes (BLOCKED), shared by the host and the kernels: main.cpp includes this file
+// (BLOCK_STEPS is BLOCK_T) and the kernels are compiled with it prepended to velocity_verlet_blocked.cl,
+// hence the # of time steps per launch is the same on both sides.
+#define BLOCK_X                   8                                             // Block "x" size [#].
+#define BLOCK_Y                   8                                             // Block "y" size [#].
+#define BLOCK_T                   4                                             // # of time steps per launch (halo width) [#].
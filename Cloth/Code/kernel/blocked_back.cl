@@ -0,0 +1,6 @@
+/// @file
+
+// Prepended to the 2nd velocity_verlet_blocked.cl kernel when BLOCKED is enabled: it reads the state
+// from the intermediate buffers, written by the 1st kernel, and writes it back to (position, velocity,
+// acceleration), hence the two launches ping-pong between the two buffer sets.
+#define BLOCK_BACK
@@ -0,0 +1,56 @@
+/// @file
+
+// Conjugate gradient: step length alpha = (r*z)/(p*q), reducing the partial sums of "cg_matvec"
+// (single work-item).
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global float4*    solution,                           // CG solution: velocity increment [m/s].
+                        __global float4*    residual,                           // CG residual [N*s].
+                        __global float4*    direction,                          // CG search direction [m/s].
+                        __global float4*    product,                            // CG system matrix times search direction [N*s].
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner [1/kg].
+                        __global float*     partial,                            // CG partial sums [#].
+                        __global float*     scalars)                            // CG scalars [#].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////// CONJUGATE GRADIENT: ALPHA //////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long groups = (unsigned long)scalars[CG_GROUPS];                     // Setting # of partial sums [#]...
+  unsigned long n;                                                              // Partial sum index [#].
+  float       pq = 0.0f;                                                        // Direction*product.
+
+  if(scalars[CG_DONE] != 0.0f)
+  {
+    return;                                                                     // Already converged.
+  }
+
+  for(n = 0; n < groups; n++)
+  {
+    pq += partial[n];                                                           // Reducing partial sums...
+  }
+
+  if(pq > 0.0f)
+  {
+    scalars[CG_ALPHA] = scalars[CG_RZ]/pq;                                      // Computing step length...
+    scalars[CG_ITER] += 1.0f;                                                   // Counting iterations...
+  }
+
+  else
+  {
+    scalars[CG_ALPHA] = 0.0f;                                                   // Null search direction: stopping...
+    scalars[CG_DONE] = 1.0f;                                                    // Setting convergence flag...
+  }
+}
@@ -0,0 +1,58 @@
+/// @file
+
+// Conjugate gradient: direction update factor beta = (r*z)_new/(r*z)_old, reducing the partial sums
+// of "cg_update", and convergence check on the relative preconditioned residual (single work-item).
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global float4*    solution,                           // CG solution: velocity increment [m/s].
+                        __global float4*    residual,                           // CG residual [N*s].
+                        __global float4*    direction,                          // CG search direction [m/s].
+                        __global float4*    product,                            // CG system matrix times search direction [N*s].
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner [1/kg].
+                        __global float*     partial,                            // CG partial sums [#].
+                        __global float*     scalars)                            // CG scalars [#].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////// CONJUGATE GRADIENT: BETA ///////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long groups = (unsigned long)scalars[CG_GROUPS];                     // Setting # of partial sums [#]...
+  unsigned long n;                                                              // Partial sum index [#].
+  float       rz = 0.0f;                                                        // Residual*preconditioned residual.
+  float       tol = scalars[CG_TOL];                                            // Relative tolerance.
+
+  if(scalars[CG_DONE] != 0.0f)
+  {
+    return;                                                                     // Already converged.
+  }
+
+  for(n = 0; n < groups; n++)
+  {
+    rz += partial[n];                                                           // Reducing partial sums...
+  }
+
+  if(scalars[CG_RZ0] < 0.0f)
+  {
+    scalars[CG_RZ0] = rz;                                                       // Setting initial residual norm...
+  }
+
+  scalars[CG_BETA] = rz/scalars[CG_RZ];                                         // Computing direction update factor...
+  scalars[CG_RZ] = rz;                                                          // Updating residual norm...
+
+  if(rz <= tol*tol*scalars[CG_RZ0])
+  {
+    scalars[CG_DONE] = 1.0f;                                                    // Setting convergence flag...
+  }
+}
@@ -0,0 +1,41 @@
+/// @file
+
+// Conjugate gradient: direction = preconditioned residual + beta*direction.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global float4*    solution,                           // CG solution: velocity increment [m/s].
+                        __global float4*    residual,                           // CG residual [N*s].
+                        __global float4*    direction,                          // CG search direction [m/s].
+                        __global float4*    product,                            // CG system matrix times search direction [N*s].
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner [1/kg].
+                        __global float*     partial,                            // CG partial sums [#].
+                        __global float*     scalars)                            // CG scalars [#].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////// CONJUGATE GRADIENT: DIRECTION ////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  if(scalars[CG_DONE] != 0.0f)
+  {
+    return;                                                                     // Already converged.
+  }
+
+  direction[gid] = residual[gid]*preconditioner[gid] + scalars[CG_BETA]*direction[gid];
+}
@@ -0,0 +1,89 @@
+/// @file
+
+// Conjugate gradient: product = (M + dt*C - dt^2*K)*direction, with the stiffness matrix "K" applied
+// link by link (matrix free), and the partial sums of direction*product. Each of the "CG_GROUPS"
+// work-items loops over the nodes with a stride equal to the global size.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        PARAMETER float*    dt_simulation,                      // Simulation time step [s].
+                        __global float4*    solution,                           // CG solution: velocity increment [m/s].
+                        __global float4*    residual,                           // CG residual [N*s].
+                        __global float4*    direction,                          // CG search direction [m/s].
+                        __global float4*    product,                            // CG system matrix times search direction [N*s].
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner [1/kg].
+                        __global float*     partial,                            // CG partial sums [#].
+                        __global float*     scalars)                            // CG scalars [#].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+  unsigned long stride = get_global_size(0);                                    // Setting node stride [#]...
+  unsigned long nodes = (unsigned long)scalars[CG_NODES];                       // Setting # of nodes [#]...
+  unsigned long i;                                                              // Node index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////// CONJUGATE GRADIENT: A*p ////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      P;                                                                // Position @ t_n [m].
+  float4      p;                                                                // Search direction [m/s].
+  float4      q;                                                                // Matrix product [N*s].
+  float4      m;                                                                // Mass [kg].
+  float4      C;                                                                // Friction coefficient.
+  float4      fr;                                                               // Freedom flag [#].
+  float       dt;                                                               // Simulation time step [s].
+  int4        neighbours;                                                       // Neighbour indexes (R, U, L, D) [#].
+  long        n_R;                                                              // Right neighbour index [#].
+  long        n_U;                                                              // Up neighbour index [#].
+  long        n_L;                                                              // Left neighbour index [#].
+  long        n_D;                                                              // Down neighbour index [#].
+  float4      Kp;                                                               // Stiffness matrix times direction [N/s].
+  float       pq = 0.0f;                                                        // Partial sum of direction*product.
+
+  if(scalars[CG_DONE] != 0.0f)
+  {
+    return;                                                                     // Already converged.
+  }
+
+  for(i = gid; i < nodes; i += stride)
+  {
+    P   = position[i];                                                          // Getting position [m]...
+    p   = direction[i];                                                         // Getting search direction [m/s]...
+    m   = mass[PARAM(i)];                                                       // Getting mass [kg]...
+    C   = friction[PARAM(i)];                                                   // Getting friction coefficient...
+    fr  = freedom[i];                                                           // Getting freedom flag [#]...
+    dt  = dt_simulation[PARAM(i)];                                              // Getting simulation time step [s]...
+    neighbours = neighbour[i];                                                  // Getting neighbour indexes (single load) [#]...
+    n_R = neighbours.x;                                                         // Getting right neighbour index [#]...
+    n_U = neighbours.y;                                                         // Getting up neighbour index [#]...
+    n_L = neighbours.z;                                                         // Getting left neighbour index [#]...
+    n_D = neighbours.w;                                                         // Getting down neighbour index [#]...
+
+    // COMPUTING STIFFNESS MATRIX TIMES DIRECTION ("x" = horizontal links, "y" = vertical links):
+    Kp = link_jacobian(position[n_R] - P, resting[PARAM(n_R)].x, stiffness[PARAM(n_R)].x, direction[n_R] - p) +
+         link_jacobian(position[n_U] - P, resting[PARAM(n_U)].y, stiffness[PARAM(n_U)].y, direction[n_U] - p) +
+         link_jacobian(position[n_L] - P, resting[PARAM(n_L)].x, stiffness[PARAM(n_L)].x, direction[n_L] - p) +
+         link_jacobian(position[n_D] - P, resting[PARAM(n_D)].y, stiffness[PARAM(n_D)].y, direction[n_D] - p);
+
+    // COMPUTING MATRIX PRODUCT (constrained nodes have no increment):
+    q = fr*((m.x + dt*C.x)*p - dt*dt*Kp);                                       // Computing matrix product [N*s]...
+    q.w = 0.0f;                                                                 // Nullifying 4th projective component...
+
+    product[i] = q;                                                             // Updating matrix product [N*s]...
+    pq += dot(p, q);                                                            // Accumulating direction*product...
+  }
+
+  partial[gid] = pq;                                                            // Updating partial sum...
+}
@@ -0,0 +1,58 @@
+/// @file
+
+// Conjugate gradient: solution += alpha*p, residual -= alpha*q, and the partial sums of
+// residual*preconditioned residual. Each of the "CG_GROUPS" work-items loops over the nodes with a
+// stride equal to the global size.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global float4*    solution,                           // CG solution: velocity increment [m/s].
+                        __global float4*    residual,                           // CG residual [N*s].
+                        __global float4*    direction,                          // CG search direction [m/s].
+                        __global float4*    product,                            // CG system matrix times search direction [N*s].
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner [1/kg].
+                        __global float*     partial,                            // CG partial sums [#].
+                        __global float*     scalars)                            // CG scalars [#].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+  unsigned long stride = get_global_size(0);                                    // Setting node stride [#]...
+  unsigned long nodes = (unsigned long)scalars[CG_NODES];                       // Setting # of nodes [#]...
+  unsigned long i;                                                              // Node index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////// CONJUGATE GRADIENT: UPDATE /////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float       alpha = scalars[CG_ALPHA];                                        // Step length.
+  float4      r;                                                                // Residual [N*s].
+  float       rz = 0.0f;                                                        // Partial sum of residual*preconditioned residual.
+
+  if(scalars[CG_DONE] != 0.0f)
+  {
+    return;                                                                     // Already converged.
+  }
+
+  for(i = gid; i < nodes; i += stride)
+  {
+    solution[i] += alpha*direction[i];                                          // Updating solution [m/s]...
+    r = residual[i] - alpha*product[i];                                         // Updating residual [N*s]...
+    residual[i] = r;                                                            // Storing residual [N*s]...
+    rz += dot(r, r*preconditioner[i]);                                          // Accumulating residual*preconditioned residual...
+  }
+
+  partial[gid] = rz;                                                            // Updating partial sum...
+}
@@ -0,0 +1,32 @@
+/// @file
+
+// Adaptive time step, 3rd kernel: copies the time step set by dt_control.cl to all nodes.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global float4*    dt_partial,                         // Partial maxima (speed, acceleration, strain rate).
+                        __global float*     dt_limits,                          // Time step limits (see "DT_*" in utilities.cl).
+                        __global float*     elapsed)                            // Simulated time [s].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+
+  if(gid > 0)
+  {
+    dt_simulation[gid] = dt_simulation[0];                                      // Setting time step [s]...
+  }
+}
@@ -0,0 +1,66 @@
+/// @file
+
+// Adaptive time step, 2nd kernel (single work-item): reduces the partial maxima and sets the next
+// time step so that in one step no node travels more than "DT_CFL" mesh sizes and no link strain
+// changes by more than "DT_CFL".
+// The time step grows by at most "DT_GROWTH" per step and stays within [DT_MIN, DT_MAX].
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global float4*    dt_partial,                         // Partial maxima (speed, acceleration, strain rate).
+                        __global float*     dt_limits,                          // Time step limits (see "DT_*" in utilities.cl).
+                        __global float*     elapsed)                            // Simulated time [s].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////// TIME STEP CONTROL /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long groups = (unsigned long)dt_limits[DT_GROUPS];                   // Setting # of partial maxima [#]...
+  unsigned long n;                                                              // Partial maximum index [#].
+  float       dt = dt_simulation[0];                                            // Time step of the last step [s].
+  float       L = dt_limits[DT_LENGTH];                                         // Mesh size [m].
+  float       cfl = dt_limits[DT_CFL];                                          // Maximum travel and strain per step.
+  float       dt_new = dt_limits[DT_MAX];                                       // Next time step [s].
+  float       v_max = 0.0f;                                                     // Maximum speed [m/s].
+  float       a_max = 0.0f;                                                     // Maximum acceleration [m/s^2].
+  float       s_max = 0.0f;                                                     // Maximum link strain rate [1/s].
+
+  for(n = 0; n < groups; n++)
+  {
+    v_max = fmax(v_max, dt_partial[n].x);                                       // Reducing maximum speed...
+    a_max = fmax(a_max, dt_partial[n].y);                                       // Reducing maximum acceleration...
+    s_max = fmax(s_max, dt_partial[n].z);                                       // Reducing maximum strain rate...
+  }
+
+  elapsed[0] += dt;                                                             // Updating simulated time [s]...
+
+  if(v_max > 0.0f)
+  {
+    dt_new = fmin(dt_new, cfl*L/v_max);                                         // Limiting node travel...
+  }
+
+  if(a_max > 0.0f)
+  {
+    dt_new = fmin(dt_new, sqrt(2.0f*cfl*L/a_max));                              // Limiting node travel due to acceleration...
+  }
+
+  if(s_max > 0.0f)
+  {
+    dt_new = fmin(dt_new, cfl/s_max);                                           // Limiting link strain...
+  }
+
+  dt_new = fmin(dt_new, dt_limits[DT_GROWTH]*dt);                               // Limiting time step growth...
+  dt_new = fmax(dt_new, dt_limits[DT_MIN]);                                     // Enforcing minimum time step...
+  dt_simulation[0] = dt_new;                                                    // Setting next time step (see dt_broadcast.cl)...
+}
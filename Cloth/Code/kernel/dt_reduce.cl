@@ -0,0 +1,85 @@
+/// @file
+
+// Adaptive time step, 1st kernel: partial maxima of speed, acceleration and link strain rate
+// over the free nodes, one per work-item (strided loop), reduced by dt_control.cl.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global float4*    dt_partial,                         // Partial maxima (speed, acceleration, strain rate).
+                        __global float*     dt_limits,                          // Time step limits (see "DT_*" in utilities.cl).
+                        __global float*     elapsed)                            // Simulated time [s].
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+  unsigned long stride = get_global_size(0);                                    // Setting node stride [#]...
+  unsigned long nodes = (unsigned long)dt_limits[DT_NODES];                     // Setting # of nodes [#]...
+  unsigned long i;                                                              // Node index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////// PARTIAL MAXIMA //////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      P;                                                                // Position [m].
+  float4      V;                                                                // Velocity [m/s].
+  float4      A;                                                                // Acceleration [m/s^2].
+  float4      link;                                                             // Link vector [m].
+  float4      link_V;                                                           // Link relative velocity [m/s].
+  float       l;                                                                // Link length [m].
+  float       v_max = 0.0f;                                                     // Maximum speed [m/s].
+  float       a_max = 0.0f;                                                     // Maximum acceleration [m/s^2].
+  float       s_max = 0.0f;                                                     // Maximum link strain rate [1/s].
+  int4        neighbours;                                                       // Neighbour indexes (R, U, L, D) [#].
+  long        n[4];                                                             // Neighbour indexes [#].
+  int         k;                                                                // Neighbour index [#].
+
+  for(i = gid; i < nodes; i += stride)
+  {
+    if(freedom[i].x == 0.0f)
+    {
+      continue;                                                                 // Constrained node: skipping...
+    }
+
+    P    = position[i];                                                         // Getting position [m]...
+    V    = velocity[i];                                                         // Getting velocity [m/s]...
+    A    = acceleration[i];                                                     // Getting acceleration [m/s^2]...
+    V.w  = 0.0f;                                                                // Discarding projective component...
+    A.w  = 0.0f;                                                                // Discarding projective component...
+    neighbours = neighbour[i];                                                  // Getting neighbour indexes (single load) [#]...
+    n[0] = neighbours.x;                                                        // Getting right neighbour index [#]...
+    n[1] = neighbours.y;                                                        // Getting up neighbour index [#]...
+    n[2] = neighbours.z;                                                        // Getting left neighbour index [#]...
+    n[3] = neighbours.w;                                                        // Getting down neighbour index [#]...
+
+    v_max = fmax(v_max, length(V));                                             // Updating maximum speed [m/s]...
+    a_max = fmax(a_max, length(A));                                             // Updating maximum acceleration [m/s^2]...
+
+    for(k = 0; k < 4; k++)
+    {
+      link = position[n[k]] - P;                                                // Computing link vector [m]...
+      link_V = velocity[n[k]] - V;                                              // Computing link relative velocity [m/s]...
+      link.w = 0.0f;                                                            // Discarding projective component...
+      link_V.w = 0.0f;                                                          // Discarding projective component...
+      l = length(link);                                                         // Computing link length [m]...
+
+      if(l > 0.0f)
+      {
+        s_max = fmax(s_max, fabs(dot(link, link_V))/(l*l));                     // Updating maximum strain rate [1/s]...
+      }
+    }
+  }
+
+  dt_partial[gid] = (float4)(v_max, a_max, s_max, 0.0f);                        // Updating partial maxima...
+}
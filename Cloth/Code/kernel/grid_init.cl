@@ -0,0 +1,77 @@
+/// @file
+
+// Device grid generation (DEVICE_INIT): one work-item per node of a 2D NDRange spanning the grid sets
+// the initial position, state, parameters, neighbour indexes and freedom flag from the "GRID_*"
+// scalars, in place of the host loop and of the upload of the node arrays. The grid border is fixed.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global STATE*     position_int,                       // Position (intermediate) [m].
+                        __global STATE*     velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global STATE*     acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+#ifndef STENCIL
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+#endif
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global float*     grid)                               // Grid scalars (see "GRID_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  int         i   = get_global_id(0);                                           // Node "x" grid index [#].
+  int         j   = get_global_id(1);                                           // Node "y" grid index [#].
+  int         gid = i + get_global_size(0)*j;                                   // Setting global index "gid"...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////// GRID SCALARS //////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float       g   = grid[GRID_G];                                               // External gravity field [m/s^2].
+  float       k   = grid[GRID_K];                                               // Elastic constant [kg/s^2].
+  float       C   = grid[GRID_C];                                               // Damping [kg*s*m].
+  float       m   = grid[GRID_M];                                               // Node mass [kg].
+  int4        n   = grid_neighbours(i, j);                                      // Neighbour indexes (self beyond the border) [#].
+  int         bulk = (n.x != gid) && (n.y != gid) && (n.z != gid) && (n.w != gid);// Bulk node flag (border nodes are fixed).
+  float       fr  = bulk ? 1.0f : 0.0f;                                         // Freedom flag [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////// NODE KINEMATICS ////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  position[gid] = (float4)(grid[GRID_X_MIN] + i*grid[GRID_DX],
+                           grid[GRID_Y_MIN] + j*grid[GRID_DY], 0.0f, 1.0f);     // Setting position [m]...
+  depth[gid]    = (float4)(1.0f, 0.0f, 0.0f, 1.0f);                             // Setting depth color [#]...
+  store_state(velocity, gid, (float4)(0.0f, 0.0f, 0.0f, 1.0f));                 // Setting velocity [m/s]...
+  store_state(acceleration, gid, (float4)(0.0f, 0.0f, -fr*g, 1.0f));           // Setting acceleration (none on the border) [m/s^2]...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////// MESH CONNECTIVITY //////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+#ifndef STENCIL
+  neighbour[gid] = n;                                                           // Setting neighbour indexes [#]...
+#endif
+  freedom[gid]   = (float4)(fr, fr, fr, fr);                                    // Setting freedom flag [#]...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////// NODE PARAMETERS ////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  // NOTE: with UNIFORM parameters only node 0 writes the single value, with gravity on.
+  if(PARAM(gid) == gid)
+  {
+#ifdef UNIFORM
+    gravity[gid]     = (float4)(0.0f, 0.0f, -g, 1.0f);                          // Setting gravity [m/s^2]...
+#else
+    gravity[gid]     = (float4)(0.0f, 0.0f, -fr*g, 1.0f);                       // Setting gravity (none on the border) [m/s^2]...
+#endif
+    stiffness[gid]   = (float4)(k, k, k, 1.0f);                                 // Setting stiffness...
+    resting[gid]     = (float4)(grid[GRID_DX], grid[GRID_DY], grid[GRID_DZ], 1.0f);// Setting resting distance [m]...
+    friction[gid]    = (float4)(C, C, C, 1.0f);                                 // Setting friction...
+    mass[gid]        = (float4)(m, m, m, 1.0f);                                 // Setting mass [kg]...
+    dt_simulation[gid] = grid[GRID_DT];                                         // Setting time step [s]...
+  }
+}
@@ -0,0 +1,6 @@
+/// @file
+
+// Prepended (before utilities.cl) to velocity_verlet1.cl/velocity_verlet2.cl when PACKED is enabled:
+// velocity, acceleration and intermediate position are then stored as packed "x, y, z" triplets of
+// floats (12 bytes per node instead of 16). Only the position shared with OpenGL keeps its "w".
+#define PACKED
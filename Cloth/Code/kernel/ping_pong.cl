@@ -0,0 +1,6 @@
+/// @file
+
+// Prepended (before utilities.cl) to the explicit integrator kernels when PING_PONG is enabled: the
+// 2nd kernel then leaves the position @ t_(n+1) in the buffer written by the 1st kernel, instead of
+// copying it back to "position". Time steps alternate between two kernel pairs (see pong.cl).
+#define PING_PONG
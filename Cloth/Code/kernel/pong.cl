@@ -0,0 +1,6 @@
+/// @file
+
+// Prepended (before utilities.cl) to the 2nd kernel pair when PING_PONG is enabled: it reads the
+// position @ t_n from "position_int" and writes the position @ t_(n+1) to "position", hence each
+// pair of time steps ends with the current position in the buffer shared with OpenGL.
+#define PONG
@@ -0,0 +1,135 @@
+/// @file
+
+// Dynamic relaxation, 1st kernel: residual force and trial velocity of the free nodes, one strided
+// loop per work-item. The residual force excludes the viscous force: the damping of dynamic
+// relaxation is kinetic (see relaxation_check.cl). The fictitious mass of each node,
+// m = DR_MASS*dt^2*(k_R + k_U + k_L + k_D), is stable for DR_MASS > 0.5 (Gershgorin bound).
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        PARAMETER float*    dt_simulation,                      // Simulation time step [s].
+                        __global float4*    dr_partial,                         // Partial sums (kinetic energy, residual^2, load^2).
+                        __global float*     dr_scalars)                         // Dynamic relaxation scalars (see "DR_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+  unsigned long stride = get_global_size(0);                                    // Setting node stride [#]...
+  unsigned long nodes = (unsigned long)dr_scalars[DR_NODES];                    // Setting # of nodes [#]...
+  unsigned long i;                                                              // Node index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////// RESIDUAL FORCE /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float       dt = dt_simulation[0];                                            // Fictitious time step [s].
+  float       scale = dr_scalars[DR_MASS];                                      // Fictitious mass scale factor.
+  float4      P;                                                                // Position [m].
+  float4      V;                                                                // Velocity [m/s].
+  float4      m;                                                                // Mass [kg].
+  float4      g;                                                                // Gravity [m/s^2].
+  float4      fr;                                                               // Freedom flag [#].
+  int4        neighbours;                                                       // Neighbour indexes (R, U, L, D) [#].
+  long        n_R;                                                              // Right neighbour index [#].
+  long        n_U;                                                              // Up neighbour index [#].
+  long        n_L;                                                              // Left neighbour index [#].
+  long        n_D;                                                              // Down neighbour index [#].
+  float4      k_R;                                                              // Right neighbour stiffness.
+  float4      k_U;                                                              // Up neighbour stiffness.
+  float4      k_L;                                                              // Left neighbour stiffness.
+  float4      k_D;                                                              // Down neighbour stiffness.
+  float4      D_R;                                                              // Right neighbour displacement [m].
+  float4      D_U;                                                              // Up neighbour displacement [m].
+  float4      D_L;                                                              // Left neighbour displacement [m].
+  float4      D_D;                                                              // Down neighbour displacement [m].
+  float4      R;                                                                // Residual force [N].
+  float4      W;                                                                // Load [N].
+  float       m_f;                                                              // Fictitious mass [kg].
+  float       KE = 0.0f;                                                        // Kinetic energy [J].
+  float       R2 = 0.0f;                                                        // Squared residual force [N^2].
+  float       W2 = 0.0f;                                                        // Squared load [N^2].
+
+  if(dr_scalars[DR_DONE] > 0.0f)
+  {
+    return;                                                                     // Static equilibrium reached: nothing to do...
+  }
+
+  for(i = gid; i < nodes; i += stride)
+  {
+    P   = position[i];                                                          // Getting position [m]...
+    V   = velocity[i];                                                          // Getting velocity [m/s]...
+    m   = mass[PARAM(i)];                                                       // Getting mass [kg]...
+    g   = gravity[PARAM(i)];                                                    // Getting gravity [m/s^2]...
+    fr  = freedom[i];                                                           // Getting freedom flag [#]...
+    neighbours = neighbour[i];                                                  // Getting neighbour indexes (single load) [#]...
+    n_R = neighbours.x;                                                         // Getting right neighbour index [#]...
+    n_U = neighbours.y;                                                         // Getting up neighbour index [#]...
+    n_L = neighbours.z;                                                         // Getting left neighbour index [#]...
+    n_D = neighbours.w;                                                         // Getting down neighbour index [#]...
+    k_R = stiffness[PARAM(n_R)];                                                // Getting right neighbour stiffness...
+    k_U = stiffness[PARAM(n_U)];                                                // Getting up neighbour stiffness...
+    k_L = stiffness[PARAM(n_L)];                                                // Getting left neighbour stiffness...
+    k_D = stiffness[PARAM(n_D)];                                                // Getting down neighbour stiffness...
+
+    // COMPUTING LINK DISPLACEMENTS:
+    link_displacements(
+                        position[n_R],                                          // Right neighbour position [m].
+                        position[n_U],                                          // Up neighbour position [m].
+                        position[n_L],                                          // Left neighbour position [m].
+                        position[n_D],                                          // Down neighbour position [m].
+                        P,                                                      // Position [m].
+                        resting[PARAM(n_R)],                                    // Right neighbour resting position [m].
+                        resting[PARAM(n_U)],                                    // Up neighbour resting position [m].
+                        resting[PARAM(n_L)],                                    // Left neighbour resting position [m].
+                        resting[PARAM(n_D)],                                    // Down neighbour resting position [m].
+                        fr,                                                     // Freedom flag [#].
+                        &D_R,                                                   // Right neighbour displacement [m].
+                        &D_U,                                                   // Up neighbour displacement [m].
+                        &D_L,                                                   // Left neighbour displacement [m].
+                        &D_D                                                    // Down neighbour displacement [m].
+                      );
+
+    // COMPUTING RESIDUAL FORCE (static: no viscous force):
+    R = node_force  (
+                      k_R,                                                      // Right neighbour stiffness.
+                      k_U,                                                      // Up neighbour stiffness.
+                      k_L,                                                      // Left neighbour stiffness.
+                      k_D,                                                      // Down neighbour stiffness.
+                      D_R,                                                      // Right neighbour displacement [m].
+                      D_U,                                                      // Up neighbour displacement [m].
+                      D_L,                                                      // Left neighbour displacement [m].
+                      D_D,                                                      // Down neighbour displacement [m].
+                      (float4)(0.0f, 0.0f, 0.0f, 0.0f),                         // Friction coefficient.
+                      (float4)(0.0f, 0.0f, 0.0f, 0.0f),                         // Velocity [m/s].
+                      m,                                                        // Mass [kg].
+                      g,                                                        // Gravity [m/s^2].
+                      fr                                                        // Freedom flag [#].
+                    );
+
+    W = fr*m*g;                                                                 // Computing load [N]...
+    R.w = 0.0f;                                                                 // Discarding projective component...
+    W.w = 0.0f;                                                                 // Discarding projective component...
+    m_f = scale*dt*dt*(k_R.x + k_U.y + k_L.x + k_D.y);                          // Computing fictitious mass [kg]...
+    V = fr*(V + dt*R/m_f);                                                      // Computing trial velocity [m/s]...
+    V.w = 0.0f;                                                                 // Discarding projective component...
+    KE += 0.5f*m_f*dot(V, V);                                                   // Accumulating kinetic energy [J]...
+    R2 += dot(R, R);                                                            // Accumulating squared residual force [N^2]...
+    W2 += dot(W, W);                                                            // Accumulating squared load [N^2]...
+
+    fix_projective_space(&V);                                                   // Fixing velocity [m/s]...
+    velocity_int[i] = V;                                                        // Setting trial velocity [m/s]...
+  }
+
+  dr_partial[gid] = (float4)(KE, R2, W2, 0.0f);                                 // Setting partial sums...
+}
@@ -0,0 +1,65 @@
+/// @file
+
+// Dynamic relaxation, 3rd kernel: position update with the trial velocities, or velocity reset
+// at a kinetic energy peak (see relaxation_check.cl).
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        PARAMETER float*    dt_simulation,                      // Simulation time step [s].
+                        __global float4*    dr_partial,                         // Partial sums (kinetic energy, residual^2, load^2).
+                        __global float*     dr_scalars)                         // Dynamic relaxation scalars (see "DR_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////// SYNERGIC MOLECULE: KINEMATIC VARIABLES /////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      P   = position[gid];                                              // Position [m].
+  float4      V   = velocity_int[gid];                                          // Trial velocity [m/s].
+  float4      col = depth[gid];                                                 // Current node color.
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////// DYNAMIC RELAXATION ///////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float       dt = dt_simulation[0];                                            // Fictitious time step [s].
+
+  if(dr_scalars[DR_DONE] > 0.0f)
+  {
+    return;                                                                     // Static equilibrium reached: nothing to do...
+  }
+
+  if(dr_scalars[DR_RESET] > 0.0f)
+  {
+    V = (float4)(0.0f, 0.0f, 0.0f, 0.0f);                                       // Kinetic energy peak: zeroing velocity [m/s]...
+  }
+  else
+  {
+    P += dt*V;                                                                  // Updating position [m]...
+  }
+
+  // FIXING PROJECTIVE SPACE:
+  fix_projective_space(&P);                                                     // Fixing position [m]...
+  fix_projective_space(&V);                                                     // Fixing velocity [m/s]...
+
+  // ASSIGNING DEPTH COLOR:
+  assign_color(&col, &P);                                                       // Assigning depth color [#]...
+
+  // UPDATING KINEMATICS:
+  position[gid] = P;                                                            // Updating position [m]...
+  depth[gid] = col;                                                             // Updating depth color [#]...
+  velocity[gid] = V;                                                            // Updating velocity [m/s]...
+}
@@ -0,0 +1,85 @@
+/// @file
+
+// Active set, 1st kernel: each work-item flags the awake nodes of a contiguous chunk of nodes and
+// counts them. A node is awake when it, or any of its neighbours, is moving: a free node with speed
+// or acceleration above the "SLEEP_*" thresholds. Sleeping nodes are woken up by a moving neighbour.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global long*      active,                             // Active (awake) node indexes [#].
+                        __global long*      active_count,                       // # of active nodes [#].
+                        __global long*      awake,                              // Awake flag [#].
+                        __global long*      sleep_count,                        // Awake nodes per work-item, then offsets [#].
+                        __global float*     sleep_limits)                       // Sleeping thresholds (see "SLEEP_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+  unsigned long groups = (unsigned long)sleep_limits[SLEEP_GROUPS];             // Setting # of work-items [#]...
+  unsigned long nodes = (unsigned long)sleep_limits[SLEEP_NODES];               // Setting # of nodes [#]...
+  unsigned long chunk = (nodes + groups - 1)/groups;                            // Setting # of nodes per work-item [#]...
+  unsigned long i_min = min(gid*chunk, nodes);                                  // Setting chunk minimum index [#]...
+  unsigned long i_max = min(i_min + chunk, nodes);                              // Setting chunk maximum index [#]...
+  unsigned long i;                                                              // Node index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// AWAKE FLAGS //////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float       v_sleep = sleep_limits[SLEEP_SPEED];                              // Speed threshold [m/s].
+  float       a_sleep = sleep_limits[SLEEP_ACCEL];                              // Acceleration threshold [m/s^2].
+  float4      V;                                                                // Velocity [m/s].
+  float4      A;                                                                // Acceleration [m/s^2].
+  int4        neighbours;                                                       // Neighbour indexes (R, U, L, D) [#].
+  long        n[5];                                                             // Node and neighbour indexes [#].
+  long        flag;                                                             // Awake flag [#].
+  long        count = 0;                                                        // # of awake nodes [#].
+  int         k;                                                                // Neighbour index [#].
+
+  for(i = i_min; i < i_max; i++)
+  {
+    n[0] = i;                                                                   // Setting node index [#]...
+    neighbours = neighbour[i];                                                  // Getting neighbour indexes (single load) [#]...
+    n[1] = neighbours.x;                                                        // Getting right neighbour index [#]...
+    n[2] = neighbours.y;                                                        // Getting up neighbour index [#]...
+    n[3] = neighbours.z;                                                        // Getting left neighbour index [#]...
+    n[4] = neighbours.w;                                                        // Getting down neighbour index [#]...
+    flag = 0;                                                                   // Resetting awake flag...
+
+    if(freedom[i].x == 0.0f)
+    {
+      awake[i] = 0;                                                             // Constrained node: always sleeping...
+      continue;
+    }
+
+    for(k = 0; k < 5; k++)
+    {
+      V = velocity[n[k]];                                                       // Getting velocity [m/s]...
+      A = acceleration[n[k]];                                                   // Getting acceleration [m/s^2]...
+      V.w = 0.0f;                                                               // Discarding projective component...
+      A.w = 0.0f;                                                               // Discarding projective component...
+
+      if((freedom[n[k]].x != 0.0f) && ((length(V) > v_sleep) || (length(A) > a_sleep)))
+      {
+        flag = 1;                                                               // Moving node (or neighbour): awake...
+      }
+    }
+
+    awake[i] = flag;                                                            // Setting awake flag...
+    count += flag;                                                              // Counting awake nodes...
+  }
+
+  sleep_count[gid] = count;                                                     // Setting # of awake nodes of the chunk...
+}
@@ -0,0 +1,42 @@
+/// @file
+
+// Active set, 2nd kernel (single work-item): exclusive prefix sum of the awake node counts of all
+// chunks, i.e. the offset of each chunk in the active node list, and total # of active nodes.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global long*      active,                             // Active (awake) node indexes [#].
+                        __global long*      active_count,                       // # of active nodes [#].
+                        __global long*      awake,                              // Awake flag [#].
+                        __global long*      sleep_count,                        // Awake nodes per work-item, then offsets [#].
+                        __global float*     sleep_limits)                       // Sleeping thresholds (see "SLEEP_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////// OFFSETS ////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long groups = (unsigned long)sleep_limits[SLEEP_GROUPS];             // Setting # of work-items [#]...
+  unsigned long n;                                                              // Chunk index [#].
+  long        count;                                                            // # of awake nodes of the chunk [#].
+  long        offset = 0;                                                       // Chunk offset [#].
+
+  for(n = 0; n < groups; n++)
+  {
+    count = sleep_count[n];                                                     // Getting # of awake nodes of the chunk...
+    sleep_count[n] = offset;                                                    // Setting chunk offset...
+    offset += count;                                                            // Accumulating # of awake nodes...
+  }
+
+  active_count[0] = offset;                                                     // Setting # of active nodes...
+}
@@ -0,0 +1,48 @@
+/// @file
+
+// Active set, 3rd kernel: each work-item writes the indexes of the awake nodes of its chunk at the
+// chunk offset, hence the active node list keeps the node order (and the memory locality).
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        __global float4*    gravity,                            // Gravity [m/s^2].
+                        __global float4*    stiffness,                          // Stiffness
+                        __global float4*    resting,                            // Resting distance [m].
+                        __global float4*    friction,                           // Friction
+                        __global float4*    mass,                               // Mass [kg].
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        __global float*     dt_simulation,                      // Simulation time step [s].
+                        __global long*      active,                             // Active (awake) node indexes [#].
+                        __global long*      active_count,                       // # of active nodes [#].
+                        __global long*      awake,                              // Awake flag [#].
+                        __global long*      sleep_count,                        // Awake nodes per work-item, then offsets [#].
+                        __global float*     sleep_limits)                       // Sleeping thresholds (see "SLEEP_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+  unsigned long groups = (unsigned long)sleep_limits[SLEEP_GROUPS];             // Setting # of work-items [#]...
+  unsigned long nodes = (unsigned long)sleep_limits[SLEEP_NODES];               // Setting # of nodes [#]...
+  unsigned long chunk = (nodes + groups - 1)/groups;                            // Setting # of nodes per work-item [#]...
+  unsigned long i_min = min(gid*chunk, nodes);                                  // Setting chunk minimum index [#]...
+  unsigned long i_max = min(i_min + chunk, nodes);                              // Setting chunk maximum index [#]...
+  unsigned long i;                                                              // Node index [#].
+  long        k = sleep_count[gid];                                             // Active node list index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// COMPACTION ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  for(i = i_min; i < i_max; i++)
+  {
+    if(awake[i])
+    {
+      active[k++] = i;                                                          // Appending awake node to the active node list...
+    }
+  }
+}
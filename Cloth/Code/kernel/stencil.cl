@@ -0,0 +1,6 @@
+/// @file
+
+// Prepended to thekernel1.cl/thekernel2.cl (or velocity_verlet1.cl/velocity_verlet2.cl) when
+// STENCIL is enabled: the kernels then run on a 2D NDRange spanning the structured grid and derive
+// the neighbour indexes from the grid index, without any neighbour index buffer.
+#define STENCIL
@@ -1,5 +1,8 @@
 /// @file
 
+#ifdef TILED
+__attribute__((work_group_size_hint(TILE_X, TILE_Y, 1)))
+#endif
 __kernel void thekernel(__global float4*    position,                           // Position [m].
                         __global float4*    depth,                              // Depth color [#]
                         __global float4*    position_int,                       // Position (intermediate) [m].
@@ -7,28 +10,43 @@ __kernel void thekernel(__global float4*    position,
                         __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
                         __global float4*    acceleration,                       // Acceleration [m/s^2].
                         __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
-                        __global float4*    gravity,                            // Gravity [m/s^2].
-                        __global float4*    stiffness,                          // Stiffness
-                        __global float4*    resting,                            // Resting distance [m].
-                        __global float4*    friction,                           // Friction
-                        __global float4*    mass,                               // Mass [kg].
-                        __global long*      neighbour_R,                        // Right neighbour [#].
-                        __global long*      neighbour_U,                        // Up neighbour [#].
-                        __global long*      neighbour_L,                        // Left neighbour [#].
-                        __global long*      neighbour_D,                        // Down neighbour [#].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+#ifndef STENCIL
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+#endif
                         __global float4*    freedom,                            // Freedom flag [#].
-                        __global float*     dt_simulation)                      // Simulation time step [s].
+#ifdef ACTIVE_SET
+                        PARAMETER float*    dt_simulation,                      // Simulation time step [s].
+                        __global long*      active,                             // Active (awake) node indexes [#].
+                        __global long*      active_count)                       // # of active nodes [#].
+#else
+                        PARAMETER float*    dt_simulation)                      // Simulation time step [s].
+#endif
 {
 
   ////////////////////////////////////////////////////////////////////////////////
   ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////
+#if defined(ACTIVE_SET)
+  // NOTE: grid-stride loop, the active set can outgrow the launch size while nodes wake up.
+  long        count = active_count[0];                                          // # of active nodes [#].
+  for(long a = get_global_id(0); a < count; a += get_global_size(0))
+  {
+  unsigned long gid = active[a];                                                // Setting global index "gid" (active node)...
+#elif defined(STENCIL)
+  unsigned long gid = get_global_id(0) + get_global_size(0)*get_global_id(1);   // Setting global index "gid" (grid node)...
+#else
   unsigned long gid = get_global_id(0);                                         // Global index [#].
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////
   /////////////////// SYNERGIC MOLECULE: KINEMATIC VARIABLES /////////////////////
   ////////////////////////////////////////////////////////////////////////////////
-  float4      P = position[gid];                                                // Getting point coordinates [m]...
+  float4      P = POSITION_N[gid];                                              // Getting point coordinates [m]...
   float4      D = depth[gid];                                                   // Getting color coordinates [#]...
   float4      V = velocity[gid];                                                // Getting velocity [m/s]...
   float4      A = acceleration[gid];                                            // Getting acceleration [m/s^2]...
@@ -36,49 +54,78 @@ __kernel void thekernel(__global float4*    position,
   ////////////////////////////////////////////////////////////////////////////////
   /////////////////// SYNERGIC MOLECULE: DYNAMIC VARIABLES ///////////////////////
   ////////////////////////////////////////////////////////////////////////////////
-  float4      m   = mass[gid];                                                  // Current node mass.
-  float4      g   = gravity[gid];                                               // Current node gravity field.
-  float4      C   = friction[gid];                                              // Current node friction.
+  float4      m   = mass[PARAM(gid)];                                           // Current node mass.
+  float4      g   = gravity[PARAM(gid)];                                        // Current node gravity field.
+  float4      C   = friction[PARAM(gid)];                                       // Current node friction.
   float4      fr  = freedom[gid];                                               // Current freedom flag.
 
   ////////////////////////////////////////////////////////////////////////////////
   ////////////////////// SYNERGIC MOLECULE: LINK INDEXES /////////////////////////
   ////////////////////////////////////////////////////////////////////////////////
   // NOTE: 1. the index of a non-existing node neighbour must be set to the index of the node.
-  long        index_R = neighbour_R[gid];                                       // Setting right neighbour index [#]...
-  long        index_U = neighbour_U[gid];                                       // Setting up neighbour index [#]...
-  long        index_L = neighbour_L[gid];                                       // Setting left neighbour index [#]...
-  long        index_D = neighbour_D[gid];                                       // Setting down neighbour index [#]...
+#ifdef STENCIL
+  int4        neighbours = grid_neighbours(get_global_id(0), get_global_id(1)); // Computing neighbour indexes from the grid index [#]...
+#else
+  int4        neighbours = neighbour[gid];                                      // Getting neighbour indexes (single load) [#]...
+#endif
+  long        index_R = neighbours.x;                                           // Setting right neighbour index [#]...
+  long        index_U = neighbours.y;                                           // Setting up neighbour index [#]...
+  long        index_L = neighbours.z;                                           // Setting left neighbour index [#]...
+  long        index_D = neighbours.w;                                           // Setting down neighbour index [#]...
 
   ////////////////////////////////////////////////////////////////////////////////
   ///////////////// SYNERGIC MOLECULE: LINKED PARTICLE POSITIONS /////////////////
   ////////////////////////////////////////////////////////////////////////////////
-  float4      position_R = position[index_R];                                   // Setting right neighbour position coordinates [m]...
-  float4      position_U = position[index_U];                                   // Setting up neighbour position coordinates [m]...
-  float4      position_L = position[index_L];                                   // Setting left neighbour position coordinates [m]...
-  float4      position_D = position[index_D];                                   // Setting down neighbour position coordinates [m]...
+#ifdef TILED
+  __local float4 tile[TILE_SIZE];                                               // Positions of the work-group tile, halo included [m].
+  float4      position_R;                                                       // Right neighbour position [m].
+  float4      position_U;                                                       // Up neighbour position [m].
+  float4      position_L;                                                       // Left neighbour position [m].
+  float4      position_D;                                                       // Down neighbour position [m].
+
+  if(tile_fits())
+  {
+    tile_load(POSITION_N, tile);                                                // Staging positions in local memory...
+    position_R = tile[tile_index(1, 0)];                                        // Setting right neighbour position coordinates [m]...
+    position_U = tile[tile_index(0, 1)];                                        // Setting up neighbour position coordinates [m]...
+    position_L = tile[tile_index(-1, 0)];                                       // Setting left neighbour position coordinates [m]...
+    position_D = tile[tile_index(0, -1)];                                       // Setting down neighbour position coordinates [m]...
+  }
+  else
+  {
+    position_R = POSITION_N[index_R];                                           // Setting right neighbour position coordinates [m]...
+    position_U = POSITION_N[index_U];                                           // Setting up neighbour position coordinates [m]...
+    position_L = POSITION_N[index_L];                                           // Setting left neighbour position coordinates [m]...
+    position_D = POSITION_N[index_D];                                           // Setting down neighbour position coordinates [m]...
+  }
+#else
+  float4      position_R = POSITION_N[index_R];                                 // Setting right neighbour position coordinates [m]...
+  float4      position_U = POSITION_N[index_U];                                 // Setting up neighbour position coordinates [m]...
+  float4      position_L = POSITION_N[index_L];                                 // Setting left neighbour position coordinates [m]...
+  float4      position_D = POSITION_N[index_D];                                 // Setting down neighbour position coordinates [m]...
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////
   //////////////// SYNERGIC MOLECULE: LINK RESTING DISTANCES /////////////////////
   ////////////////////////////////////////////////////////////////////////////////
-  float4      resting_R = resting[index_R];                                     // Setting right neighbour resting position [m]...
-  float4      resting_U = resting[index_U];                                     // Setting up neighbour resting position [m]...
-  float4      resting_L = resting[index_L];                                     // Setting left neighbour resting position [m]...
-  float4      resting_D = resting[index_D];                                     // Setting down neighbour resting position [m]...
+  float4      resting_R = resting[PARAM(index_R)];                              // Setting right neighbour resting position [m]...
+  float4      resting_U = resting[PARAM(index_U)];                              // Setting up neighbour resting position [m]...
+  float4      resting_L = resting[PARAM(index_L)];                              // Setting left neighbour resting position [m]...
+  float4      resting_D = resting[PARAM(index_D)];                              // Setting down neighbour resting position [m]...
 
   ////////////////////////////////////////////////////////////////////////////////
   ////////////////////// SYNERGIC MOLECULE: LINK STIFFNESS ///////////////////////
   ////////////////////////////////////////////////////////////////////////////////
   // NOTE: the stiffness of a non-existing link must reset to 0.
-  float4      stiffness_R = stiffness[index_R];                                 // Setting right neighbour stiffness...
-  float4      stiffness_U = stiffness[index_U];                                 // Setting up neighbour stiffness...
-  float4      stiffness_L = stiffness[index_L];                                 // Setting left neighbour stiffness...
-  float4      stiffness_D = stiffness[index_D];                                 // Setting down neighbour stiffness...
+  float4      stiffness_R = stiffness[PARAM(index_R)];                          // Setting right neighbour stiffness...
+  float4      stiffness_U = stiffness[PARAM(index_U)];                          // Setting up neighbour stiffness...
+  float4      stiffness_L = stiffness[PARAM(index_L)];                          // Setting left neighbour stiffness...
+  float4      stiffness_D = stiffness[PARAM(index_D)];                          // Setting down neighbour stiffness...
 
   ////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////// VERLET INTEGRATION /////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////
-  float       dt = dt_simulation[gid];                                          // Setting simulation time step [s]...
+  float       dt = dt_simulation[PARAM(gid)];                                   // Setting simulation time step [s]...
 
   float4      displacement_R;                                                   // Right neighbour displacement [m]...
   float4      displacement_U;                                                   // Up neighbour displacement [m]...
@@ -128,8 +175,14 @@ __kernel void thekernel(__global float4*    position,
   // UPDATING POSITION:
   P += V*dt + A*dt*dt/2.0f;                                                     // Updating position [m]...
 
-  // UPDATING INTERMEDIATE KINEMATICS:
-  position_int[gid] = P;                                                        // Updating position (intermediate) [m]...
-  velocity_int[gid] = V;                                                        // Updating position (intermediate) [m/s]...
-  acceleration_int[gid] = A;                                                    // Updating position (intermediate) [m/s^2]...
+  // FIXING PROJECTIVE SPACE:
+  fix_projective_space(&P);                                                     // Fixing position [m]...
+  fix_projective_space(&A);                                                     // Fixing acceleration [m/s^2]...
+
+  // UPDATING KINEMATICS (velocity @ t_n is read again by the 2nd kernel, no copy needed):
+  POSITION_NEW[gid] = P;                                                        // Updating position (intermediate) [m]...
+  acceleration[gid] = A;                                                        // Updating acceleration (own node only: in place) [m/s^2]...
+#if defined(ACTIVE_SET)
+  }                                                                             // Next active node of this work-item...
+#endif
 }
@@ -1,5 +1,8 @@
 /// @file
 
+#ifdef TILED
+__attribute__((work_group_size_hint(TILE_X, TILE_Y, 1)))
+#endif
 __kernel void thekernel(__global float4*    position,                           // Position [m].
                         __global float4*    depth,                              // Depth color [#]
                         __global float4*    position_int,                       // Position (intermediate) [m].
@@ -7,36 +10,51 @@ __kernel void thekernel(__global float4*    position,
                         __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
                         __global float4*    acceleration,                       // Acceleration [m/s^2].
                         __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
-                        __global float4*    gravity,                            // Gravity [m/s^2].
-                        __global float4*    stiffness,                          // Stiffness
-                        __global float4*    resting,                            // Resting distance [m].
-                        __global float4*    friction,                           // Friction
-                        __global float4*    mass,                               // Mass [kg].
-                        __global long*      neighbour_R,                        // Right neighbour [#].
-                        __global long*      neighbour_U,                        // Up neighbour [#].
-                        __global long*      neighbour_L,                        // Left neighbour [#].
-                        __global long*      neighbour_D,                        // Down neighbour [#].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+#ifndef STENCIL
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+#endif
                         __global float4*    freedom,                            // Freedom flag [#].
-                        __global float*     dt_simulation)                      // Simulation time step [s].
+#ifdef ACTIVE_SET
+                        PARAMETER float*    dt_simulation,                      // Simulation time step [s].
+                        __global long*      active,                             // Active (awake) node indexes [#].
+                        __global long*      active_count)                       // # of active nodes [#].
+#else
+                        PARAMETER float*    dt_simulation)                      // Simulation time step [s].
+#endif
 {
   ////////////////////////////////////////////////////////////////////////////////
   ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////
+#if defined(ACTIVE_SET)
+  // NOTE: grid-stride loop, the active set can outgrow the launch size while nodes wake up.
+  long        count = active_count[0];                                          // # of active nodes [#].
+  for(long a = get_global_id(0); a < count; a += get_global_size(0))
+  {
+  unsigned long gid = active[a];                                                // Setting global index "gid" (active node)...
+#elif defined(STENCIL)
+  unsigned long gid = get_global_id(0) + get_global_size(0)*get_global_id(1);   // Setting global index "gid" (grid node)...
+#else
   unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////
   /////////////////// SYNERGIC MOLECULE: KINEMATIC VARIABLES /////////////////////
   ////////////////////////////////////////////////////////////////////////////////
-  float4      P   = position_int[gid];                                          // Position (intermediate) [m].
-  float4      V   = velocity_int[gid];                                          // Velocity (intermediate) [m/s].
-  float4      A   = acceleration_int[gid];                                      // Acceleration (intermediate) [m/s^2].
+  float4      P   = POSITION_NEW[gid];                                          // Position (intermediate) [m].
+  float4      V   = velocity[gid];                                              // Velocity @ t_n [m/s].
+  float4      A   = acceleration[gid];                                          // Acceleration (1st kernel) [m/s^2].
 
   ////////////////////////////////////////////////////////////////////////////////
   /////////////////// SYNERGIC MOLECULE: DYNAMIC VARIABLES ///////////////////////
   ////////////////////////////////////////////////////////////////////////////////
-  float4      m   = mass[gid];                                                  // Mass [kg].
-  float4      g   = gravity[gid];                                               // Gravity [m/s^2]
-  float4      C   = friction[gid];                                              // Friction coefficient.
+  float4      m   = mass[PARAM(gid)];                                           // Mass [kg].
+  float4      g   = gravity[PARAM(gid)];                                        // Gravity [m/s^2]
+  float4      C   = friction[PARAM(gid)];                                       // Friction coefficient.
   float4      fr  = freedom[gid];                                               // Freedom flag [#].
   float4      col = depth[gid];                                                 // Current node color.
 
@@ -44,42 +62,71 @@ __kernel void thekernel(__global float4*    position,
   ////////////////////// SYNERGIC MOLECULE: LINK INDEXES /////////////////////////
   ////////////////////////////////////////////////////////////////////////////////
   // NOTE: 1. the index of a non-existing particle friend must be set to the index of the particle.
-  long        n_R = neighbour_R[gid];                                           // Setting right neighbour index [#]...
-  long        n_U = neighbour_U[gid];                                           // Setting up neighbour index [#]...
-  long        n_L = neighbour_L[gid];                                           // Setting left neighbour index [#]...
-  long        n_D = neighbour_D[gid];                                           // Setting down neighbour index [#]...
+#ifdef STENCIL
+  int4        neighbours = grid_neighbours(get_global_id(0), get_global_id(1)); // Computing neighbour indexes from the grid index [#]...
+#else
+  int4        neighbours = neighbour[gid];                                      // Getting neighbour indexes (single load) [#]...
+#endif
+  long        n_R = neighbours.x;                                               // Setting right neighbour index [#]...
+  long        n_U = neighbours.y;                                               // Setting up neighbour index [#]...
+  long        n_L = neighbours.z;                                               // Setting left neighbour index [#]...
+  long        n_D = neighbours.w;                                               // Setting down neighbour index [#]...
 
   ////////////////////////////////////////////////////////////////////////////////
   ///////////////// SYNERGIC MOLECULE: LINKED PARTICLE POSITIONS /////////////////  t_(n+1)
   ////////////////////////////////////////////////////////////////////////////////
-  float4      P_R = position_int[n_R];                                          // Right neighbour position [m].
-  float4      P_U = position_int[n_U];                                          // Up neighbour position [m].
-  float4      P_L = position_int[n_L];                                          // Left neighbour position [m].
-  float4      P_D = position_int[n_D];                                          // Down neighbour position [m].
+#ifdef TILED
+  __local float4 tile[TILE_SIZE];                                               // Positions of the work-group tile, halo included [m].
+  float4      P_R;                                                              // Right neighbour position [m].
+  float4      P_U;                                                              // Up neighbour position [m].
+  float4      P_L;                                                              // Left neighbour position [m].
+  float4      P_D;                                                              // Down neighbour position [m].
+
+  if(tile_fits())
+  {
+    tile_load(POSITION_NEW, tile);                                              // Staging positions in local memory...
+    P_R = tile[tile_index(1, 0)];                                               // Right neighbour position [m].
+    P_U = tile[tile_index(0, 1)];                                               // Up neighbour position [m].
+    P_L = tile[tile_index(-1, 0)];                                              // Left neighbour position [m].
+    P_D = tile[tile_index(0, -1)];                                              // Down neighbour position [m].
+  }
+  else
+  {
+    P_R = POSITION_NEW[n_R];                                                    // Right neighbour position [m].
+    P_U = POSITION_NEW[n_U];                                                    // Up neighbour position [m].
+    P_L = POSITION_NEW[n_L];                                                    // Left neighbour position [m].
+    P_D = POSITION_NEW[n_D];                                                    // Down neighbour position [m].
+  }
+#else
+  float4      P_R = POSITION_NEW[n_R];                                          // Right neighbour position [m].
+  float4      P_U = POSITION_NEW[n_U];                                          // Up neighbour position [m].
+  float4      P_L = POSITION_NEW[n_L];                                          // Left neighbour position [m].
+  float4      P_D = POSITION_NEW[n_D];                                          // Down neighbour position [m].
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////
   //////////////// SYNERGIC MOLECULE: LINK RESTING DISTANCES /////////////////////
   ////////////////////////////////////////////////////////////////////////////////
-  float4      resting_R = resting[n_R];                                         // Setting right neighbour resting position [m]...
-  float4      resting_U = resting[n_U];                                         // Setting up neighbour resting position [m]...
-  float4      resting_L = resting[n_L];                                         // Setting left neighbour resting position [m]...
-  float4      resting_D = resting[n_D];                                         // Setting down neighbour resting position [m]...
+  float4      resting_R = resting[PARAM(n_R)];                                  // Setting right neighbour resting position [m]...
+  float4      resting_U = resting[PARAM(n_U)];                                  // Setting up neighbour resting position [m]...
+  float4      resting_L = resting[PARAM(n_L)];                                  // Setting left neighbour resting position [m]...
+  float4      resting_D = resting[PARAM(n_D)];                                  // Setting down neighbour resting position [m]...
 
   ////////////////////////////////////////////////////////////////////////////////
   ////////////////////// SYNERGIC MOLECULE: LINK STIFFNESS ///////////////////////
   ////////////////////////////////////////////////////////////////////////////////
   // NOTE: the stiffness of a non-existing link must reset to 0.
-  float4      k_R = stiffness[n_R];                                             // Setting right neighbour stiffness...
-  float4      k_U = stiffness[n_U];                                             // Setting up neighbour stiffness...
-  float4      k_L = stiffness[n_L];                                             // Setting left neighbour stiffness...
-  float4      k_D = stiffness[n_D];                                             // Setting down neighbour stiffness...
+  float4      k_R = stiffness[PARAM(n_R)];                                      // Setting right neighbour stiffness...
+  float4      k_U = stiffness[PARAM(n_U)];                                      // Setting up neighbour stiffness...
+  float4      k_L = stiffness[PARAM(n_L)];                                      // Setting left neighbour stiffness...
+  float4      k_D = stiffness[PARAM(n_D)];                                      // Setting down neighbour stiffness...
 
   //////////////////////////////////////////////////////////////////////////////
   /////////////////////////////// VERLET INTEGRATION ///////////////////////////
   //////////////////////////////////////////////////////////////////////////////
 
   // TIME STEP:
-  float dt = dt_simulation[gid];                                                // Setting simulation time step [s]...
+  float dt = dt_simulation[PARAM(gid)];                                         // Setting simulation time step [s]...
 
   // NEIGHBOURS DISPLACEMENTS:
   float4      D_R;                                                              // Right neighbour displacement [m]...
@@ -166,14 +213,17 @@ __kernel void thekernel(__global float4*    position,
   // FIXING PROJECTIVE SPACE:
   fix_projective_space(&P);                                                     // Fixing position [m]...
   fix_projective_space(&V);                                                     // Fixing velocity [m/s]...
-  fix_projective_space(&A);                                                     // Fixing acceleration [m/s^2]...
 
   // ASSIGNING DEPTH COLOR:
   assign_color(&col, &P);                                                       // Assigning depth color [à]...
 
-  // UPDATING KINEMATICS:
+  // UPDATING KINEMATICS (acceleration already updated in place by the 1st kernel):
+#ifndef PING_PONG
   position[gid] = P;                                                            // Updating position [m]...
+#endif
   velocity[gid] = V;                                                            // Updating velocity [m/s]...
-  acceleration[gid] = A;                                                        // UPdating acceleration [m/s^2]...
   depth[gid] = col;                                                             // Updating color [#]...
+#if defined(ACTIVE_SET)
+  }                                                                             // Next active node of this work-item...
+#endif
 }
@@ -0,0 +1,8 @@
+/// @file
+
+// Local memory tile size (TILED), shared by the host and the kernels: main.cpp includes this file and
+// the kernels are compiled with it prepended to tiled.cl. The tile must divide the grid ("nodes_x" and
+// "nodes_y" in main.cpp, 100 x 100) to be usable as the work-group size: otherwise the host reports it
+// at startup, as the runtime then chooses another work-group size.
+#define TILE_X                    10                                            // Tile "x" size, max work-group "x" size [#].
+#define TILE_Y                    10                                            // Tile "y" size, max work-group "y" size [#].
@@ -0,0 +1,52 @@
+/// @file
+
+// Prepended (after stencil.cl and tile_size.cl) to the kernels gathering neighbour positions when
+// TILED is enabled: each 2D work-group stages the positions of its tile plus a one-node halo in local
+// memory, so that every position is fetched once per work-group instead of up to five times.
+#define TILED
+#define TILE_SIZE                 ((TILE_X + 2)*(TILE_Y + 2))                   // Tile size, halo included [#].
+
+// Local index of the tile node at offset (di, dj) from the current node.
+int tile_index (
+                 int di,                                                        // "x" offset [#].
+                 int dj                                                         // "y" offset [#].
+               )
+{
+  return (get_local_id(0) + 1 + di) + (get_local_size(0) + 2)*(get_local_id(1) + 1 + dj);
+}
+
+// The work-group size is chosen by the OpenCL runtime ("TILE_X" and "TILE_Y" are a hint):
+// "false" when it exceeds the local tile, then the kernel gathers from global memory.
+bool tile_fits ()
+{
+  return (get_local_size(0) <= TILE_X) && (get_local_size(1) <= TILE_Y);
+}
+
+// Loads the tile of "field" spanned by the work-group, plus a one-node halo, in local memory.
+// Halo nodes beyond the grid border are clamped to the border node, i.e. a non-existing neighbour
+// is the node itself, as in "grid_neighbours".
+void tile_load (
+                 __global float4* field,                                        // Node field.
+                 __local  float4* tile                                          // Local tile.
+               )
+{
+  int         nodes_x = get_global_size(0);                                     // # of nodes in "x" direction [#].
+  int         nodes_y = get_global_size(1);                                     // # of nodes in "y" direction [#].
+  int         size_x  = get_local_size(0) + 2;                                  // Tile "x" size, halo included [#].
+  int         size_y  = get_local_size(1) + 2;                                  // Tile "y" size, halo included [#].
+  int         i_0     = get_group_id(0)*get_local_size(0) - 1;                  // Tile "x" origin [#].
+  int         j_0     = get_group_id(1)*get_local_size(1) - 1;                  // Tile "y" origin [#].
+  int         stride  = get_local_size(0)*get_local_size(1);                    // # of work-items in the work-group [#].
+  int         k;                                                                // Tile node index [#].
+  int         i;                                                                // Grid "x" index [#].
+  int         j;                                                                // Grid "y" index [#].
+
+  for(k = get_local_id(0) + get_local_size(0)*get_local_id(1); k < size_x*size_y; k += stride)
+  {
+    i = clamp(i_0 + k%size_x, 0, nodes_x - 1);                                  // Clamping "x" index to the grid...
+    j = clamp(j_0 + k/size_x, 0, nodes_y - 1);                                  // Clamping "y" index to the grid...
+    tile[k] = field[i + nodes_x*j];                                             // Staging node value...
+  }
+
+  barrier(CLK_LOCAL_MEM_FENCE);                                                 // Waiting for the whole tile...
+}
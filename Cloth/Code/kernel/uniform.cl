@@ -0,0 +1,6 @@
+/// @file
+
+// Prepended (before utilities.cl) to the kernels reading the node parameters when UNIFORM is
+// enabled: gravity, stiffness, resting distance, friction, mass and time step are then a single value
+// in constant memory, shared by all nodes, instead of one array element per node.
+#define UNIFORM
@@ -10,6 +10,85 @@
 #define BMAX                      1.0f                                          // Maximum blue channel for colormap
 #define SCALE                     1.5f                                          // Scale factor for plot
 
+// Node parameters (gravity, stiffness, resting distance, friction, mass, time step):
+#ifdef UNIFORM
+  #define PARAMETER               __constant                                    // Single value for all nodes (see uniform.cl).
+  #define PARAM(n)                0                                             // Parameter index of node "n" [#].
+#else
+  #define PARAMETER               __global                                      // One value per node.
+  #define PARAM(n)                (n)                                           // Parameter index of node "n" [#].
+#endif
+
+// Node state (velocity, acceleration, intermediate position), "w" is the projective component:
+#ifdef PACKED
+  #define STATE                   float                                         // Packed "x, y, z" triplets (see packed.cl).
+  #define load_state(a, i, w)     (float4)(vload3((i), (a)), (w))               // Loading node "i" state.
+  #define store_state(a, i, v)    vstore3((v).xyz, (i), (a))                    // Storing node "i" state ("w" discarded).
+#else
+  #define STATE                   float4                                        // Padded "x, y, z, w" vectors.
+  #define load_state(a, i, w)     (a)[i]                                        // Loading node "i" state.
+  #define store_state(a, i, v)    (a)[i] = (v)                                  // Storing node "i" state.
+#endif
+
+// Position buffers of the explicit integrators, read @ t_n and written @ t_(n+1) by the 1st kernel:
+#ifdef PONG
+  #define POSITION_N              position_int                                  // Position @ t_n (odd time steps, see pong.cl).
+  #define POSITION_NEW            position                                      // Position @ t_(n+1) (odd time steps).
+#else
+  #define POSITION_N              position                                      // Position @ t_n.
+  #define POSITION_NEW            position_int                                  // Position @ t_(n+1).
+#endif
+
+// Conjugate gradient scalars (implicit integration):
+#define CG_RZ                     0                                             // Residual times preconditioned residual.
+#define CG_RZ0                    1                                             // Initial "CG_RZ" (< 0 = not yet computed).
+#define CG_ALPHA                  2                                             // Step length.
+#define CG_BETA                   3                                             // Search direction update factor.
+#define CG_DONE                   4                                             // Convergence flag (1 = converged).
+#define CG_TOL                    5                                             // Relative tolerance (set by host).
+#define CG_ITER                   6                                             // # of iterations of the last solve.
+#define CG_GROUPS                 7                                             // # of partial sums (set by host).
+#define CG_NODES                  8                                             // # of nodes (set by host).
+
+// Adaptive time step limits (set by host):
+#define DT_MIN                    0                                             // Minimum time step [s].
+#define DT_MAX                    1                                             // Maximum time step (stability bound) [s].
+#define DT_LENGTH                 2                                             // Mesh size [m].
+#define DT_CFL                    3                                             // Maximum node travel and link strain per time step.
+#define DT_GROWTH                 4                                             // Maximum time step growth per time step.
+#define DT_GROUPS                 5                                             // # of partial maxima.
+#define DT_NODES                  6                                             // # of nodes.
+
+// Dynamic relaxation scalars:
+#define DR_KE                     0                                             // Kinetic energy of the last step (0 after a peak) [J].
+#define DR_RESET                  1                                             // Kinetic energy peak flag (1 = velocities set to zero).
+#define DR_RESIDUAL               2                                             // Relative residual force.
+#define DR_DONE                   3                                             // Convergence flag (1 = static equilibrium reached).
+#define DR_STEPS                  4                                             // # of relaxation steps.
+#define DR_PEAKS                  5                                             // # of kinetic energy peaks.
+#define DR_TOL                    6                                             // Relative residual tolerance (set by host).
+#define DR_MASS                   7                                             // Fictitious mass scale factor (set by host).
+#define DR_GROUPS                 8                                             // # of partial sums (set by host).
+#define DR_NODES                  9                                             // # of nodes (set by host).
+
+// Sleeping nodes (set by host):
+#define SLEEP_SPEED               0                                             // Speed below which a node can sleep [m/s].
+#define SLEEP_ACCEL               1                                             // Acceleration below which a node can sleep [m/s^2].
+#define SLEEP_GROUPS              2                                             // # of compaction work-items.
+#define SLEEP_NODES               3                                             // # of nodes.
+
+// Device grid generation (set by host, see grid_init.cl):
+#define GRID_X_MIN                0                                             // "x_min" spatial boundary [m].
+#define GRID_Y_MIN                1                                             // "y_min" spatial boundary [m].
+#define GRID_DX                   2                                             // x-axis mesh spatial size [m].
+#define GRID_DY                   3                                             // y-axis mesh spatial size [m].
+#define GRID_DZ                   4                                             // z-axis mesh spatial size [m].
+#define GRID_G                    5                                             // External gravity field [m/s^2].
+#define GRID_K                    6                                             // Elastic constant [kg/s^2].
+#define GRID_C                    7                                             // Damping [kg*s*m].
+#define GRID_M                    8                                             // Node mass [kg].
+#define GRID_DT                   9                                             // Simulation time step [s].
+
 void link_displacements (
                           float4 position_R,                                    // Right neighbour position [m].
                           float4 position_U,                                    // Up neighbour position [m].
@@ -106,6 +185,81 @@ float4 node_force (
   return F;
 }
 
+// Link stiffness matrix K = d(F)/d(P_j) applied to vector "y" (implicit integration).
+// The transverse term is clamped at 0 for compressed links, so that K stays positive semidefinite.
+float4 link_jacobian (
+                       float4 link,                                             // Link vector (neighbour - node) [m].
+                       float  resting,                                          // Link resting length [m].
+                       float  stiffness,                                        // Link stiffness.
+                       float4 y                                                 // Applied vector.
+                     )
+{
+  float4      u;                                                                // Link direction.
+  float4      y_par;                                                            // Component of "y" along the link.
+  float       l;                                                                // Link length [m].
+  float       s;                                                                // Transverse stiffness ratio.
+
+  link.w = 0.0f;                                                                // Discarding projective component...
+  y.w = 0.0f;                                                                   // Discarding projective component...
+  l = length(link);                                                             // Computing link length...
+
+  if(l == 0.0f)
+  {
+    return (float4)(0.0f, 0.0f, 0.0f, 0.0f);                                    // Non-existing link.
+  }
+
+  u = link/l;                                                                   // Computing link direction...
+  s = fmax(1.0f - resting/l, 0.0f);                                             // Computing transverse stiffness ratio...
+  y_par = dot(u, y)*u;                                                          // Projecting "y" along the link...
+
+  return stiffness*(y_par + s*(y - y_par));
+}
+
+// Diagonal of the link stiffness matrix K = d(F)/d(P_j) (Jacobi preconditioner).
+float4 link_jacobian_diagonal (
+                                float4 link,                                    // Link vector (neighbour - node) [m].
+                                float  resting,                                 // Link resting length [m].
+                                float  stiffness                                // Link stiffness.
+                              )
+{
+  float4      u;                                                                // Link direction.
+  float       l;                                                                // Link length [m].
+  float       s;                                                                // Transverse stiffness ratio.
+
+  link.w = 0.0f;                                                                // Discarding projective component...
+  l = length(link);                                                             // Computing link length...
+
+  if(l == 0.0f)
+  {
+    return (float4)(0.0f, 0.0f, 0.0f, 0.0f);                                    // Non-existing link.
+  }
+
+  u = link/l;                                                                   // Computing link direction...
+  s = fmax(1.0f - resting/l, 0.0f);                                             // Computing transverse stiffness ratio...
+
+  return stiffness*(u*u + s*((float4)(1.0f, 1.0f, 1.0f, 0.0f) - u*u));
+}
+
+// Structured grid neighbour indexes (R, U, L, D) of node (i, j), from a 2D NDRange spanning the grid.
+// A neighbour beyond the grid border is the node itself (non-existing link).
+int4 grid_neighbours (
+                       int    i,                                                // Node "x" grid index [#].
+                       int    j                                                 // Node "y" grid index [#].
+                     )
+{
+  int         nodes_x = get_global_size(0);                                     // # of nodes in "x" direction [#].
+  int         nodes_y = get_global_size(1);                                     // # of nodes in "y" direction [#].
+  int         gid = i + nodes_x*j;                                              // Node index [#].
+  int4        n;                                                                // Neighbour indexes [#].
+
+  n.x = (i < nodes_x - 1) ? gid + 1 : gid;                                      // Setting right neighbour index [#]...
+  n.y = (j < nodes_y - 1) ? gid + nodes_x : gid;                                // Setting up neighbour index [#]...
+  n.z = (i > 0) ? gid - 1 : gid;                                                // Setting left neighbour index [#]...
+  n.w = (j > 0) ? gid - nodes_x : gid;                                          // Setting down neighbour index [#]...
+
+  return n;
+}
+
 void fix_projective_space (
                             float4* vector
                           )
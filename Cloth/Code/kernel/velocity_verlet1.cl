@@ -0,0 +1,67 @@
+/// @file
+
+// Velocity Verlet, 1st kernel: position update from the acceleration cached by the previous step.
+// No neighbour gather and no force evaluation are needed here.
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global STATE*     position_int,                       // Position (intermediate) [m].
+                        __global STATE*     velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global STATE*     acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+#ifndef STENCIL
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+#endif
+                        __global float4*    freedom,                            // Freedom flag [#].
+#ifdef ACTIVE_SET
+                        PARAMETER float*    dt_simulation,                      // Simulation time step [s].
+                        __global long*      active,                             // Active (awake) node indexes [#].
+                        __global long*      active_count)                       // # of active nodes [#].
+#else
+                        PARAMETER float*    dt_simulation)                      // Simulation time step [s].
+#endif
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+#if defined(ACTIVE_SET)
+  // NOTE: grid-stride loop, the active set can outgrow the launch size while nodes wake up.
+  long        count = active_count[0];                                          // # of active nodes [#].
+  for(long a = get_global_id(0); a < count; a += get_global_size(0))
+  {
+  unsigned long gid = active[a];                                                // Setting global index "gid" (active node)...
+#elif defined(STENCIL)
+  unsigned long gid = get_global_id(0) + get_global_size(0)*get_global_id(1);   // Setting global index "gid" (grid node)...
+#else
+  unsigned long gid = get_global_id(0);                                         // Global index [#].
+#endif
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////// SYNERGIC MOLECULE: KINEMATIC VARIABLES /////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      P  = POSITION_N[gid];                                             // Position @ t_n [m].
+  float4      V  = load_state(velocity, gid, 1.0f);                             // Velocity @ t_n [m/s].
+  float4      A  = load_state(acceleration, gid, 1.0f);                         // Acceleration @ t_n (cached) [m/s^2].
+  float4      fr = freedom[gid];                                                // Freedom flag [#].
+  float       dt = dt_simulation[PARAM(gid)];                                   // Simulation time step [s].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////// VERLET INTEGRATION /////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  // UPDATING POSITION (@ t_(n+1)):
+  P += fr*(V*dt + A*dt*dt/2.0f);                                                // Updating position [m]...
+
+  // FIXING PROJECTIVE SPACE:
+  fix_projective_space(&P);                                                     // Fixing position [m]...
+
+  // UPDATING INTERMEDIATE KINEMATICS:
+  store_state(POSITION_NEW, gid, P);                                            // Updating position (intermediate) [m]...
+#if defined(ACTIVE_SET)
+  }                                                                             // Next active node of this work-item...
+#endif
+}
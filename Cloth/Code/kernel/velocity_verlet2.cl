@@ -0,0 +1,206 @@
+/// @file
+
+// Velocity Verlet, 2nd kernel: one neighbour gather and one force evaluation @ t_(n+1).
+// The viscous force is linear in the velocity, hence the velocity update
+// V_(n+1) = V_n + dt*(A_n + A_(n+1))/2, with A_(n+1) = (Fe + Fg - C*V_(n+1))/m,
+// is solved in closed form: it is the fixed point the predictor-corrector iterates towards.
+#ifdef TILED
+__attribute__((work_group_size_hint(TILE_X, TILE_Y, 1)))
+#endif
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global STATE*     position_int,                       // Position (intermediate) [m].
+                        __global STATE*     velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global STATE*     acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+#ifndef STENCIL
+                        __global int4*      neighbour,                          // Neighbour indexes (R, U, L, D) [#].
+#endif
+                        __global float4*    freedom,                            // Freedom flag [#].
+#ifdef ACTIVE_SET
+                        PARAMETER float*    dt_simulation,                      // Simulation time step [s].
+                        __global long*      active,                             // Active (awake) node indexes [#].
+                        __global long*      active_count)                       // # of active nodes [#].
+#else
+                        PARAMETER float*    dt_simulation)                      // Simulation time step [s].
+#endif
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+#if defined(ACTIVE_SET)
+  // NOTE: grid-stride loop, the active set can outgrow the launch size while nodes wake up.
+  long        count = active_count[0];                                          // # of active nodes [#].
+  for(long a = get_global_id(0); a < count; a += get_global_size(0))
+  {
+  unsigned long gid = active[a];                                                // Setting global index "gid" (active node)...
+#elif defined(STENCIL)
+  unsigned long gid = get_global_id(0) + get_global_size(0)*get_global_id(1);   // Setting global index "gid" (grid node)...
+#else
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+#endif
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////// SYNERGIC MOLECULE: KINEMATIC VARIABLES /////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      P   = load_state(POSITION_NEW, gid, 1.0f);                        // Position @ t_(n+1) [m].
+  float4      V   = load_state(velocity, gid, 1.0f);                            // Velocity @ t_n [m/s].
+  float4      A   = load_state(acceleration, gid, 1.0f);                        // Acceleration @ t_n (cached) [m/s^2].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////// SYNERGIC MOLECULE: DYNAMIC VARIABLES ///////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      m   = mass[PARAM(gid)];                                           // Mass [kg].
+  float4      g   = gravity[PARAM(gid)];                                        // Gravity [m/s^2]
+  float4      C   = friction[PARAM(gid)];                                       // Friction coefficient.
+  float4      fr  = freedom[gid];                                               // Freedom flag [#].
+  float4      col = depth[gid];                                                 // Current node color.
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////// SYNERGIC MOLECULE: LINK INDEXES /////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  // NOTE: 1. the index of a non-existing particle friend must be set to the index of the particle.
+#ifdef STENCIL
+  int4        neighbours = grid_neighbours(get_global_id(0), get_global_id(1)); // Computing neighbour indexes from the grid index [#]...
+#else
+  int4        neighbours = neighbour[gid];                                      // Getting neighbour indexes (single load) [#]...
+#endif
+  long        n_R = neighbours.x;                                               // Setting right neighbour index [#]...
+  long        n_U = neighbours.y;                                               // Setting up neighbour index [#]...
+  long        n_L = neighbours.z;                                               // Setting left neighbour index [#]...
+  long        n_D = neighbours.w;                                               // Setting down neighbour index [#]...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////// SYNERGIC MOLECULE: LINKED PARTICLE POSITIONS /////////////////  t_(n+1)
+  ////////////////////////////////////////////////////////////////////////////////
+#ifdef TILED
+  __local float4 tile[TILE_SIZE];                                               // Positions of the work-group tile, halo included [m].
+  float4      P_R;                                                              // Right neighbour position [m].
+  float4      P_U;                                                              // Up neighbour position [m].
+  float4      P_L;                                                              // Left neighbour position [m].
+  float4      P_D;                                                              // Down neighbour position [m].
+
+  if(tile_fits())
+  {
+    tile_load(POSITION_NEW, tile);                                              // Staging positions in local memory...
+    P_R = tile[tile_index(1, 0)];                                               // Right neighbour position [m].
+    P_U = tile[tile_index(0, 1)];                                               // Up neighbour position [m].
+    P_L = tile[tile_index(-1, 0)];                                              // Left neighbour position [m].
+    P_D = tile[tile_index(0, -1)];                                              // Down neighbour position [m].
+  }
+  else
+  {
+    P_R = load_state(POSITION_NEW, n_R, 1.0f);                                  // Right neighbour position [m].
+    P_U = load_state(POSITION_NEW, n_U, 1.0f);                                  // Up neighbour position [m].
+    P_L = load_state(POSITION_NEW, n_L, 1.0f);                                  // Left neighbour position [m].
+    P_D = load_state(POSITION_NEW, n_D, 1.0f);                                  // Down neighbour position [m].
+  }
+#else
+  float4      P_R = load_state(POSITION_NEW, n_R, 1.0f);                        // Right neighbour position [m].
+  float4      P_U = load_state(POSITION_NEW, n_U, 1.0f);                        // Up neighbour position [m].
+  float4      P_L = load_state(POSITION_NEW, n_L, 1.0f);                        // Left neighbour position [m].
+  float4      P_D = load_state(POSITION_NEW, n_D, 1.0f);                        // Down neighbour position [m].
+#endif
+
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////// SYNERGIC MOLECULE: LINK RESTING DISTANCES /////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      resting_R = resting[PARAM(n_R)];                                  // Setting right neighbour resting position [m]...
+  float4      resting_U = resting[PARAM(n_U)];                                  // Setting up neighbour resting position [m]...
+  float4      resting_L = resting[PARAM(n_L)];                                  // Setting left neighbour resting position [m]...
+  float4      resting_D = resting[PARAM(n_D)];                                  // Setting down neighbour resting position [m]...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////// SYNERGIC MOLECULE: LINK STIFFNESS ///////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  // NOTE: the stiffness of a non-existing link must reset to 0.
+  float4      k_R = stiffness[PARAM(n_R)];                                      // Setting right neighbour stiffness...
+  float4      k_U = stiffness[PARAM(n_U)];                                      // Setting up neighbour stiffness...
+  float4      k_L = stiffness[PARAM(n_L)];                                      // Setting left neighbour stiffness...
+  float4      k_D = stiffness[PARAM(n_D)];                                      // Setting down neighbour stiffness...
+
+  //////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////// VERLET INTEGRATION ///////////////////////////
+  //////////////////////////////////////////////////////////////////////////////
+
+  // TIME STEP:
+  float dt = dt_simulation[PARAM(gid)];                                         // Setting simulation time step [s]...
+
+  // NEIGHBOURS DISPLACEMENTS:
+  float4      D_R;                                                              // Right neighbour displacement [m]...
+  float4      D_U;                                                              // Up neighbour displacement [m]...
+  float4      D_L;                                                              // Left neighbour displacement [m]...
+  float4      D_D;                                                              // Down neighbour displacement [m]...
+
+  // NODE FORCE (position dependent part, @ t_(n+1)):
+  float4      F;                                                                // Elastic + gravitational force [N].
+
+  // NODE ACCELERATION (@ t_(n+1)):
+  float4      Anew;                                                             // Node acceleration [m/s^2].
+
+  // COMPUTING LINK DISPLACEMENTS:
+  link_displacements(
+                      P_R,                                                      // Right neighbour position [m].
+                      P_U,                                                      // Up neighbour position [m].
+                      P_L,                                                      // Left neighbour position [m].
+                      P_D,                                                      // Down neighbour position [m].
+                      P,                                                        // Position [m].
+                      resting_R,                                                // Right neighbour resting position [m].
+                      resting_U,                                                // Up neighbour resting position [m].
+                      resting_L,                                                // Left neighbour resting position [m].
+                      resting_D,                                                // Down neighbour resting position [m].
+                      fr,                                                       // Freedom flag [#].
+                      &D_R,                                                     // Right neighbour displacement [m].
+                      &D_U,                                                     // Up neighbour displacement [m].
+                      &D_L,                                                     // Left neighbour displacement [m].
+                      &D_D                                                      // Down neighbour displacement [m].
+                    );
+
+  // COMPUTING NODE FORCE (zero velocity: viscous force excluded):
+  F = node_force  (
+                    k_R,                                                        // Right neighbour stiffness.
+                    k_U,                                                        // Right neighbour stiffness.
+                    k_L,                                                        // Right neighbour stiffness.
+                    k_D,                                                        // Right neighbour stiffness.
+                    D_R,                                                        // Right neighbour displacement [m].
+                    D_U,                                                        // Up neighbour displacement [m].
+                    D_L,                                                        // Left neighbour displacement [m].
+                    D_D,                                                        // Down neighbour displacement [m].
+                    C,                                                          // Friction coefficient.
+                    (float4)(0.0f, 0.0f, 0.0f, 0.0f),                           // Velocity [m/s].
+                    m,                                                          // Mass [kg].
+                    g,                                                          // Gravity [m/s^2].
+                    fr                                                          // Freedom flag [#].
+                  );
+
+  // COMPUTING VELOCITY (@ t_(n+1), viscous force solved implicitly):
+  V = (V + dt*(A + F/m)/2.0f)/(1.0f + fr*C*dt/(2.0f*m));                        // Computing velocity [m/s]...
+
+  // COMPUTING ACCELERATION (@ t_(n+1), cached for the next time step):
+  Anew = (F - fr*C*V)/m;                                                        // Computing acceleration [m/s^2]...
+
+  // FIXING PROJECTIVE SPACE:
+  fix_projective_space(&P);                                                     // Fixing position [m]...
+  fix_projective_space(&V);                                                     // Fixing velocity [m/s]...
+  fix_projective_space(&Anew);                                                  // Fixing acceleration [m/s^2]...
+
+  // ASSIGNING DEPTH COLOR:
+  assign_color(&col, &P);                                                       // Assigning depth color [#]...
+
+  // UPDATING KINEMATICS:
+#ifndef PING_PONG
+  position[gid] = P;                                                            // Updating position [m]...
+#endif
+  store_state(velocity, gid, V);                                                // Updating velocity [m/s]...
+  store_state(acceleration, gid, Anew);                                         // Updating acceleration [m/s^2]...
+  depth[gid] = col;                                                             // Updating color [#]...
+#if defined(ACTIVE_SET)
+  }                                                                             // Next active node of this work-item...
+#endif
+}
@@ -0,0 +1,226 @@
+/// @file
+
+// Temporally blocked velocity Verlet (BLOCKED): each launch advances BLOCK_T time steps.
+// The grid is split in blocks of BLOCK_X x BLOCK_Y nodes: a work-group stages a block plus a
+// BLOCK_T-node halo in local memory, then runs BLOCK_T velocity Verlet steps there. After each step
+// the outermost ring of the tile is stale (its neighbours are missing), hence the valid region
+// shrinks by one node per side and step: after BLOCK_T steps it is exactly the block, which is written
+// back. The state is read from (position, velocity, acceleration) and written to the intermediate
+// buffers, or the other way round with blocked_back.cl prepended: the two launches of a time step
+// sequence ping-pong between them, so that no block reads a halo already advanced by another work-group.
+// The blocks are assigned to the work-groups in a loop, hence any work-group size chosen by the
+// runtime is correct. BLOCK_X, BLOCK_Y and BLOCK_T are set in block_size.cl, prepended by the host.
+#define BLOCK_SX                  (BLOCK_X + 2*BLOCK_T)                         // Tile "x" size, halo included [#].
+#define BLOCK_SY                  (BLOCK_Y + 2*BLOCK_T)                         // Tile "y" size, halo included [#].
+#define BLOCK_SIZE                (BLOCK_SX*BLOCK_SY)                           // Tile size, halo included [#].
+
+__attribute__((work_group_size_hint(BLOCK_X, BLOCK_Y, 1)))
+__kernel void thekernel(__global float4*    position,                           // Position [m].
+                        __global float4*    depth,                              // Depth color [#]
+                        __global float4*    position_int,                       // Position (intermediate) [m].
+                        __global float4*    velocity,                           // Velocity [m/s].
+                        __global float4*    velocity_int,                       // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                       // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                   // Acceleration (intermediate) [m/s^2].
+                        PARAMETER float4*   gravity,                            // Gravity [m/s^2].
+                        PARAMETER float4*   stiffness,                          // Stiffness
+                        PARAMETER float4*   resting,                            // Resting distance [m].
+                        PARAMETER float4*   friction,                           // Friction
+                        PARAMETER float4*   mass,                               // Mass [kg].
+                        __global float4*    freedom,                            // Freedom flag [#].
+                        PARAMETER float*    dt_simulation)                      // Simulation time step [s].
+{
+#ifdef BLOCK_BACK
+  __global float4* P_in  = position_int;                                        // Position @ t_n [m].
+  __global float4* V_in  = velocity_int;                                        // Velocity @ t_n [m/s].
+  __global float4* A_in  = acceleration_int;                                    // Acceleration @ t_n [m/s^2].
+  __global float4* P_out = position;                                            // Position @ t_(n+BLOCK_T) [m].
+  __global float4* V_out = velocity;                                            // Velocity @ t_(n+BLOCK_T) [m/s].
+  __global float4* A_out = acceleration;                                        // Acceleration @ t_(n+BLOCK_T) [m/s^2].
+#else
+  __global float4* P_in  = position;                                            // Position @ t_n [m].
+  __global float4* V_in  = velocity;                                            // Velocity @ t_n [m/s].
+  __global float4* A_in  = acceleration;                                        // Acceleration @ t_n [m/s^2].
+  __global float4* P_out = position_int;                                        // Position @ t_(n+BLOCK_T) [m].
+  __global float4* V_out = velocity_int;                                        // Velocity @ t_(n+BLOCK_T) [m/s].
+  __global float4* A_out = acceleration_int;                                    // Acceleration @ t_(n+BLOCK_T) [m/s^2].
+#endif
+  __local float4 P_tile[BLOCK_SIZE];                                            // Tile positions [m].
+  __local float4 V_tile[BLOCK_SIZE];                                            // Tile velocities [m/s].
+  __local float4 A_tile[BLOCK_SIZE];                                            // Tile accelerations [m/s^2].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// BLOCK INDEXES ////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  int         nodes_x  = get_global_size(0);                                    // # of nodes in "x" direction [#].
+  int         nodes_y  = get_global_size(1);                                    // # of nodes in "y" direction [#].
+  int         blocks_x = (nodes_x + BLOCK_X - 1)/BLOCK_X;                       // # of blocks in "x" direction [#].
+  int         blocks   = blocks_x*((nodes_y + BLOCK_Y - 1)/BLOCK_Y);            // # of blocks [#].
+  int         group    = get_group_id(0) + get_num_groups(0)*get_group_id(1);   // Work-group index [#].
+  int         groups   = get_num_groups(0)*get_num_groups(1);                   // # of work-groups [#].
+  int         lid      = get_local_id(0) + get_local_size(0)*get_local_id(1);   // Local index [#].
+  int         stride   = get_local_size(0)*get_local_size(1);                   // # of work-items in the work-group [#].
+  int         b;                                                                // Block index [#].
+  int         s;                                                                // Time step index within the launch [#].
+  int         k;                                                                // Tile node index [#].
+  int         ti;                                                               // Tile "x" index [#].
+  int         tj;                                                               // Tile "y" index [#].
+  int         i_0;                                                              // Tile "x" origin [#].
+  int         j_0;                                                              // Tile "y" origin [#].
+  int         i;                                                                // Grid "x" index [#].
+  int         j;                                                                // Grid "y" index [#].
+  int         gid;                                                              // Global index [#].
+  int4        neighbours;                                                       // Neighbour indexes (R, U, L, D) [#].
+  int4        t_n;                                                              // Tile neighbour indexes (R, U, L, D) [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////// NODE VARIABLES //////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4      P;                                                                // Position [m].
+  float4      V;                                                                // Velocity [m/s].
+  float4      A;                                                                // Acceleration [m/s^2].
+  float4      m;                                                                // Mass [kg].
+  float4      C;                                                                // Friction coefficient.
+  float4      fr;                                                               // Freedom flag [#].
+  float4      col;                                                              // Current node color.
+  float       dt;                                                               // Simulation time step [s].
+  float4      D_R;                                                              // Right neighbour displacement [m]...
+  float4      D_U;                                                              // Up neighbour displacement [m]...
+  float4      D_L;                                                              // Left neighbour displacement [m]...
+  float4      D_D;                                                              // Down neighbour displacement [m]...
+  float4      F;                                                                // Elastic + gravitational force [N].
+
+  for(b = group; b < blocks; b += groups)
+  {
+    i_0 = (b%blocks_x)*BLOCK_X - BLOCK_T;                                       // Setting tile "x" origin [#]...
+    j_0 = (b/blocks_x)*BLOCK_Y - BLOCK_T;                                       // Setting tile "y" origin [#]...
+
+    // STAGING THE TILE (halo nodes beyond the grid border clamped to the border node):
+    for(k = lid; k < BLOCK_SIZE; k += stride)
+    {
+      i = clamp(i_0 + k%BLOCK_SX, 0, nodes_x - 1);                              // Clamping "x" index to the grid...
+      j = clamp(j_0 + k/BLOCK_SX, 0, nodes_y - 1);                              // Clamping "y" index to the grid...
+      gid = i + nodes_x*j;                                                      // Setting global index...
+      P_tile[k] = P_in[gid];                                                    // Staging position [m]...
+      V_tile[k] = V_in[gid];                                                    // Staging velocity [m/s]...
+      A_tile[k] = A_in[gid];                                                    // Staging acceleration [m/s^2]...
+    }
+
+    barrier(CLK_LOCAL_MEM_FENCE);                                               // Waiting for the whole tile...
+
+    for(s = 0; s < BLOCK_T; s++)
+    {
+      // UPDATING POSITIONS (@ t_(n+s+1), pointwise: whole tile):
+      for(k = lid; k < BLOCK_SIZE; k += stride)
+      {
+        i = clamp(i_0 + k%BLOCK_SX, 0, nodes_x - 1);                            // Clamping "x" index to the grid...
+        j = clamp(j_0 + k/BLOCK_SX, 0, nodes_y - 1);                            // Clamping "y" index to the grid...
+        gid = i + nodes_x*j;                                                    // Setting global index...
+        fr = freedom[gid];                                                      // Getting freedom flag [#]...
+        dt = dt_simulation[PARAM(gid)];                                         // Getting simulation time step [s]...
+        P = P_tile[k] + fr*(V_tile[k]*dt + A_tile[k]*dt*dt/2.0f);               // Computing position [m]...
+        fix_projective_space(&P);                                               // Fixing position [m]...
+        P_tile[k] = P;                                                          // Updating position [m]...
+      }
+
+      barrier(CLK_LOCAL_MEM_FENCE);                                             // Waiting for all positions...
+
+      // UPDATING VELOCITIES AND ACCELERATIONS (@ t_(n+s+1), valid region shrunk by s + 1 nodes):
+      for(k = lid; k < BLOCK_SIZE; k += stride)
+      {
+        ti = k%BLOCK_SX;                                                        // Setting tile "x" index [#]...
+        tj = k/BLOCK_SX;                                                        // Setting tile "y" index [#]...
+        i = i_0 + ti;                                                           // Setting grid "x" index [#]...
+        j = j_0 + tj;                                                           // Setting grid "y" index [#]...
+
+        if((ti <= s) || (ti >= BLOCK_SX - 1 - s) || (tj <= s) || (tj >= BLOCK_SY - 1 - s) ||
+           (i < 0) || (i >= nodes_x) || (j < 0) || (j >= nodes_y))
+        {
+          continue;                                                             // Stale or beyond the grid: nothing to do...
+        }
+
+        gid = i + nodes_x*j;                                                    // Setting global index...
+        neighbours = grid_neighbours(i, j);                                     // Computing neighbour indexes from the grid index [#]...
+
+        // A non-existing neighbour is the node itself, in the tile as in the grid:
+        t_n.x = (i < nodes_x - 1) ? k + 1 : k;                                  // Setting right tile neighbour index [#]...
+        t_n.y = (j < nodes_y - 1) ? k + BLOCK_SX : k;                           // Setting up tile neighbour index [#]...
+        t_n.z = (i > 0) ? k - 1 : k;                                            // Setting left tile neighbour index [#]...
+        t_n.w = (j > 0) ? k - BLOCK_SX : k;                                     // Setting down tile neighbour index [#]...
+
+        m  = mass[PARAM(gid)];                                                  // Getting mass [kg]...
+        C  = friction[PARAM(gid)];                                              // Getting friction coefficient...
+        fr = freedom[gid];                                                      // Getting freedom flag [#]...
+        dt = dt_simulation[PARAM(gid)];                                         // Getting simulation time step [s]...
+
+        // COMPUTING LINK DISPLACEMENTS:
+        link_displacements(
+                            P_tile[t_n.x],                                      // Right neighbour position [m].
+                            P_tile[t_n.y],                                      // Up neighbour position [m].
+                            P_tile[t_n.z],                                      // Left neighbour position [m].
+                            P_tile[t_n.w],                                      // Down neighbour position [m].
+                            P_tile[k],                                          // Position [m].
+                            resting[PARAM(neighbours.x)],                       // Right neighbour resting position [m].
+                            resting[PARAM(neighbours.y)],                       // Up neighbour resting position [m].
+                            resting[PARAM(neighbours.z)],                       // Left neighbour resting position [m].
+                            resting[PARAM(neighbours.w)],                       // Down neighbour resting position [m].
+                            fr,                                                 // Freedom flag [#].
+                            &D_R,                                               // Right neighbour displacement [m].
+                            &D_U,                                               // Up neighbour displacement [m].
+                            &D_L,                                               // Left neighbour displacement [m].
+                            &D_D                                                // Down neighbour displacement [m].
+                           );
+
+        // COMPUTING NODE FORCE (zero velocity: viscous force excluded):
+        F = node_force(
+                       stiffness[PARAM(neighbours.x)],                          // Right neighbour stiffness.
+                       stiffness[PARAM(neighbours.y)],                          // Up neighbour stiffness.
+                       stiffness[PARAM(neighbours.z)],                          // Left neighbour stiffness.
+                       stiffness[PARAM(neighbours.w)],                          // Down neighbour stiffness.
+                       D_R,                                                     // Right neighbour displacement [m].
+                       D_U,                                                     // Up neighbour displacement [m].
+                       D_L,                                                     // Left neighbour displacement [m].
+                       D_D,                                                     // Down neighbour displacement [m].
+                       C,                                                       // Friction coefficient.
+                       (float4)(0.0f, 0.0f, 0.0f, 0.0f),                        // Velocity [m/s].
+                       m,                                                       // Mass [kg].
+                       gravity[PARAM(gid)],                                     // Gravity [m/s^2].
+                       fr                                                       // Freedom flag [#].
+                      );
+
+        // COMPUTING VELOCITY AND ACCELERATION (viscous force solved implicitly, as in velocity_verlet2.cl):
+        V = (V_tile[k] + dt*(A_tile[k] + F/m)/2.0f)/(1.0f + fr*C*dt/(2.0f*m));  // Computing velocity [m/s]...
+        A = (F - fr*C*V)/m;                                                     // Computing acceleration [m/s^2]...
+        fix_projective_space(&V);                                               // Fixing velocity [m/s]...
+        fix_projective_space(&A);                                               // Fixing acceleration [m/s^2]...
+        V_tile[k] = V;                                                          // Updating velocity [m/s]...
+        A_tile[k] = A;                                                          // Updating acceleration [m/s^2]...
+      }
+
+      barrier(CLK_LOCAL_MEM_FENCE);                                             // Waiting for the time step...
+    }
+
+    // WRITING BACK THE BLOCK (@ t_(n+BLOCK_T)):
+    for(k = lid; k < BLOCK_X*BLOCK_Y; k += stride)
+    {
+      ti = BLOCK_T + k%BLOCK_X;                                                 // Setting tile "x" index [#]...
+      tj = BLOCK_T + k/BLOCK_X;                                                 // Setting tile "y" index [#]...
+      i = i_0 + ti;                                                             // Setting grid "x" index [#]...
+      j = j_0 + tj;                                                             // Setting grid "y" index [#]...
+
+      if((i < nodes_x) && (j < nodes_y))
+      {
+        gid = i + nodes_x*j;                                                    // Setting global index...
+        P = P_tile[ti + BLOCK_SX*tj];                                           // Getting position [m]...
+        col = depth[gid];                                                       // Getting current node color...
+        assign_color(&col, &P);                                                 // Assigning depth color [#]...
+        P_out[gid] = P;                                                         // Updating position [m]...
+        V_out[gid] = V_tile[ti + BLOCK_SX*tj];                                  // Updating velocity [m/s]...
+        A_out[gid] = A_tile[ti + BLOCK_SX*tj];                                  // Updating acceleration [m/s^2]...
+        depth[gid] = col;                                                       // Updating color [#]...
+      }
+    }
+
+    barrier(CLK_LOCAL_MEM_FENCE);                                               // Waiting before staging the next block...
+  }
+}
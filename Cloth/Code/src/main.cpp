@@ -1,7 +1,7 @@
 /// @file
 
 // OPENGL:
-#define INTEROP       true                                                                          // "true" = use OpenGL-OpenCL interoperability.
+#define INTEROP       true                                                                          // "true" = use OpenGL-OpenCL interoperability, "false" = headless batch mode.
 #define GUI_SIZE_X    800                                                                           // Window x-size [px].
 #define GUI_SIZE_Y    600                                                                           // Window y-size [px].
 #define GUI_NAME      "Neutrino - Cloth"                                                            // Window name.
@@ -27,17 +27,212 @@
 
 // OPENCL:
 #define QUEUE_NUM     1                                                                             // # of OpenCL queues [#].
-#define KERNEL_NUM    2                                                                             // # of OpenCL kernel [#].
+#define SUBSTEPS      1                                                                             // # of time steps per rendered frame [#].
+#define VENDOR_CACHE  true                                                                          // "true" = persistent program binary cache of the vendor OpenCL runtimes ("CACHE_HOME").
+#define CACHE_HOME    "vendor_cache"                                                                // Vendor OpenCL program cache directory (relative to the executable).
+
+// INTEGRATOR:
+#define PREDICTOR_CORRECTOR 0                                                                       // Verlet predictor-corrector (3 force evaluations per step).
+#define VELOCITY_VERLET     1                                                                       // Velocity Verlet, cached acceleration (1 force evaluation per step).
+#define BACKWARD_EULER      2                                                                       // Implicit backward Euler, conjugate gradient solver (stiff cloth).
+#define DYNAMIC_RELAXATION  3                                                                       // Dynamic relaxation, kinetic damping (static equilibrium only).
+#define INTEGRATOR    PREDICTOR_CORRECTOR                                                           // Time integration scheme.
+
+// IMPLICIT SOLVER (INTEGRATOR = BACKWARD_EULER):
+#define IMPLICIT_DT   20.0f                                                                         // Time step, in units of the critical time step [#].
+#define CG_ITERATIONS 100                                                                           // Maximum # of conjugate gradient iterations per time step [#].
+#define CG_TOLERANCE  1.0E-3f                                                                       // Conjugate gradient relative tolerance (preconditioned residual).
+#define CG_GROUPS     1024                                                                          // # of conjugate gradient partial sums (reduction work-items) [#].
+#define CG_CHECK      10                                                                            // # of CG iterations between two convergence flag reads [#].
+
+// DYNAMIC RELAXATION (INTEGRATOR = DYNAMIC_RELAXATION):
+#define DR_MASS_SCALE 1.0f                                                                          // Fictitious mass scale factor (stable if > 0.5) [#].
+#define DR_TOLERANCE  1.0E-3f                                                                       // Residual force tolerance, relative to the load.
+#define DR_GROUPS     1024                                                                          // # of dynamic relaxation partial sums (reduction work-items) [#].
+
+#if INTEGRATOR == BACKWARD_EULER
+  #define KERNEL_NUM  7                                                                             // # of OpenCL kernel [#].
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  #define KERNEL_NUM  3                                                                             // # of OpenCL kernel [#].
+#else
+  #define KERNEL_NUM  2                                                                             // # of OpenCL kernel [#].
+#endif
+
+// ADAPTIVE TIME STEP:
+#define ADAPTIVE      false                                                                         // "true" = time step driven by an on-device CFL reduction.
+#define DT_CFL        0.05f                                                                         // Max node travel (in mesh sizes) and link strain change per time step.
+#define DT_GROWTH     1.02f                                                                         // Max time step growth per time step [#].
+#define DT_MIN        0.05f                                                                         // Min time step, in units of the critical time step [#].
+#define DT_GROUPS     1024                                                                          // # of time step partial maxima (reduction work-items) [#].
+
+#if INTEGRATOR == BACKWARD_EULER
+  #define DT_MAX      100.0f                                                                        // Max time step, in units of the critical time step [#] (accuracy only).
+#else
+  // NOTE: stability limit of the explicit integrators on this grid measured at 0.9 (unstable at 0.92);
+  // the fixed time step (0.8, also the initial one with ADAPTIVE) starts below DT_MAX.
+  #define DT_STABLE   0.9f                                                                          // Stability limit, in units of the critical time step [#].
+  #define DT_MAX      (0.95f*DT_STABLE)                                                             // Max time step, in units of the critical time step [#] (5% stability margin).
+#endif
+
+#if ADAPTIVE
+  #define DT_KERNELS  3                                                                             // # of adaptive time step OpenCL kernels [#].
+#else
+  #define DT_KERNELS  0                                                                             // # of adaptive time step OpenCL kernels [#].
+#endif
+
+#if ADAPTIVE && (INTEGRATOR == DYNAMIC_RELAXATION)
+  #error "Dynamic relaxation uses a fictitious time step: set ADAPTIVE to false."
+#endif
+
+// SLEEPING NODES (PREDICTOR_CORRECTOR and VELOCITY_VERLET):
+#define SLEEPING      false                                                                         // "true" = skip resting nodes (active set compacted on the device).
+#define SLEEP_SPEED   1.0E-4f                                                                       // Speed below which a node can sleep [m/s].
+#define SLEEP_ACCEL   1.0E-2f                                                                       // Acceleration below which a node can sleep [m/s^2].
+#define SLEEP_GROUPS  1024                                                                          // # of active set compaction work-items [#].
+#define SLEEP_BUCKETS 8                                                                             // # of K1/K2 launch sizes (nodes, nodes/2, nodes/4...) [#].
+
+#if SLEEPING
+  #define SLEEP_KERNELS (3 + 2*(SLEEP_BUCKETS - 1))                                                 // # of sleeping nodes OpenCL kernels [#].
+#else
+  #define SLEEP_KERNELS 0                                                                           // # of sleeping nodes OpenCL kernels [#].
+#endif
+
+#if SLEEPING && ((INTEGRATOR == BACKWARD_EULER) || (INTEGRATOR == DYNAMIC_RELAXATION))
+  #error "Sleeping nodes need an explicit integrator: set INTEGRATOR to PREDICTOR_CORRECTOR or VELOCITY_VERLET."
+#endif
+
+#if SLEEPING && ADAPTIVE
+  #error "Sleeping nodes and adaptive time step share kernel arguments: set ADAPTIVE to false."
+#endif
+
+// STRUCTURED GRID STENCIL (PREDICTOR_CORRECTOR and VELOCITY_VERLET):
+#define STENCIL       false                                                                         // "true" = neighbours derived from a 2D grid index (no index buffer).
+
+#if STENCIL && ((INTEGRATOR == BACKWARD_EULER) || (INTEGRATOR == DYNAMIC_RELAXATION) || ADAPTIVE || SLEEPING)
+  #error "The grid stencil is implemented by the explicit integrator kernels only: set STENCIL to false."
+#endif
+
+// LOCAL MEMORY TILES (STENCIL, tile size set in tile_size.cl):
+#define TILED         false                                                                         // "true" = neighbour positions staged in local memory per work-group.
+#include "../kernel/tile_size.cl"                                                                   // Tile size (TILE_X, TILE_Y), shared with the kernels.
+
+#if TILED && !STENCIL
+  #error "Local memory tiles need the 2D grid NDRange: set STENCIL to true."
+#endif
+
+// TEMPORAL BLOCKING (VELOCITY_VERLET and STENCIL, block size set in block_size.cl):
+#define BLOCKED       false                                                                         // "true" = BLOCK_STEPS time steps per kernel launch in local memory.
+#include "../kernel/block_size.cl"                                                                  // Block size (BLOCK_X, BLOCK_Y, BLOCK_T), shared with the kernels.
+#define BLOCK_STEPS   BLOCK_T                                                                       // # of time steps per launch [#].
+
+#if BLOCKED && ((INTEGRATOR != VELOCITY_VERLET) || !STENCIL || TILED)
+  #error "Temporal blocking needs the velocity Verlet grid stencil: set INTEGRATOR to VELOCITY_VERLET, STENCIL to true, TILED to false."
+#endif
+
+// PACKED STATE (VELOCITY_VERLET):
+#define PACKED        false                                                                         // "true" = velocity, acceleration and intermediate position as packed "x, y, z".
+
+#if PACKED && ((INTEGRATOR != VELOCITY_VERLET) || TILED || BLOCKED || ADAPTIVE || SLEEPING)
+  #error "The packed state is implemented by the velocity Verlet kernels only: set PACKED to false."
+#endif
+
+#if PACKED
+  #define STATE_SIZE  3                                                                             // # of buffer elements per node state vector [#].
+#else
+  #define STATE_SIZE  1                                                                             // # of buffer elements per node state vector [#].
+#endif
+
+// PING-PONG POSITIONS (PREDICTOR_CORRECTOR and VELOCITY_VERLET):
+#define PING_PONG     false                                                                         // "true" = position buffers swapped every other time step (no position copy).
+
+#if PING_PONG && (((INTEGRATOR != PREDICTOR_CORRECTOR) && (INTEGRATOR != VELOCITY_VERLET)) || BLOCKED || PACKED || ADAPTIVE || SLEEPING)
+  #error "Ping-pong positions are implemented by the explicit integrator kernels only: set PING_PONG to false."
+#endif
+
+#if PING_PONG
+  #define PING_PONG_KERNELS 2                                                                       // # of 2nd kernel pair OpenCL kernels (swapped position buffers) [#].
+#else
+  #define PING_PONG_KERNELS 0                                                                       // # of 2nd kernel pair OpenCL kernels [#].
+#endif
+
+#if BLOCKED
+  #define SEQUENCE_STEPS (2*BLOCK_STEPS)                                                            // # of time steps per kernel sequence (two ping-pong launches) [#].
+#elif PING_PONG
+  #define SEQUENCE_STEPS 2                                                                          // # of time steps per kernel sequence (two kernel pairs) [#].
+#else
+  #define SEQUENCE_STEPS 1                                                                          // # of time steps per kernel sequence [#].
+#endif
+
+// UNIFORM NODE PARAMETERS:
+#define UNIFORM       false                                                                         // "true" = gravity, stiffness, resting, friction, mass and time step stored once.
+
+#if UNIFORM
+  #define PARAM(n)    0                                                                             // Node parameter index (single value for all nodes) [#].
+#else
+  #define PARAM(n)    (n)                                                                           // Node parameter index (one value per node) [#].
+#endif
+
+// DEVICE GRID GENERATION:
+#define DEVICE_INIT   false                                                                         // "true" = grid generated on the device by grid_init.cl (no host loop, no upload).
+
+#if DEVICE_INIT
+  #define INIT_KERNELS 1                                                                            // # of grid generation OpenCL kernels [#].
+#else
+  #define INIT_KERNELS 0                                                                            // # of grid generation OpenCL kernels [#].
+#endif
+
+// BATCH (headless mode, INTEROP = "false"):
+#define BATCH_DEVICE  NU_ALL                                                                        // OpenCL device type (any device, CPU runtimes included).
+#define BATCH_STEPS   10000                                                                         // Default # of time steps [#].
+#define BATCH_TIME    0.0f                                                                          // Default simulated time [s] ("> 0" overrides BATCH_STEPS).
 
 // INCLUDES:
 #include "nu.hpp"                                                                                   // Neutrino's header file.
-
-int main ()
+#include "vendor_cache.hpp"                                                                         // OpenCL vendor program caches.
+#include "int32_buffer.hpp"                                                                         // 32-bit integer buffers.
+#include <algorithm>                                                                                // Reduction work-items.
+#include <chrono>                                                                                   // Wall clock for batch timing.
+#include <fstream>                                                                                  // Final state files for batch runs.
+#include <stdexcept>                                                                                // Invalid command line values.
+
+// Usage (headless mode):
+// cloth [--steps <# of time steps>] [--time <simulated time [s]>] [--save <file>] [--compare <file>]
+int main (
+          int   argc,                                                                               // # of command line arguments.
+          char* argv[]                                                                              // Command line arguments.
+         )
 {
   // KERNEL FILES:
   std::string              kernel_home;                                                             // Kernel home directory.
   std::vector<std::string> kernel_1;                                                                // Kernel_1 source files.
   std::vector<std::string> kernel_2;                                                                // Kernel_2 source files.
+#if DEVICE_INIT
+  std::vector<std::string> kernel_init;                                                             // Grid generation kernel source files.
+#endif
+#if PING_PONG
+  std::vector<std::string> kernel_1_pong;                                                           // Kernel_1 source files (swapped position buffers).
+  std::vector<std::string> kernel_2_pong;                                                           // Kernel_2 source files (swapped position buffers).
+#endif
+#if INTEGRATOR == BACKWARD_EULER
+  std::vector<std::string> kernel_3;                                                                // Kernel_3 source files.
+  std::vector<std::string> kernel_4;                                                                // Kernel_4 source files.
+  std::vector<std::string> kernel_5;                                                                // Kernel_5 source files.
+  std::vector<std::string> kernel_6;                                                                // Kernel_6 source files.
+  std::vector<std::string> kernel_7;                                                                // Kernel_7 source files.
+#endif
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  std::vector<std::string> kernel_3;                                                                // Kernel_3 source files.
+#endif
+#if ADAPTIVE
+  std::vector<std::string> kernel_dt_reduce;                                                        // Adaptive time step reduction kernel source files.
+  std::vector<std::string> kernel_dt_control;                                                       // Adaptive time step control kernel source files.
+  std::vector<std::string> kernel_dt_broadcast;                                                     // Adaptive time step broadcast kernel source files.
+#endif
+#if SLEEPING
+  std::vector<std::string> kernel_sleep_mark;                                                       // Awake flags kernel source files.
+  std::vector<std::string> kernel_sleep_scan;                                                       // Active set offsets kernel source files.
+  std::vector<std::string> kernel_sleep_scatter;                                                    // Active set compaction kernel source files.
+#endif
 
   // DATA:
   float                    x_min              = -1.0f;                                              // "x_min" spatial boundary [m].
@@ -47,12 +242,20 @@ int main ()
   size_t                   nodes_x            = 100;                                                // # of nodes in "X" direction [#].
   size_t                   nodes_y            = 100;                                                // # of nodes in "Y" direction [#].
   size_t                   nodes              = nodes_x*nodes_y;                                    // Total # of nodes [#].
+  size_t                   parameters         = UNIFORM ? 1 : nodes;                                // # of values per node parameter [#].
+#if BLOCKED || (INTEGRATOR == DYNAMIC_RELAXATION)
+  size_t                   velocities_int     = nodes;                                              // # of intermediate velocities [#].
+#else
+  size_t                   velocities_int     = 1;                                                  // # of intermediate velocities (unused) [#].
+#endif
+  size_t                   accelerations_int  = BLOCKED ? nodes : 1;                                // # of intermediate accelerations (1 = unused) [#].
   float                    dx                 = (x_max - x_min)/(nodes_x - 1);                      // x-axis mesh spatial size [m].
   float                    dy                 = (y_max - y_min)/(nodes_y - 1);                      // y-axis mesh spatial size [m].
   float                    dz                 = dx;                                                 // z-axis mesh spatial size [m].
+  size_t                   gid;                                                                     // Global index [#].
+#if !DEVICE_INIT
   size_t                   i;                                                                       // "x" direction index [#].
   size_t                   j;                                                                       // "y" direction index [#].
-  size_t                   gid;                                                                     // Global index [#].
   size_t                   border_R           = nodes_x - 1;                                        // Cloth's right border index [#].
   size_t                   border_U           = nodes_y - 1;                                        // Cloth's up border index [#].
   size_t                   border_L           = 0;                                                  // Cloth's left border index [#].
@@ -61,7 +264,10 @@ int main ()
   size_t                   neighbour_U;                                                             // Up neighbour index [#].
   size_t                   neighbour_L;                                                             // Left neighbour index [#].
   size_t                   neighbour_D;                                                             // Down neighbour index [#].
+  cl_int4                  neighbours;                                                              // Current node neighbour indexes (R, U, L, D) [#].
+#endif
 
+#if INTEROP
   // GUI PARAMETERS (orbit):
   float                    orbit_x_init       = 0.0f;                                               // x-axis orbit initial rotation.
   float                    orbit_y_init       = 0.0f;                                               // y-axis orbit initial rotation.
@@ -81,6 +287,7 @@ int main ()
   float                    gamepad_pan_rate   = 1.0f;                                               // Pan translation rate [m/s].
   float                    gamepad_decaytime  = 1.25f;                                              // Low pass filter decay time [s].
   float                    gamepad_deadzone   = 0.1f;                                               // Gamepad joystick deadzone [0...1].
+#endif
 
   // SIMULATION PARAMETERS:
   float                    h                  = 0.01f;                                              // Cloth's thickness [m].
@@ -92,31 +299,126 @@ int main ()
   float                    k                  = E*h*dy/dx;                                          // Cloth's elastic constant [kg/s^2].
   float                    C                  = mu*h*dx*dy;                                         // Cloth's damping [kg*s*m].
   float                    dt_critical        = sqrt (m/k);                                         // Critical time step [s].
+#if INTEGRATOR == BACKWARD_EULER
+  float                    dt_simulation      = IMPLICIT_DT*dt_critical;                            // Simulation time step [s].
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  float                    dt_simulation      = dt_critical;                                        // Fictitious time step [s].
+#else
   float                    dt_simulation      = 0.8f* dt_critical;                                  // Simulation time step [s].
+#endif
 
   // NEUTRINO:
   neutrino*                bas                = new neutrino ();                                    // Neutrino baseline.
+#if INTEROP
   opengl*                  gui                = new opengl ();                                      // OpenGL context.
-  opencl*                  ctx                = new opencl ();                                      // OpenCL context.
   shader*                  S                  = new shader ();                                      // OpenGL shader program.
+#endif
+  opencl*                  ctx                = new opencl ();                                      // OpenCL context.
   queue*                   Q                  = new queue ();                                       // OpenCL queue.
   kernel*                  K1                 = new kernel ();                                      // OpenCL kernel array.
   kernel*                  K2                 = new kernel ();                                      // OpenCL kernel array.
+#if DEVICE_INIT
+  kernel*                  K_init             = new kernel ();                                      // OpenCL kernel (grid generation).
+#endif
+#if PING_PONG
+  kernel*                  K1_pong            = new kernel ();                                      // OpenCL kernel (K1, swapped position buffers).
+  kernel*                  K2_pong            = new kernel ();                                      // OpenCL kernel (K2, swapped position buffers).
+#endif
+#if INTEGRATOR == BACKWARD_EULER
+  kernel*                  K3                 = new kernel ();                                      // OpenCL kernel (CG matrix product).
+  kernel*                  K4                 = new kernel ();                                      // OpenCL kernel (CG step length).
+  kernel*                  K5                 = new kernel ();                                      // OpenCL kernel (CG update).
+  kernel*                  K6                 = new kernel ();                                      // OpenCL kernel (CG direction factor).
+  kernel*                  K7                 = new kernel ();                                      // OpenCL kernel (CG direction).
+  size_t                   cg_groups          = std::min<size_t> (CG_GROUPS, nodes);                // CG reduction work-items [#].
+  int                      iteration;                                                               // CG iteration index [#].
+  std::vector<kernel*>     cg_kernels;                                                              // OpenCL kernels of one CG iteration, in enqueueing order.
+  size_t                   cg_start;                                                                // Index of the time step kernel preceded by the CG iterations [#].
+#endif
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  kernel*                  K3                 = new kernel ();                                      // OpenCL kernel (DR kinetic damping).
+  size_t                   dr_groups          = std::min<size_t> (DR_GROUPS, nodes);                // DR reduction work-items [#].
+  bool                     relaxed            = false;                                              // Static equilibrium flag.
+#endif
+#if ADAPTIVE
+  kernel*                  K_dt_reduce        = new kernel ();                                      // OpenCL kernel (time step partial maxima).
+  kernel*                  K_dt_control       = new kernel ();                                      // OpenCL kernel (next time step).
+  kernel*                  K_dt_broadcast     = new kernel ();                                      // OpenCL kernel (time step broadcast).
+  size_t                   dt_groups          = std::min<size_t> (DT_GROUPS, nodes);                // Time step reduction work-items [#].
+#endif
+#if SLEEPING
+  kernel*                  K_sleep_mark       = new kernel ();                                      // OpenCL kernel (awake flags).
+  kernel*                  K_sleep_scan       = new kernel ();                                      // OpenCL kernel (active set offsets).
+  kernel*                  K_sleep_scatter    = new kernel ();                                      // OpenCL kernel (active set compaction).
+  std::vector<kernel*>     K1_bucket;                                                               // K1 kernels, one per launch size.
+  std::vector<kernel*>     K2_bucket;                                                               // K2 kernels, one per launch size.
+  std::vector<size_t>      bucket_size;                                                             // Launch sizes (nodes, nodes/2, nodes/4...) [#].
+  size_t                   bucket;                                                                  // Launch size index [#].
+  size_t                   active_nodes       = nodes;                                              // # of active nodes (last read) [#].
+  size_t                   sleep_groups       = std::min<size_t> (SLEEP_GROUPS, nodes);             // Active set compaction work-items [#].
+#endif
+  std::vector<kernel*>     step_kernels;                                                            // OpenCL kernels of one time step, in enqueueing order.
+  size_t                   step_kernel;                                                             // Time step kernel index [#].
+#if STENCIL
+  size_t                   kernel_sx          = nodes_x;                                            // Kernel dimension "x" [#].
+  size_t                   kernel_sy          = nodes_y;                                            // Kernel dimension "y" [#].
+#else
   size_t                   kernel_sx          = nodes;                                              // Kernel dimension "x" [#].
   size_t                   kernel_sy          = 0;                                                  // Kernel dimension "y" [#].
+#endif
   size_t                   kernel_sz          = 0;                                                  // Kernel dimension "z" [#].
 
   // NODE KINEMATICS:
+#if INTEROP
   float4G*                 position           = new float4G ();                                     // Position [m].
   float4G*                 depth              = new float4G ();                                     // Depth [m].
+#else
+  float4*                  position           = new float4 ();                                      // Position [m].
+  float4*                  depth              = new float4 ();                                      // Depth [m].
+#endif
+#if PACKED
+  float1*                  velocity           = new float1 ();                                      // Velocity, packed "x, y, z" [m/s].
+  float1*                  acceleration       = new float1 ();                                      // Acceleration, packed "x, y, z" [m/s^2].
+#else
   float4*                  velocity           = new float4 ();                                      // Velocity [m/s].
   float4*                  acceleration       = new float4 ();                                      // Acceleration [m/s^2].
+#endif
 
   // NODE KINEMATICS (INTERMEDIATE):
+#if PACKED
+  float1*                  position_int       = new float1 ();                                      // Position (intermediate), packed "x, y, z" [m].
+#else
   float4*                  position_int       = new float4 ();                                      // Position (intermediate) [m].
+#endif
   float4*                  velocity_int       = new float4 ();                                      // Velocity (intermediate) [m/s].
   float4*                  acceleration_int   = new float4 ();                                      // Acceleration (intermediate) [m/s^2].
 
+#if INTEGRATOR == BACKWARD_EULER
+  // IMPLICIT SOLVER (conjugate gradient):
+  float4*                  solution           = new float4 ();                                      // Velocity increment [m/s].
+  float4*                  residual           = new float4 ();                                      // Residual [N*s].
+  float4*                  direction          = new float4 ();                                      // Search direction [m/s].
+  float4*                  product            = new float4 ();                                      // System matrix times search direction [N*s].
+  float4*                  preconditioner     = new float4 ();                                      // Inverse Jacobi preconditioner [1/kg].
+  float1*                  partial            = new float1 ();                                      // Partial sums [#].
+  float1*                  scalars            = new float1 ();                                      // Scalars (see "CG_*" in utilities.cl) [#].
+#endif
+
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  // DYNAMIC RELAXATION:
+  float4*                  dr_partial         = new float4 ();                                      // Partial sums (kinetic energy, residual^2, load^2).
+  float1*                  dr_scalars         = new float1 ();                                      // Scalars (see "DR_*" in utilities.cl) [#].
+#endif
+
+#if SLEEPING
+  // SLEEPING NODES:
+  int1*                    active             = new int1 ();                                        // Active (awake) node indexes [#].
+  int1*                    active_count       = new int1 ();                                        // # of active nodes [#].
+  int1*                    awake              = new int1 ();                                        // Awake flag [#].
+  int1*                    sleep_count        = new int1 ();                                        // Awake nodes per work-item, then offsets [#].
+  float1*                  sleep_limits       = new float1 ();                                      // Sleeping thresholds (see "SLEEP_*" in utilities.cl).
+#endif
+
   // NODE DYNAMICS:
   float4*                  gravity            = new float4 ();                                      // Gravity [m/s^2].
   float4*                  stiffness          = new float4 ();                                      // Stiffness.
@@ -125,49 +427,220 @@ int main ()
   float4*                  mass               = new float4 ();                                      // Mass [kg].
 
   // MESH CONNECTIVITY:
-  int1*                    index_R            = new int1 ();                                        // Right neighbour index [#].
-  int1*                    index_U            = new int1 ();                                        // Up neighbour index [#].
-  int1*                    index_L            = new int1 ();                                        // Left neighbour index [#].
-  int1*                    index_D            = new int1 ();                                        // Down neighbour index [#].
+#if !STENCIL
+  int32_buffer<float4>*    neighbour          = new int32_buffer<float4> ();                        // Neighbour indexes (R, U, L, D), 4 per node [#].
+#endif
   float4*                  freedom            = new float4 ();                                      // Freedom/constrain flag [#].
 
   // SIMULATION TIME:
   float1*                  dt                 = new float1 ();                                      // Time step [s].
+#if DEVICE_INIT
+  float1*                  grid               = new float1 ();                                      // Grid generation scalars (see "GRID_*" in utilities.cl).
+#endif
+#if ADAPTIVE
+  float4*                  dt_partial         = new float4 ();                                      // Time step partial maxima (speed, acceleration, strain rate).
+  float1*                  dt_limits          = new float1 ();                                      // Time step limits (see "DT_*" in utilities.cl).
+  float1*                  elapsed            = new float1 ();                                      // Simulated time, updated on the device [s].
+#endif
   float                    simulation_time;                                                         // Simulation time [s].
   int                      time_step_index;                                                         // Time step index [#].
+  int                      substep;                                                                 // Substep index [#].
+
+#if !INTEROP
+  // BATCH:
+  size_t                   steps              = BATCH_STEPS;                                        // # of time steps to run [#].
+  float                    time_max           = BATCH_TIME;                                         // Simulated time to run [s].
+  std::string              option;                                                                  // Command line option.
+  bool                     usage              = false;                                              // Command line usage error flag.
+  std::string              save_file;                                                               // Final positions output file.
+  std::string              compare_file;                                                            // Reference positions input file.
+  float                    x_ref;                                                                   // Reference "x" position [m].
+  float                    y_ref;                                                                   // Reference "y" position [m].
+  float                    z_ref;                                                                   // Reference "z" position [m].
+  float                    error;                                                                   // Position error [m].
+  float                    error_max;                                                               // Maximum position error [m].
+  double                   error_rms;                                                               // RMS position error [m].
+  bool                     compare_error      = false;                                              // Reference positions file error flag.
+  double                   wall_time;                                                               // Wall clock time [s].
+  float                    z_min;                                                                   // Minimum "z" position [m].
+  float                    z_max;                                                                   // Maximum "z" position [m].
+  float                    v_max;                                                                   // Maximum speed [m/s].
+  float                    v_norm;                                                                  // Node speed [m/s].
+  double                   z_mean;                                                                  // Mean "z" position [m].
+  double                   kinetic_energy;                                                          // Kinetic energy [J].
+  size_t                   non_finite;                                                              // # of non-finite nodes [#].
+#if SLEEPING
+  double                   active_updates     = 0.0;                                                // Accumulated # of active node updates [#].
+#endif
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   ///////////////////////////////////////// DATA INITIALIZATION //////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   position->init (nodes);                                                                           // Initializing position data...
   depth->init (nodes);                                                                              // Initializing depth data...
-  velocity->init (nodes);                                                                           // Initializing velocity data...
-  acceleration->init (nodes);                                                                       // Initializing acceleration data...
+  velocity->init (STATE_SIZE*nodes);                                                                // Initializing velocity data...
+  acceleration->init (STATE_SIZE*nodes);                                                            // Initializing acceleration data...
+
+  position_int->init (STATE_SIZE*nodes);                                                            // Initializing intermediate position data...
+  velocity_int->init (velocities_int);                                                              // Initializing intermediate velocity data...
+  acceleration_int->init (accelerations_int);                                                       // Initializing intermediate acceleration data...
+
+#if INTEGRATOR == BACKWARD_EULER
+  solution->init (nodes);                                                                           // Initializing CG solution data...
+  residual->init (nodes);                                                                           // Initializing CG residual data...
+  direction->init (nodes);                                                                          // Initializing CG search direction data...
+  product->init (nodes);                                                                            // Initializing CG matrix product data...
+  preconditioner->init (nodes);                                                                     // Initializing CG preconditioner data...
+  partial->init (cg_groups);                                                                        // Initializing CG partial sums...
+  scalars->init (9);                                                                                // Initializing CG scalars...
+  scalars->data[5] = CG_TOLERANCE;                                                                  // Setting CG relative tolerance ("CG_TOL")...
+  scalars->data[7] = cg_groups;                                                                     // Setting # of CG partial sums ("CG_GROUPS")...
+  scalars->data[8] = nodes;                                                                         // Setting # of nodes ("CG_NODES")...
+#endif
 
-  position_int->init (nodes);                                                                       // Initializing intermediate position data...
-  velocity_int->init (nodes);                                                                       // Initializing intermediate position data...
-  acceleration_int->init (nodes);                                                                   // Initializing intermediate position data...
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  dr_partial->init (dr_groups);                                                                     // Initializing DR partial sums...
+  dr_scalars->init (10);                                                                            // Initializing DR scalars...
+  dr_scalars->data[0] = 0.0f;                                                                       // Resetting kinetic energy ("DR_KE") [J]...
+  dr_scalars->data[1] = 0.0f;                                                                       // Resetting kinetic energy peak flag ("DR_RESET")...
+  dr_scalars->data[2] = 1.0f;                                                                       // Resetting relative residual force ("DR_RESIDUAL")...
+  dr_scalars->data[3] = 0.0f;                                                                       // Resetting convergence flag ("DR_DONE")...
+  dr_scalars->data[4] = 0.0f;                                                                       // Resetting # of relaxation steps ("DR_STEPS")...
+  dr_scalars->data[5] = 0.0f;                                                                       // Resetting # of kinetic energy peaks ("DR_PEAKS")...
+  dr_scalars->data[6] = DR_TOLERANCE;                                                               // Setting relative residual tolerance ("DR_TOL")...
+  dr_scalars->data[7] = DR_MASS_SCALE;                                                              // Setting fictitious mass scale factor ("DR_MASS")...
+  dr_scalars->data[8] = dr_groups;                                                                  // Setting # of DR partial sums ("DR_GROUPS")...
+  dr_scalars->data[9] = nodes;                                                                      // Setting # of nodes ("DR_NODES")...
+#endif
+
+#if SLEEPING
+  active->init (nodes);                                                                             // Initializing active node indexes...
+  active_count->init (1);                                                                           // Initializing # of active nodes...
+  awake->init (nodes);                                                                              // Initializing awake flags...
+  sleep_count->init (sleep_groups);                                                                 // Initializing awake nodes per work-item...
+  sleep_limits->init (4);                                                                           // Initializing sleeping thresholds...
+
+  for(gid = 0; gid < nodes; gid++)
+  {
+    active->data[gid] = gid;                                                                        // Setting all nodes active at start...
+    awake->data[gid]  = 1;                                                                          // Setting all nodes awake at start...
+  }
 
-  gravity->init (nodes);                                                                            // Initializing gravity data...
-  stiffness->init (nodes);                                                                          // Initializing stiffness data...
-  resting->init (nodes);                                                                            // Initializing resiting position data...
-  friction->init (nodes);                                                                           // Initializing friction data...
-  mass->init (nodes);                                                                               // Initializing mass data...
+  active_count->data[0] = nodes;                                                                    // Setting # of active nodes...
+  sleep_limits->data[0] = SLEEP_SPEED;                                                              // Setting speed threshold ("SLEEP_SPEED") [m/s]...
+  sleep_limits->data[1] = SLEEP_ACCEL;                                                              // Setting acceleration threshold ("SLEEP_ACCEL") [m/s^2]...
+  sleep_limits->data[2] = sleep_groups;                                                             // Setting # of compaction work-items ("SLEEP_GROUPS")...
+  sleep_limits->data[3] = nodes;                                                                    // Setting # of nodes ("SLEEP_NODES")...
+#endif
 
-  index_R->init (nodes);                                                                            // Initializing right neighbour index...
-  index_U->init (nodes);                                                                            // Initializing up neighbour index...
-  index_L->init (nodes);                                                                            // Initializing left neighbour index...
-  index_D->init (nodes);                                                                            // Initializing down neighbour index...
+  gravity->init (parameters);                                                                       // Initializing gravity data...
+  stiffness->init (parameters);                                                                     // Initializing stiffness data...
+  resting->init (parameters);                                                                       // Initializing resiting position data...
+  friction->init (parameters);                                                                      // Initializing friction data...
+  mass->init (parameters);                                                                          // Initializing mass data...
+
+#if !STENCIL
+  neighbour->init (nodes);                                                                          // Initializing packed neighbour indexes...
+#endif
 
   freedom->init (nodes);                                                                            // Initializing freedom flag data...
-  dt->init (nodes);                                                                                 // Initializing time step data [s]...
+  dt->init (parameters);                                                                            // Initializing time step data [s]...
+
+#if DEVICE_INIT
+  grid->init (10);                                                                                  // Initializing grid generation scalars...
+  grid->data[0] = x_min;                                                                            // Setting "x_min" spatial boundary ("GRID_X_MIN") [m]...
+  grid->data[1] = y_min;                                                                            // Setting "y_min" spatial boundary ("GRID_Y_MIN") [m]...
+  grid->data[2] = dx;                                                                               // Setting x-axis mesh spatial size ("GRID_DX") [m]...
+  grid->data[3] = dy;                                                                               // Setting y-axis mesh spatial size ("GRID_DY") [m]...
+  grid->data[4] = dz;                                                                               // Setting z-axis mesh spatial size ("GRID_DZ") [m]...
+  grid->data[5] = g;                                                                                // Setting gravity field ("GRID_G") [m/s^2]...
+  grid->data[6] = k;                                                                                // Setting elastic constant ("GRID_K") [kg/s^2]...
+  grid->data[7] = C;                                                                                // Setting damping ("GRID_C") [kg*s*m]...
+  grid->data[8] = m;                                                                                // Setting node mass ("GRID_M") [kg]...
+  grid->data[9] = dt_simulation;                                                                    // Setting time step ("GRID_DT") [s]...
+#endif
+
+#if ADAPTIVE
+  dt_partial->init (dt_groups);                                                                     // Initializing time step partial maxima...
+  dt_limits->init (7);                                                                              // Initializing time step limits...
+  elapsed->init (1);                                                                                // Initializing simulated time...
+  dt_limits->data[0] = DT_MIN*dt_critical;                                                          // Setting minimum time step ("DT_MIN") [s]...
+  dt_limits->data[1] = DT_MAX*dt_critical;                                                          // Setting maximum time step ("DT_MAX") [s]...
+  dt_limits->data[2] = std::min (dx, dy);                                                           // Setting mesh size ("DT_LENGTH") [m]...
+  dt_limits->data[3] = DT_CFL;                                                                      // Setting maximum travel and strain per step ("DT_CFL")...
+  dt_limits->data[4] = DT_GROWTH;                                                                   // Setting maximum time step growth ("DT_GROWTH")...
+  dt_limits->data[5] = dt_groups;                                                                   // Setting # of partial maxima ("DT_GROUPS")...
+  dt_limits->data[6] = nodes;                                                                       // Setting # of nodes ("DT_NODES")...
+  elapsed->data[0]   = 0.0f;                                                                        // Initializing simulated time [s]...
+#endif
 
   simulation_time = 0.0;                                                                            // Initializing simulation time [s]...
   time_step_index = 0;                                                                              // Initializing time step index [#]...
 
+#if !INTEROP
+  for(int n = 1; (n < argc) && !usage; n++)
+  {
+    option = argv[n];                                                                               // Getting command line option...
+
+    try
+    {
+      if((option == "--steps") && (n + 1 < argc))
+      {
+        steps    = std::stoul (argv[++n]);                                                          // Setting # of time steps...
+        time_max = 0.0f;                                                                            // Disabling simulated time limit...
+      }
+      else if((option == "--time") && (n + 1 < argc))
+      {
+        time_max = std::stof (argv[++n]);                                                           // Setting simulated time [s]...
+      }
+      else if((option == "--save") && (n + 1 < argc))
+      {
+        save_file = argv[++n];                                                                      // Setting final positions output file...
+      }
+      else if((option == "--compare") && (n + 1 < argc))
+      {
+        compare_file = argv[++n];                                                                   // Setting reference positions input file...
+      }
+      else
+      {
+        usage = true;                                                                               // Unknown option or missing value...
+      }
+    }
+    catch(const std::invalid_argument&)
+    {
+      usage = true;                                                                                 // Value not a number...
+    }
+    catch(const std::out_of_range&)
+    {
+      usage = true;                                                                                 // Value out of range...
+    }
+  }
+
+  if(usage)
+  {
+    std::cerr << "Usage: " << argv[0] << " [--steps <# of time steps>] [--time <simulated time [s]>]"
+              << " [--save <file>] [--compare <file>]" << std::endl;
+    return 1;
+  }
+
+  if(time_max > 0.0f)
+  {
+#if ADAPTIVE
+    steps = (size_t)ceil (time_max/(DT_MIN*dt_critical));                                           // Bounding # of time steps (the run stops at "time_max")...
+#else
+    steps = (size_t)ceil (time_max/dt_simulation);                                                  // Converting simulated time to time steps...
+#endif
+  }
+#endif
+
   std::cout << "Critical time step = " << dt_critical << "[s]" << std::endl;
   std::cout << "Simulation time step = " << dt_simulation << "[s]" << std::endl;
+#if ADAPTIVE
+  std::cout << "Adaptive time step range = " << DT_MIN*dt_critical << ", " << DT_MAX*dt_critical << "[s]" << std::endl;
+#endif
 
+#if !DEVICE_INIT
   for(j = 0; j < nodes_y; j++)
   {
     for(i = 0; i < nodes_x; i++)
@@ -180,57 +653,67 @@ int main ()
       neighbour_D               = i + nodes_x*(j - 1);                                              // Computing down neighbour index...
 
       // Setting "x" initial position...
-      position->data[gid].x     = x_min + i*dx;                                                     // Setting "x" position...
-      position->data[gid].y     = y_min + j*dy;                                                     // Setting "y" position...
-      position->data[gid].z     = 0.0;                                                              // Setting "z" position...
-      position->data[gid].w     = 1.0;                                                              // Setting "w" position...
-
-      velocity->data[gid].x     = 0.0;                                                              // Setting "x" velocity...
-      velocity->data[gid].y     = 0.0;                                                              // Setting "y" velocity...
-      velocity->data[gid].z     = 0.0;                                                              // Setting "z" velocity...
-      velocity->data[gid].w     = 1.0;                                                              // Setting "w" velocity...
-
-      acceleration->data[gid].x = 0.0;                                                              // Setting "x" acceleration...
-      acceleration->data[gid].y = 0.0;                                                              // Setting "y" acceleration...
-      acceleration->data[gid].z = 0.0;                                                              // Setting "z" acceleration...
-      acceleration->data[gid].w = 1.0;                                                              // Setting "w" acceleration...
-
-      depth->data[gid].x        = 1.0;                                                              // Setting "x" initial color...
-      depth->data[gid].y        = 0.0;                                                              // Setting "y" initial color...
-      depth->data[gid].z        = 0.0;                                                              // Setting "z" initial color...
-      depth->data[gid].w        = 1.0;                                                              // Setting "w" initial color...
-
-      gravity->data[gid].x      = 0.0;                                                              // Setting "x" gravity...
-      gravity->data[gid].y      = 0.0;                                                              // Setting "y" gravity...
-      gravity->data[gid].z      = -g;                                                               // Setting "z" gravity...
-      gravity->data[gid].w      = 1.0;                                                              // Setting "w" gravity...
-
-      stiffness->data[gid].x    = k;                                                                // Setting "x" stiffness...
-      stiffness->data[gid].y    = k;                                                                // Setting "y" stiffness...
-      stiffness->data[gid].z    = k;                                                                // Setting "z" stiffness...
-      stiffness->data[gid].w    = 1.0;                                                              // Setting "w" stiffness...
-
-      resting->data[gid].x      = dx;                                                               // Setting "x" resting position...
-      resting->data[gid].y      = dy;                                                               // Setting "y" resting position...
-      resting->data[gid].z      = dz;                                                               // Setting "z" resting position...
-      resting->data[gid].w      = 1.0;                                                              // Setting "w" resting position...
-
-      friction->data[gid].x     = C;                                                                // Setting "x" friction...
-      friction->data[gid].y     = C;                                                                // Setting "y" friction...
-      friction->data[gid].z     = C;                                                                // Setting "z" friction...
-      friction->data[gid].w     = 1.0;                                                              // Setting "w" friction...
-
-      mass->data[gid].x         = m;                                                                // Setting "x" mass...
-      mass->data[gid].y         = m;                                                                // Setting "y" mass...
-      mass->data[gid].z         = m;                                                                // Setting "z" mass...
-      mass->data[gid].w         = 1.0;                                                              // Setting "w" mass...
-
-      freedom->data[gid].x      = 1.0;                                                              // Setting "x" freedom...
-      freedom->data[gid].y      = 1.0;                                                              // Setting "y" freedom...
-      freedom->data[gid].z      = 1.0;                                                              // Setting "z" freedom...
-      freedom->data[gid].w      = 1.0;                                                              // Setting "w" freedom...
-
-      dt->data[gid]             = dt_simulation;                                                    // Setting time step...
+      position->data[gid].x           = x_min + i*dx;                                               // Setting "x" position...
+      position->data[gid].y           = y_min + j*dy;                                               // Setting "y" position...
+      position->data[gid].z           = 0.0;                                                        // Setting "z" position...
+      position->data[gid].w           = 1.0;                                                        // Setting "w" position...
+
+#if PACKED
+      velocity->data[3*gid + 0]       = 0.0;                                                        // Setting "x" velocity...
+      velocity->data[3*gid + 1]       = 0.0;                                                        // Setting "y" velocity...
+      velocity->data[3*gid + 2]       = 0.0;                                                        // Setting "z" velocity...
+
+      acceleration->data[3*gid + 0]   = 0.0;                                                        // Setting "x" acceleration...
+      acceleration->data[3*gid + 1]   = 0.0;                                                        // Setting "y" acceleration...
+      acceleration->data[3*gid + 2]   = -g;                                                         // Setting "z" acceleration...
+#else
+      velocity->data[gid].x           = 0.0;                                                        // Setting "x" velocity...
+      velocity->data[gid].y           = 0.0;                                                        // Setting "y" velocity...
+      velocity->data[gid].z           = 0.0;                                                        // Setting "z" velocity...
+      velocity->data[gid].w           = 1.0;                                                        // Setting "w" velocity...
+
+      acceleration->data[gid].x       = 0.0;                                                        // Setting "x" acceleration...
+      acceleration->data[gid].y       = 0.0;                                                        // Setting "y" acceleration...
+      acceleration->data[gid].z       = -g;                                                         // Setting "z" acceleration...
+      acceleration->data[gid].w       = 1.0;                                                        // Setting "w" acceleration...
+#endif
+
+      depth->data[gid].x              = 1.0;                                                        // Setting "x" initial color...
+      depth->data[gid].y              = 0.0;                                                        // Setting "y" initial color...
+      depth->data[gid].z              = 0.0;                                                        // Setting "z" initial color...
+      depth->data[gid].w              = 1.0;                                                        // Setting "w" initial color...
+
+      gravity->data[PARAM(gid)].x     = 0.0;                                                        // Setting "x" gravity...
+      gravity->data[PARAM(gid)].y     = 0.0;                                                        // Setting "y" gravity...
+      gravity->data[PARAM(gid)].z     = -g;                                                         // Setting "z" gravity...
+      gravity->data[PARAM(gid)].w     = 1.0;                                                        // Setting "w" gravity...
+
+      stiffness->data[PARAM(gid)].x   = k;                                                          // Setting "x" stiffness...
+      stiffness->data[PARAM(gid)].y   = k;                                                          // Setting "y" stiffness...
+      stiffness->data[PARAM(gid)].z   = k;                                                          // Setting "z" stiffness...
+      stiffness->data[PARAM(gid)].w   = 1.0;                                                        // Setting "w" stiffness...
+
+      resting->data[PARAM(gid)].x     = dx;                                                         // Setting "x" resting position...
+      resting->data[PARAM(gid)].y     = dy;                                                         // Setting "y" resting position...
+      resting->data[PARAM(gid)].z     = dz;                                                         // Setting "z" resting position...
+      resting->data[PARAM(gid)].w     = 1.0;                                                        // Setting "w" resting position...
+
+      friction->data[PARAM(gid)].x    = C;                                                          // Setting "x" friction...
+      friction->data[PARAM(gid)].y    = C;                                                          // Setting "y" friction...
+      friction->data[PARAM(gid)].z    = C;                                                          // Setting "z" friction...
+      friction->data[PARAM(gid)].w    = 1.0;                                                        // Setting "w" friction...
+
+      mass->data[PARAM(gid)].x        = m;                                                          // Setting "x" mass...
+      mass->data[PARAM(gid)].y        = m;                                                          // Setting "y" mass...
+      mass->data[PARAM(gid)].z        = m;                                                          // Setting "z" mass...
+      mass->data[PARAM(gid)].w        = 1.0;                                                        // Setting "w" mass...
+
+      freedom->data[gid].x            = 1.0;                                                        // Setting "x" freedom...
+      freedom->data[gid].y            = 1.0;                                                        // Setting "y" freedom...
+      freedom->data[gid].z            = 1.0;                                                        // Setting "z" freedom...
+      freedom->data[gid].w            = 1.0;                                                        // Setting "w" freedom...
+
+      dt->data[PARAM(gid)]            = dt_simulation;                                              // Setting time step...
 
       // When on bulk:
       if(
@@ -240,18 +723,31 @@ int main ()
          (j != border_U)                                                                            // Not on up border.
         )
       {
-        index_R->data[gid] = neighbour_R;                                                           // Setting index to right neighbour...
-        index_U->data[gid] = neighbour_U;                                                           // Setting index to up neighbour...
-        index_L->data[gid] = neighbour_L;                                                           // Setting index to left neighbour...
-        index_D->data[gid] = neighbour_D;                                                           // Setting index to down neighbour...
+        neighbours.s[0] = neighbour_R;                                                              // Setting index to right neighbour...
+        neighbours.s[1] = neighbour_U;                                                              // Setting index to up neighbour...
+        neighbours.s[2] = neighbour_L;                                                              // Setting index to left neighbour...
+        neighbours.s[3] = neighbour_D;                                                              // Setting index to down neighbour...
       }
 
       else                                                                                          // When on all borders:
       {
+#if !UNIFORM
         gravity->data[gid].x = 0.0;                                                                 // Setting "x" gravity...
         gravity->data[gid].y = 0.0;                                                                 // Setting "y" gravity...
         gravity->data[gid].z = 0.0;                                                                 // Setting "z" gravity...
         gravity->data[gid].w = 1.0;                                                                 // Setting "w" gravity...
+#endif
+
+#if PACKED
+        acceleration->data[3*gid + 0] = 0.0;                                                        // Setting "x" acceleration...
+        acceleration->data[3*gid + 1] = 0.0;                                                        // Setting "y" acceleration...
+        acceleration->data[3*gid + 2] = 0.0;                                                        // Setting "z" acceleration...
+#else
+        acceleration->data[gid].x = 0.0;                                                            // Setting "x" acceleration...
+        acceleration->data[gid].y = 0.0;                                                            // Setting "y" acceleration...
+        acceleration->data[gid].z = 0.0;                                                            // Setting "z" acceleration...
+        acceleration->data[gid].w = 1.0;                                                            // Setting "w" acceleration...
+#endif
 
         freedom->data[gid].x = 0.0;                                                                 // Setting "x" freedom...
         freedom->data[gid].y = 0.0;                                                                 // Setting "y" freedom...
@@ -266,10 +762,10 @@ int main ()
          (j != border_U)                                                                            // Not on up border.
         )
       {
-        index_R->data[gid] = neighbour_R;                                                           // Setting index to right neighbour...
-        index_U->data[gid] = neighbour_U;                                                           // Setting index to up neighbour...
-        index_L->data[gid] = gid;
-        index_D->data[gid] = neighbour_D;                                                           // Setting index to down neighbour...
+        neighbours.s[0] = neighbour_R;                                                              // Setting index to right neighbour...
+        neighbours.s[1] = neighbour_U;                                                              // Setting index to up neighbour...
+        neighbours.s[2] = gid;
+        neighbours.s[3] = neighbour_D;                                                              // Setting index to down neighbour...
       }
 
       // When on right border (excluding extremes):
@@ -279,10 +775,10 @@ int main ()
          (j != border_U)                                                                            // Not on up border.
         )
       {
-        index_R->data[gid] = gid;
-        index_U->data[gid] = neighbour_U;                                                           // Setting index to up neighbour...
-        index_L->data[gid] = neighbour_L;                                                           // Setting index to left neighbour...
-        index_D->data[gid] = neighbour_D;                                                           // Setting index to down neighbour...
+        neighbours.s[0] = gid;
+        neighbours.s[1] = neighbour_U;                                                              // Setting index to up neighbour...
+        neighbours.s[2] = neighbour_L;                                                              // Setting index to left neighbour...
+        neighbours.s[3] = neighbour_D;                                                              // Setting index to down neighbour...
       }
 
       // When on bottom border (excluding extremes):
@@ -292,10 +788,10 @@ int main ()
          (i != border_R)                                                                            // Not on right border.
         )
       {
-        index_R->data[gid] = neighbour_R;                                                           // Setting index to right neighbour...
-        index_U->data[gid] = neighbour_U;                                                           // Setting index to up neighbour...
-        index_L->data[gid] = neighbour_L;                                                           // Setting index to left neighbour...
-        index_D->data[gid] = gid;                                                                   // Setting index to central node...
+        neighbours.s[0] = neighbour_R;                                                              // Setting index to right neighbour...
+        neighbours.s[1] = neighbour_U;                                                              // Setting index to up neighbour...
+        neighbours.s[2] = neighbour_L;                                                              // Setting index to left neighbour...
+        neighbours.s[3] = gid;                                                                      // Setting index to central node...
       }
 
       // When on high border (excluding extremes):
@@ -305,10 +801,10 @@ int main ()
          (i != border_R)                                                                            // Not on right border.
         )
       {
-        index_R->data[gid] = neighbour_R;                                                           // Setting index to right neighbour...
-        index_U->data[gid] = gid;                                                                   // Setting index to central node...
-        index_L->data[gid] = neighbour_L;                                                           // Setting index to left neighbour...
-        index_D->data[gid] = neighbour_D;                                                           // Setting index to down neighbour...
+        neighbours.s[0] = neighbour_R;                                                              // Setting index to right neighbour...
+        neighbours.s[1] = gid;                                                                      // Setting index to central node...
+        neighbours.s[2] = neighbour_L;                                                              // Setting index to left neighbour...
+        neighbours.s[3] = neighbour_D;                                                              // Setting index to down neighbour...
       }
 
       // When on bottom left corner:
@@ -317,10 +813,10 @@ int main ()
          (j == border_D)                                                                            // On down border.
         )
       {
-        index_R->data[gid] = neighbour_R;                                                           // Setting index to right neighbour...
-        index_U->data[gid] = neighbour_U;                                                           // Setting index to up neighbour...
-        index_L->data[gid] = gid;                                                                   // Setting index to central node...
-        index_D->data[gid] = gid;                                                                   // Setting index to central node...
+        neighbours.s[0] = neighbour_R;                                                              // Setting index to right neighbour...
+        neighbours.s[1] = neighbour_U;                                                              // Setting index to up neighbour...
+        neighbours.s[2] = gid;                                                                      // Setting index to central node...
+        neighbours.s[3] = gid;                                                                      // Setting index to central node...
       }
 
       // When on bottom right corner:
@@ -329,10 +825,10 @@ int main ()
          (j == border_D)                                                                            // On down border.
         )
       {
-        index_R->data[gid] = gid;                                                                   // Setting index to central node...
-        index_U->data[gid] = neighbour_U;                                                           // Setting index to up neighbour...
-        index_L->data[gid] = neighbour_L;                                                           // Setting index to left neighbour...
-        index_D->data[gid] = gid;                                                                   // Setting index to central node...
+        neighbours.s[0] = gid;                                                                      // Setting index to central node...
+        neighbours.s[1] = neighbour_U;                                                              // Setting index to up neighbour...
+        neighbours.s[2] = neighbour_L;                                                              // Setting index to left neighbour...
+        neighbours.s[3] = gid;                                                                      // Setting index to central node...
       }
 
       // When on top left corner:
@@ -341,10 +837,10 @@ int main ()
          (j == border_U)                                                                            // On up border.
         )
       {
-        index_R->data[gid] = neighbour_R;                                                           // Setting index to right neighbour...
-        index_U->data[gid] = gid;                                                                   // Setting index to central node...
-        index_L->data[gid] = gid;                                                                   // Setting index to central node...
-        index_D->data[gid] = neighbour_D;                                                           // Setting index to down neighbour...
+        neighbours.s[0] = neighbour_R;                                                              // Setting index to right neighbour...
+        neighbours.s[1] = gid;                                                                      // Setting index to central node...
+        neighbours.s[2] = gid;                                                                      // Setting index to central node...
+        neighbours.s[3] = neighbour_D;                                                              // Setting index to down neighbour...
       }
 
       // When on top right corner:
@@ -353,18 +849,38 @@ int main ()
          (j == border_U)                                                                            // On up border.
         )
       {
-        index_R->data[gid] = gid;                                                                   // Setting index to central node...
-        index_U->data[gid] = gid;                                                                   // Setting index to central node...
-        index_L->data[gid] = neighbour_L;                                                           // Setting index to left neighbour...
-        index_D->data[gid] = neighbour_D;                                                           // Setting index to down neighbour...
+        neighbours.s[0] = gid;                                                                      // Setting index to central node...
+        neighbours.s[1] = gid;                                                                      // Setting index to central node...
+        neighbours.s[2] = neighbour_L;                                                              // Setting index to left neighbour...
+        neighbours.s[3] = neighbour_D;                                                              // Setting index to down neighbour...
       }
+
+#if !STENCIL
+      neighbour->set (4*gid, neighbours.s, 4);                                                      // Setting neighbour indexes...
+#endif
     }
   }
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////// NEUTRINO INITIALIZATION /////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
-  bas->init (QUEUE_NUM, KERNEL_NUM);                                                                // Initializing Neutrino baseline...
+#if TILED
+  if((nodes_x%TILE_X != 0) || (nodes_y%TILE_Y != 0))
+  {
+    std::cerr << "Warning: the " << TILE_X << " x " << TILE_Y << " tile does not divide the grid, the work-group"
+              << " size is left to the OpenCL runtime." << std::endl;                               // Printing message...
+  }
+#endif
+#if VENDOR_CACHE
+  vendor_cache (CACHE_HOME);                                                                        // Enabling vendor OpenCL program caches...
+#endif
+  bas->init
+  (
+   QUEUE_NUM,                                                                                       // # of OpenCL queues.
+   KERNEL_NUM + DT_KERNELS + SLEEP_KERNELS + PING_PONG_KERNELS + INIT_KERNELS                       // # of OpenCL kernels.
+  );                                                                                                // Initializing Neutrino baseline...
+#if INTEROP
   gui->init
   (
    bas,                                                                                             // Neutrino baseline.
@@ -379,14 +895,269 @@ int main ()
   );
   ctx->init (bas, gui, NU_GPU);                                                                     // Initializing OpenCL context...
   S->init (bas, SHADER_HOME, SHADER_VERT, SHADER_GEOM, SHADER_FRAG);                                // Initializing OpenGL shader...
+#else
+  ctx->init (bas, NULL, BATCH_DEVICE);                                                              // Initializing OpenCL context (no OpenGL)...
+#endif
   Q->init (bas);                                                                                    // Initializing OpenCL queue...
   kernel_home = KERNEL_HOME;                                                                        // Setting kernel home directory...
+#if PACKED
+  kernel_1.push_back ("packed.cl");                                                                 // Packed "x, y, z" node state...
+#endif
+#if UNIFORM
+  kernel_1.push_back ("uniform.cl");                                                                // Single value node parameters...
+#endif
+#if PING_PONG
+  kernel_1.push_back ("ping_pong.cl");                                                              // Position left in the 1st kernel output buffer...
+#endif
   kernel_1.push_back ("utilities.cl");                                                              // Setting 1st source file...
+#if SLEEPING
+  kernel_1.push_back ("active_set.cl");                                                             // Running over the active set only...
+#endif
+#if STENCIL
+  kernel_1.push_back ("stencil.cl");                                                                // Deriving neighbours from the grid index...
+#endif
+#if TILED
+  kernel_1.push_back ("tile_size.cl");                                                              // Setting the tile size...
+  kernel_1.push_back ("tiled.cl");                                                                  // Staging neighbour positions in local memory...
+#endif
+#if BLOCKED
+  kernel_1.push_back ("block_size.cl");                                                             // Setting the block size...
+  kernel_1.push_back ("velocity_verlet_blocked.cl");                                                // Setting 2nd source file...
+#elif INTEGRATOR == VELOCITY_VERLET
+  kernel_1.push_back ("velocity_verlet1.cl");                                                       // Setting 2nd source file...
+#elif INTEGRATOR == BACKWARD_EULER
+  kernel_1.push_back ("backward_euler1.cl");                                                        // Setting 2nd source file...
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  kernel_1.push_back ("relaxation1.cl");                                                            // Setting 2nd source file...
+#else
   kernel_1.push_back ("thekernel1.cl");                                                             // Setting 2nd source file...
+#endif
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  K1->init (bas, kernel_home, kernel_1, dr_groups, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K1...
+#else
   K1->init (bas, kernel_home, kernel_1, kernel_sx, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K1...
+#endif
+#if PACKED
+  kernel_2.push_back ("packed.cl");                                                                 // Packed "x, y, z" node state...
+#endif
+#if UNIFORM
+  kernel_2.push_back ("uniform.cl");                                                                // Single value node parameters...
+#endif
+#if PING_PONG
+  kernel_2.push_back ("ping_pong.cl");                                                              // Position left in the 1st kernel output buffer...
+#endif
   kernel_2.push_back ("utilities.cl");                                                              // Setting 1st source file...
+#if SLEEPING
+  kernel_2.push_back ("active_set.cl");                                                             // Running over the active set only...
+#endif
+#if STENCIL
+  kernel_2.push_back ("stencil.cl");                                                                // Deriving neighbours from the grid index...
+#endif
+#if TILED
+  kernel_2.push_back ("tile_size.cl");                                                              // Setting the tile size...
+  kernel_2.push_back ("tiled.cl");                                                                  // Staging neighbour positions in local memory...
+#endif
+#if BLOCKED
+  kernel_2.push_back ("block_size.cl");                                                             // Setting the block size...
+  kernel_2.push_back ("blocked_back.cl");                                                           // Reading the state back from the intermediate buffers...
+  kernel_2.push_back ("velocity_verlet_blocked.cl");                                                // Setting 2nd source file...
+#elif INTEGRATOR == VELOCITY_VERLET
+  kernel_2.push_back ("velocity_verlet2.cl");                                                       // Setting 2nd source file...
+#elif INTEGRATOR == BACKWARD_EULER
+  kernel_2.push_back ("backward_euler2.cl");                                                        // Setting 2nd source file...
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  kernel_2.push_back ("relaxation2.cl");                                                            // Setting 2nd source file...
+#else
   kernel_2.push_back ("thekernel2.cl");                                                             // Setting 2nd source file...
+#endif
   K2->init (bas, kernel_home, kernel_2, kernel_sx, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K2...
+#if DEVICE_INIT
+#if PACKED
+  kernel_init.push_back ("packed.cl");                                                              // Packed "x, y, z" node state...
+#endif
+#if UNIFORM
+  kernel_init.push_back ("uniform.cl");                                                             // Single value node parameters...
+#endif
+#if STENCIL
+  kernel_init.push_back ("stencil.cl");                                                             // No neighbour index buffer...
+#endif
+  kernel_init.push_back ("utilities.cl");                                                           // Setting 1st source file...
+  kernel_init.push_back ("grid_init.cl");                                                           // Setting 2nd source file...
+  K_init->init (bas, kernel_home, kernel_init, nodes_x, nodes_y, kernel_sz);                        // Initializing OpenCL kernel K_init (2D grid NDRange)...
+#endif
+#if PING_PONG
+  kernel_1_pong = kernel_1;                                                                         // Same sources as K1...
+  kernel_2_pong = kernel_2;                                                                         // Same sources as K2...
+  kernel_1_pong.insert (kernel_1_pong.begin (), "pong.cl");                                         // Swapping position buffers...
+  kernel_2_pong.insert (kernel_2_pong.begin (), "pong.cl");                                         // Swapping position buffers...
+  K1_pong->init (bas, kernel_home, kernel_1_pong, kernel_sx, kernel_sy, kernel_sz);                 // Initializing OpenCL kernel K1_pong...
+  K2_pong->init (bas, kernel_home, kernel_2_pong, kernel_sx, kernel_sy, kernel_sz);                 // Initializing OpenCL kernel K2_pong...
+#endif
+#if SLEEPING
+  K1_bucket.push_back (K1);                                                                         // Setting full launch size K1...
+  K2_bucket.push_back (K2);                                                                         // Setting full launch size K2...
+  bucket_size.push_back (kernel_sx);                                                                // Setting full launch size [#]...
+
+  // Kernel global sizes are fixed at initialization: halving launch sizes, one K1/K2 pair each...
+  for(bucket = 1; bucket < SLEEP_BUCKETS; bucket++)
+  {
+    bucket_size.push_back ((nodes + ((size_t)1 << bucket) - 1) >> bucket);                          // Setting launch size [#]...
+    K1_bucket.push_back (new kernel ());                                                            // Adding K1 kernel...
+    K2_bucket.push_back (new kernel ());                                                            // Adding K2 kernel...
+    K1_bucket[bucket]->init (
+                             bas,                                                                   // Neutrino baseline.
+                             kernel_home,                                                           // Kernel home directory.
+                             kernel_1,                                                              // Kernel source files.
+                             bucket_size[bucket],                                                   // Kernel dimension "x" (bucket launch size) [#].
+                             kernel_sy,                                                             // Kernel dimension "y" [#].
+                             kernel_sz                                                              // Kernel dimension "z" [#].
+                            );
+    K2_bucket[bucket]->init (
+                             bas,                                                                   // Neutrino baseline.
+                             kernel_home,                                                           // Kernel home directory.
+                             kernel_2,                                                              // Kernel source files.
+                             bucket_size[bucket],                                                   // Kernel dimension "x" (bucket launch size) [#].
+                             kernel_sy,                                                             // Kernel dimension "y" [#].
+                             kernel_sz                                                              // Kernel dimension "z" [#].
+                            );
+  }
+
+  kernel_sleep_mark.push_back ("utilities.cl");                                                     // Setting 1st source file...
+  kernel_sleep_mark.push_back ("sleep_mark.cl");                                                    // Setting 2nd source file...
+  K_sleep_mark->init (bas, kernel_home, kernel_sleep_mark, sleep_groups, kernel_sy, kernel_sz);     // Initializing OpenCL kernel K_sleep_mark...
+  kernel_sleep_scan.push_back ("utilities.cl");                                                     // Setting 1st source file...
+  kernel_sleep_scan.push_back ("sleep_scan.cl");                                                    // Setting 2nd source file...
+  K_sleep_scan->init (bas, kernel_home, kernel_sleep_scan, 1, kernel_sy, kernel_sz);                // Initializing OpenCL kernel K_sleep_scan...
+  kernel_sleep_scatter.push_back ("utilities.cl");                                                  // Setting 1st source file...
+  kernel_sleep_scatter.push_back ("sleep_scatter.cl");                                              // Setting 2nd source file...
+  K_sleep_scatter->init (
+                         bas,                                                                       // Neutrino baseline.
+                         kernel_home,                                                               // Kernel home directory.
+                         kernel_sleep_scatter,                                                      // Kernel source files.
+                         sleep_groups,                                                              // Kernel dimension "x" [#].
+                         kernel_sy,                                                                 // Kernel dimension "y" [#].
+                         kernel_sz                                                                  // Kernel dimension "z" [#].
+                        );
+  bucket = 0;                                                                                       // Starting with all nodes awake...
+#endif
+#if INTEGRATOR == BACKWARD_EULER
+#if UNIFORM
+  kernel_3.push_back ("uniform.cl");                                                                // Single value node parameters...
+#endif
+  kernel_3.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_3.push_back ("cg_matvec.cl");                                                              // Setting 2nd source file...
+  K3->init (bas, kernel_home, kernel_3, cg_groups, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K3...
+  kernel_4.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_4.push_back ("cg_alpha.cl");                                                               // Setting 2nd source file...
+  K4->init (bas, kernel_home, kernel_4, 1, kernel_sy, kernel_sz);                                   // Initializing OpenCL kernel K4...
+  kernel_5.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_5.push_back ("cg_update.cl");                                                              // Setting 2nd source file...
+  K5->init (bas, kernel_home, kernel_5, cg_groups, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K5...
+  kernel_6.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_6.push_back ("cg_beta.cl");                                                                // Setting 2nd source file...
+  K6->init (bas, kernel_home, kernel_6, 1, kernel_sy, kernel_sz);                                   // Initializing OpenCL kernel K6...
+  kernel_7.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_7.push_back ("cg_direction.cl");                                                           // Setting 2nd source file...
+  K7->init (bas, kernel_home, kernel_7, kernel_sx, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K7...
+#endif
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  kernel_3.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_3.push_back ("relaxation_check.cl");                                                       // Setting 2nd source file...
+  K3->init (bas, kernel_home, kernel_3, 1, kernel_sy, kernel_sz);                                   // Initializing OpenCL kernel K3...
+#endif
+#if ADAPTIVE
+  kernel_dt_reduce.push_back ("utilities.cl");                                                      // Setting 1st source file...
+  kernel_dt_reduce.push_back ("dt_reduce.cl");                                                      // Setting 2nd source file...
+  K_dt_reduce->init (bas, kernel_home, kernel_dt_reduce, dt_groups, kernel_sy, kernel_sz);          // Initializing OpenCL kernel K_dt_reduce...
+  kernel_dt_control.push_back ("utilities.cl");                                                     // Setting 1st source file...
+  kernel_dt_control.push_back ("dt_control.cl");                                                    // Setting 2nd source file...
+  K_dt_control->init (bas, kernel_home, kernel_dt_control, 1, kernel_sy, kernel_sz);                // Initializing OpenCL kernel K_dt_control...
+  kernel_dt_broadcast.push_back ("utilities.cl");                                                   // Setting 1st source file...
+  kernel_dt_broadcast.push_back ("dt_broadcast.cl");                                                // Setting 2nd source file...
+  K_dt_broadcast->init (bas, kernel_home, kernel_dt_broadcast, kernel_sx, kernel_sy, kernel_sz);    // Initializing OpenCL kernel K_dt_broadcast...
+#endif
+
+  // TIME STEP KERNEL SEQUENCE:
+#if INTEGRATOR == BACKWARD_EULER
+  step_kernels.push_back (K1);                                                                      // Right hand side, preconditioner...
+  step_kernels.push_back (K5);                                                                      // Initial residual norm...
+  step_kernels.push_back (K6);                                                                      // Initial convergence check...
+  step_kernels.push_back (K7);                                                                      // Initial search direction...
+
+  cg_kernels.push_back (K3);                                                                        // Matrix product...
+  cg_kernels.push_back (K4);                                                                        // Step length...
+  cg_kernels.push_back (K5);                                                                        // Solution and residual update...
+  cg_kernels.push_back (K6);                                                                        // Direction factor, convergence check...
+  cg_kernels.push_back (K7);                                                                        // Search direction...
+  cg_start = step_kernels.size ();                                                                  // Setting CG iterations position...
+  step_kernels.push_back (K2);                                                                      // Velocity and position update...
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  step_kernels.push_back (K1);                                                                      // Residual force, trial velocity...
+  step_kernels.push_back (K3);                                                                      // Kinetic damping, convergence check...
+  step_kernels.push_back (K2);                                                                      // Position update or velocity reset...
+#else
+  step_kernels.push_back (K1);                                                                      // Setting 1st kernel of the time step...
+  step_kernels.push_back (K2);                                                                      // Setting 2nd kernel of the time step...
+#if PING_PONG
+  step_kernels.push_back (K1_pong);                                                                 // Setting 1st kernel of the next time step...
+  step_kernels.push_back (K2_pong);                                                                 // Setting 2nd kernel of the next time step...
+#endif
+#endif
+
+#if SLEEPING
+  step_kernels.push_back (K_sleep_mark);                                                            // Awake flags (after the update: fresh accelerations)...
+  step_kernels.push_back (K_sleep_scan);                                                            // Active set offsets...
+  step_kernels.push_back (K_sleep_scatter);                                                         // Active set compaction...
+#endif
+
+#if ADAPTIVE
+  step_kernels.push_back (K_dt_reduce);                                                             // Time step partial maxima...
+  step_kernels.push_back (K_dt_control);                                                            // Next time step...
+#if !UNIFORM
+  step_kernels.push_back (K_dt_broadcast);                                                          // Time step broadcast...
+#endif
+#endif
+
+  // Enqueueing one time step, waiting for its last kernel if requested. With BACKWARD_EULER the CG
+  // iterations are enqueued in chunks of CG_CHECK: the convergence flag is read back after each chunk
+  // and no further iteration is enqueued once it is set.
+  auto enqueue_step = [&] (bool wait)
+  {
+    for(step_kernel = 0; step_kernel < step_kernels.size (); step_kernel++)
+    {
+#if INTEGRATOR == BACKWARD_EULER
+      if(step_kernel == cg_start)
+      {
+        for(iteration = 0; iteration < CG_ITERATIONS; iteration++)
+        {
+          for(kernel* K : cg_kernels)
+          {
+            ctx->execute (K, Q, NU_DONT_WAIT);                                                      // Enqueueing CG iteration kernel...
+          }
+
+          if(((iteration + 1)%CG_CHECK == 0) && ((iteration + 1) < CG_ITERATIONS))
+          {
+            Q->read (scalars, 21);                                                                  // Reading CG scalars from queue...
+
+            if(scalars->data[4] > 0.0f)                                                             // Checking convergence ("CG_DONE")...
+            {
+              break;                                                                                // Skipping the remaining iterations...
+            }
+          }
+        }
+      }
+
+#endif
+      if(wait && (step_kernel == step_kernels.size () - 1))
+      {
+        ctx->execute (step_kernels[step_kernel], Q, NU_WAIT);                                       // Executing last OpenCL kernel...
+      }
+      else
+      {
+        ctx->execute (step_kernels[step_kernel], Q, NU_DONT_WAIT);                                  // Enqueueing OpenCL kernel...
+      }
+    }
+  };
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////// SETTING OPENCL KERNEL ARGUMENTS /////////////////////////////////
@@ -403,12 +1174,14 @@ int main ()
   K1->setarg (resting, 9);                                                                          // Setting resting position kernel argument...
   K1->setarg (friction, 10);                                                                        // Setting friction kernel argument...
   K1->setarg (mass, 11);                                                                            // Setting mass kernel argument...
-  K1->setarg (index_R, 12);                                                                         // Setting right neighbour index kernel argument...
-  K1->setarg (index_U, 13);                                                                         // Setting up neighbour index kernel argument...
-  K1->setarg (index_L, 14);                                                                         // Setting left neighbour index kernel argument...
-  K1->setarg (index_D, 15);                                                                         // Setting down neighbour index kernel argument...
-  K1->setarg (freedom, 16);                                                                         // Setting freedom flag kernel argument...
-  K1->setarg (dt, 17);                                                                              // Setting time step kernel argument...
+#if STENCIL
+  K1->setarg (freedom, 12);                                                                         // Setting freedom flag kernel argument...
+  K1->setarg (dt, 13);                                                                              // Setting time step kernel argument...
+#else
+  K1->setarg (neighbour, 12);                                                                       // Setting packed neighbour indexes kernel argument...
+  K1->setarg (freedom, 13);                                                                         // Setting freedom flag kernel argument...
+  K1->setarg (dt, 14);                                                                              // Setting time step kernel argument...
+#endif
 
   K2->setarg (position, 0);                                                                         // Setting position kernel argument...
   K2->setarg (depth, 1);                                                                            // Setting depth kernel argument...
@@ -422,19 +1195,227 @@ int main ()
   K2->setarg (resting, 9);                                                                          // Setting resting position kernel argument...
   K2->setarg (friction, 10);                                                                        // Setting friction kernel argument...
   K2->setarg (mass, 11);                                                                            // Setting mass kernel argument...
-  K2->setarg (index_R, 12);                                                                         // Setting right neighbour index kernel argument...
-  K2->setarg (index_U, 13);                                                                         // Setting up neighbour index kernel argument...
-  K2->setarg (index_L, 14);                                                                         // Setting left neighbour index kernel argument...
-  K2->setarg (index_D, 15);                                                                         // Setting down neighbour index kernel argument...
-  K2->setarg (freedom, 16);                                                                         // Setting freedom flag kernel argument...
-  K2->setarg (dt, 17);                                                                              // Setting time step kernel argument...
+#if STENCIL
+  K2->setarg (freedom, 12);                                                                         // Setting freedom flag kernel argument...
+  K2->setarg (dt, 13);                                                                              // Setting time step kernel argument...
+#else
+  K2->setarg (neighbour, 12);                                                                       // Setting packed neighbour indexes kernel argument...
+  K2->setarg (freedom, 13);                                                                         // Setting freedom flag kernel argument...
+  K2->setarg (dt, 14);                                                                              // Setting time step kernel argument...
+#endif
 
+#if PING_PONG
+  // Same arguments as K1/K2: the position buffers are swapped in the kernel sources (pong.cl)...
+  for(kernel* K : {K1_pong, K2_pong})
+  {
+    K->setarg (position, 0);                                                                        // Setting position kernel argument...
+    K->setarg (depth, 1);                                                                           // Setting depth kernel argument...
+    K->setarg (position_int, 2);                                                                    // Setting intermediate position kernel argument...
+    K->setarg (velocity, 3);                                                                        // Setting velocity kernel argument...
+    K->setarg (velocity_int, 4);                                                                    // Setting intermediate velocity kernel argument...
+    K->setarg (acceleration, 5);                                                                    // Setting acceleration kernel argument...
+    K->setarg (acceleration_int, 6);                                                                // Setting intermediate acceleration kernel argument...
+    K->setarg (gravity, 7);                                                                         // Setting gravity kernel argument...
+    K->setarg (stiffness, 8);                                                                       // Setting stiffness kernel argument...
+    K->setarg (resting, 9);                                                                         // Setting resting position kernel argument...
+    K->setarg (friction, 10);                                                                       // Setting friction kernel argument...
+    K->setarg (mass, 11);                                                                           // Setting mass kernel argument...
+#if STENCIL
+    K->setarg (freedom, 12);                                                                        // Setting freedom flag kernel argument...
+    K->setarg (dt, 13);                                                                             // Setting time step kernel argument...
+#else
+    K->setarg (neighbour, 12);                                                                      // Setting packed neighbour indexes kernel argument...
+    K->setarg (freedom, 13);                                                                        // Setting freedom flag kernel argument...
+    K->setarg (dt, 14);                                                                             // Setting time step kernel argument...
+#endif
+  }
+#endif
+
+#if SLEEPING
+  for(bucket = 1; bucket < SLEEP_BUCKETS; bucket++)
+  {
+    for(kernel* K : {K1_bucket[bucket], K2_bucket[bucket]})
+    {
+      K->setarg (position, 0);                                                                      // Setting position kernel argument...
+      K->setarg (depth, 1);                                                                         // Setting depth kernel argument...
+      K->setarg (position_int, 2);                                                                  // Setting intermediate position kernel argument...
+      K->setarg (velocity, 3);                                                                      // Setting velocity kernel argument...
+      K->setarg (velocity_int, 4);                                                                  // Setting intermediate velocity kernel argument...
+      K->setarg (acceleration, 5);                                                                  // Setting acceleration kernel argument...
+      K->setarg (acceleration_int, 6);                                                              // Setting intermediate acceleration kernel argument...
+      K->setarg (gravity, 7);                                                                       // Setting gravity kernel argument...
+      K->setarg (stiffness, 8);                                                                     // Setting stiffness kernel argument...
+      K->setarg (resting, 9);                                                                       // Setting resting position kernel argument...
+      K->setarg (friction, 10);                                                                     // Setting friction kernel argument...
+      K->setarg (mass, 11);                                                                         // Setting mass kernel argument...
+      K->setarg (neighbour, 12);                                                                    // Setting packed neighbour indexes kernel argument...
+      K->setarg (freedom, 13);                                                                      // Setting freedom flag kernel argument...
+      K->setarg (dt, 14);                                                                           // Setting time step kernel argument...
+    }
+  }
+
+  for(bucket = 0; bucket < SLEEP_BUCKETS; bucket++)
+  {
+    for(kernel* K : {K1_bucket[bucket], K2_bucket[bucket]})
+    {
+      K->setarg (active, 15);                                                                       // Setting active node indexes kernel argument...
+      K->setarg (active_count, 16);                                                                 // Setting # of active nodes kernel argument...
+    }
+  }
+
+  for(kernel* K : {K_sleep_mark, K_sleep_scan, K_sleep_scatter})
+  {
+    K->setarg (position, 0);                                                                        // Setting position kernel argument...
+    K->setarg (depth, 1);                                                                           // Setting depth kernel argument...
+    K->setarg (position_int, 2);                                                                    // Setting intermediate position kernel argument...
+    K->setarg (velocity, 3);                                                                        // Setting velocity kernel argument...
+    K->setarg (velocity_int, 4);                                                                    // Setting intermediate velocity kernel argument...
+    K->setarg (acceleration, 5);                                                                    // Setting acceleration kernel argument...
+    K->setarg (acceleration_int, 6);                                                                // Setting intermediate acceleration kernel argument...
+    K->setarg (gravity, 7);                                                                         // Setting gravity kernel argument...
+    K->setarg (stiffness, 8);                                                                       // Setting stiffness kernel argument...
+    K->setarg (resting, 9);                                                                         // Setting resting position kernel argument...
+    K->setarg (friction, 10);                                                                       // Setting friction kernel argument...
+    K->setarg (mass, 11);                                                                           // Setting mass kernel argument...
+    K->setarg (neighbour, 12);                                                                      // Setting packed neighbour indexes kernel argument...
+    K->setarg (freedom, 13);                                                                        // Setting freedom flag kernel argument...
+    K->setarg (dt, 14);                                                                             // Setting time step kernel argument...
+    K->setarg (active, 15);                                                                         // Setting active node indexes kernel argument...
+    K->setarg (active_count, 16);                                                                   // Setting # of active nodes kernel argument...
+    K->setarg (awake, 17);                                                                          // Setting awake flag kernel argument...
+    K->setarg (sleep_count, 18);                                                                    // Setting awake nodes per work-item kernel argument...
+    K->setarg (sleep_limits, 19);                                                                   // Setting sleeping thresholds kernel argument...
+  }
+  bucket = 0;                                                                                       // Starting with the full launch size...
+#endif
+#if INTEGRATOR == BACKWARD_EULER
+  for(kernel* K : {K3, K4, K5, K6, K7})
+  {
+    K->setarg (position, 0);                                                                        // Setting position kernel argument...
+    K->setarg (depth, 1);                                                                           // Setting depth kernel argument...
+    K->setarg (position_int, 2);                                                                    // Setting intermediate position kernel argument...
+    K->setarg (velocity, 3);                                                                        // Setting velocity kernel argument...
+    K->setarg (velocity_int, 4);                                                                    // Setting intermediate velocity kernel argument...
+    K->setarg (acceleration, 5);                                                                    // Setting acceleration kernel argument...
+    K->setarg (acceleration_int, 6);                                                                // Setting intermediate acceleration kernel argument...
+    K->setarg (gravity, 7);                                                                         // Setting gravity kernel argument...
+    K->setarg (stiffness, 8);                                                                       // Setting stiffness kernel argument...
+    K->setarg (resting, 9);                                                                         // Setting resting position kernel argument...
+    K->setarg (friction, 10);                                                                       // Setting friction kernel argument...
+    K->setarg (mass, 11);                                                                           // Setting mass kernel argument...
+    K->setarg (neighbour, 12);                                                                      // Setting packed neighbour indexes kernel argument...
+    K->setarg (freedom, 13);                                                                        // Setting freedom flag kernel argument...
+    K->setarg (dt, 14);                                                                             // Setting time step kernel argument...
+  }
+
+  for(kernel* K : {K1, K2, K3, K4, K5, K6, K7})
+  {
+    K->setarg (solution, 15);                                                                       // Setting CG solution kernel argument...
+    K->setarg (residual, 16);                                                                       // Setting CG residual kernel argument...
+    K->setarg (direction, 17);                                                                      // Setting CG search direction kernel argument...
+    K->setarg (product, 18);                                                                        // Setting CG matrix product kernel argument...
+    K->setarg (preconditioner, 19);                                                                 // Setting CG preconditioner kernel argument...
+    K->setarg (partial, 20);                                                                        // Setting CG partial sums kernel argument...
+    K->setarg (scalars, 21);                                                                        // Setting CG scalars kernel argument...
+  }
+#endif
+
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  K3->setarg (position, 0);                                                                         // Setting position kernel argument...
+  K3->setarg (depth, 1);                                                                            // Setting depth kernel argument...
+  K3->setarg (position_int, 2);                                                                     // Setting intermediate position kernel argument...
+  K3->setarg (velocity, 3);                                                                         // Setting velocity kernel argument...
+  K3->setarg (velocity_int, 4);                                                                     // Setting intermediate velocity kernel argument...
+  K3->setarg (acceleration, 5);                                                                     // Setting acceleration kernel argument...
+  K3->setarg (acceleration_int, 6);                                                                 // Setting intermediate acceleration kernel argument...
+  K3->setarg (gravity, 7);                                                                          // Setting gravity kernel argument...
+  K3->setarg (stiffness, 8);                                                                        // Setting stiffness kernel argument...
+  K3->setarg (resting, 9);                                                                          // Setting resting position kernel argument...
+  K3->setarg (friction, 10);                                                                        // Setting friction kernel argument...
+  K3->setarg (mass, 11);                                                                            // Setting mass kernel argument...
+  K3->setarg (neighbour, 12);                                                                       // Setting packed neighbour indexes kernel argument...
+  K3->setarg (freedom, 13);                                                                         // Setting freedom flag kernel argument...
+  K3->setarg (dt, 14);                                                                              // Setting time step kernel argument...
+
+  for(kernel* K : {K1, K2, K3})
+  {
+    K->setarg (dr_partial, 15);                                                                     // Setting DR partial sums kernel argument...
+    K->setarg (dr_scalars, 16);                                                                     // Setting DR scalars kernel argument...
+  }
+#endif
+
+#if ADAPTIVE
+  for(kernel* K : {K_dt_reduce, K_dt_control, K_dt_broadcast})
+  {
+    K->setarg (position, 0);                                                                        // Setting position kernel argument...
+    K->setarg (depth, 1);                                                                           // Setting depth kernel argument...
+    K->setarg (position_int, 2);                                                                    // Setting intermediate position kernel argument...
+    K->setarg (velocity, 3);                                                                        // Setting velocity kernel argument...
+    K->setarg (velocity_int, 4);                                                                    // Setting intermediate velocity kernel argument...
+    K->setarg (acceleration, 5);                                                                    // Setting acceleration kernel argument...
+    K->setarg (acceleration_int, 6);                                                                // Setting intermediate acceleration kernel argument...
+    K->setarg (gravity, 7);                                                                         // Setting gravity kernel argument...
+    K->setarg (stiffness, 8);                                                                       // Setting stiffness kernel argument...
+    K->setarg (resting, 9);                                                                         // Setting resting position kernel argument...
+    K->setarg (friction, 10);                                                                       // Setting friction kernel argument...
+    K->setarg (mass, 11);                                                                           // Setting mass kernel argument...
+    K->setarg (neighbour, 12);                                                                      // Setting packed neighbour indexes kernel argument...
+    K->setarg (freedom, 13);                                                                        // Setting freedom flag kernel argument...
+    K->setarg (dt, 14);                                                                             // Setting time step kernel argument...
+    K->setarg (dt_partial, 15);                                                                     // Setting time step partial maxima kernel argument...
+    K->setarg (dt_limits, 16);                                                                      // Setting time step limits kernel argument...
+    K->setarg (elapsed, 17);                                                                        // Setting simulated time kernel argument...
+  }
+#endif
+
+#if DEVICE_INIT
+  K_init->setarg (position, 0);                                                                     // Setting position kernel argument...
+  K_init->setarg (depth, 1);                                                                        // Setting depth kernel argument...
+  K_init->setarg (position_int, 2);                                                                 // Setting intermediate position kernel argument...
+  K_init->setarg (velocity, 3);                                                                     // Setting velocity kernel argument...
+  K_init->setarg (velocity_int, 4);                                                                 // Setting intermediate velocity kernel argument...
+  K_init->setarg (acceleration, 5);                                                                 // Setting acceleration kernel argument...
+  K_init->setarg (acceleration_int, 6);                                                             // Setting intermediate acceleration kernel argument...
+  K_init->setarg (gravity, 7);                                                                      // Setting gravity kernel argument...
+  K_init->setarg (stiffness, 8);                                                                    // Setting stiffness kernel argument...
+  K_init->setarg (resting, 9);                                                                      // Setting resting position kernel argument...
+  K_init->setarg (friction, 10);                                                                    // Setting friction kernel argument...
+  K_init->setarg (mass, 11);                                                                        // Setting mass kernel argument...
+#if STENCIL
+  K_init->setarg (freedom, 12);                                                                     // Setting freedom flag kernel argument...
+  K_init->setarg (dt, 13);                                                                          // Setting time step kernel argument...
+  K_init->setarg (grid, 14);                                                                        // Setting grid generation scalars kernel argument...
+#else
+  K_init->setarg (neighbour, 12);                                                                   // Setting packed neighbour indexes kernel argument...
+  K_init->setarg (freedom, 13);                                                                     // Setting freedom flag kernel argument...
+  K_init->setarg (dt, 14);                                                                          // Setting time step kernel argument...
+  K_init->setarg (grid, 15);                                                                        // Setting grid generation scalars kernel argument...
+#endif
+#endif
+
+#if INTEROP
   position->name = "voxel_center";                                                                  // Setting variable name for OpenGL shader...
   depth->name    = "voxel_color";                                                                   // Setting variable name for OpenGL shader...
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   //////////////////////////////////// WRITING DATA ON OPENCL QUEUE //////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
+#if DEVICE_INIT
+  // Node arrays generated on the device by K_init: only the intermediate state and the scalars written...
+#if INTEROP
+  Q->write (position, 0);                                                                           // Writing position data (OpenGL buffer) on queue...
+  Q->write (depth, 1);                                                                              // Writing depth data (OpenGL buffer) on queue...
+#endif
+  Q->write (position_int, 2);                                                                       // Writing intermediate position data on queue...
+  Q->write (velocity_int, 4);                                                                       // Writing intermediate velocity data on queue...
+  Q->write (acceleration_int, 6);                                                                   // Writing intermediate acceleration data on queue...
+#if STENCIL
+  Q->write (grid, 14);                                                                              // Writing grid generation scalars on queue...
+#else
+  Q->write (grid, 15);                                                                              // Writing grid generation scalars on queue...
+#endif
+#else
   Q->write (position, 0);                                                                           // Writing position data on queue...
   Q->write (depth, 1);                                                                              // Writing depth data on queue...
   Q->write (position_int, 2);                                                                       // Writing intermediate position data on queue...
@@ -447,13 +1428,60 @@ int main ()
   Q->write (resting, 9);                                                                            // Writing resting position data on queue...
   Q->write (friction, 10);                                                                          // Writing friction data on queue...
   Q->write (mass, 11);                                                                              // Writing mass data on queue...
-  Q->write (index_R, 12);                                                                           // Writing right neighbour index on queue...
-  Q->write (index_U, 13);                                                                           // Writing up neighbour index on queue...
-  Q->write (index_L, 14);                                                                           // Writing left neighbour index on queue...
-  Q->write (index_D, 15);                                                                           // Writing down neighbour index on queue...
-  Q->write (freedom, 16);                                                                           // Writing freedom flag data on queue...
-  Q->write (dt, 17);                                                                                // Writing time step data on queue...
+#if STENCIL
+  Q->write (freedom, 12);                                                                           // Writing freedom flag data on queue...
+  Q->write (dt, 13);                                                                                // Writing time step data on queue...
+#else
+  Q->write (neighbour, 12);                                                                         // Writing packed neighbour indexes on queue...
+  Q->write (freedom, 13);                                                                           // Writing freedom flag data on queue...
+  Q->write (dt, 14);                                                                                // Writing time step data on queue...
+#endif
+#endif
+
+#if INTEGRATOR == BACKWARD_EULER
+  Q->write (solution, 15);                                                                          // Writing CG solution data on queue...
+  Q->write (residual, 16);                                                                          // Writing CG residual data on queue...
+  Q->write (direction, 17);                                                                         // Writing CG search direction data on queue...
+  Q->write (product, 18);                                                                           // Writing CG matrix product data on queue...
+  Q->write (preconditioner, 19);                                                                    // Writing CG preconditioner data on queue...
+  Q->write (partial, 20);                                                                           // Writing CG partial sums on queue...
+  Q->write (scalars, 21);                                                                           // Writing CG scalars on queue...
+#endif
+
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  Q->write (dr_partial, 15);                                                                        // Writing DR partial sums on queue...
+  Q->write (dr_scalars, 16);                                                                        // Writing DR scalars on queue...
+#endif
+#if SLEEPING
+  Q->write (active, 15);                                                                            // Writing active node indexes on queue...
+  Q->write (active_count, 16);                                                                      // Writing # of active nodes on queue...
+  Q->write (awake, 17);                                                                             // Writing awake flags on queue...
+  Q->write (sleep_count, 18);                                                                       // Writing awake nodes per work-item on queue...
+  Q->write (sleep_limits, 19);                                                                      // Writing sleeping thresholds on queue...
+#endif
+
+#if ADAPTIVE
+  Q->write (dt_partial, 15);                                                                        // Writing time step partial maxima on queue...
+  Q->write (dt_limits, 16);                                                                         // Writing time step limits on queue...
+  Q->write (elapsed, 17);                                                                           // Writing simulated time on queue...
+#endif
+
+#if DEVICE_INIT
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////// DEVICE GRID GENERATION //////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+#if INTEROP
+  Q->acquire (position, 0);                                                                         // Acquiring OpenGL/CL shared argument...
+  Q->acquire (depth, 1);                                                                            // Acquiring OpenGL/CL shared argument...
+#endif
+  ctx->execute (K_init, Q, NU_WAIT);                                                                // Generating the grid on the device...
+#if INTEROP
+  Q->release (position, 0);                                                                         // Releasing OpenGL/CL shared argument...
+  Q->release (depth, 1);                                                                            // Releasing OpenGL/CL shared argument...
+#endif
 
+#endif
+#if INTEROP
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////// SETTING OPENGL SHADER ARGUMENTS ////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -473,8 +1501,15 @@ int main ()
 
     Q->acquire (position, 0);                                                                       // Acquiring OpenGL/CL shared argument...
     Q->acquire (depth, 1);                                                                          // Acquiring OpenGL/CL shared argument...
-    ctx->execute (K1, Q, NU_WAIT);                                                                  // Executing OpenCL kernel...
-    ctx->execute (K2, Q, NU_WAIT);                                                                  // Executing OpenCL kernel...
+
+    // Enqueueing all substeps back to back, waiting only for the last one:
+    for(substep = 0; substep < SUBSTEPS - 1; substep++)
+    {
+      enqueue_step (false);                                                                         // Enqueueing time step...
+    }
+
+    enqueue_step (true);                                                                            // Executing last time step...
+
     Q->release (position, 0);                                                                       // Releasing OpenGL/CL shared argument...
     Q->release (depth, 1);                                                                          // Releasing OpenGL/CL shared argument...
 
@@ -500,17 +1535,242 @@ int main ()
 
     gui->refresh ();                                                                                // Refreshing gui...
 
-    simulation_time += dt_simulation;                                                               // Updating simulation time [s]...
-    time_step_index++;                                                                              // Updating time step index [#]...
+#if INTEGRATOR == DYNAMIC_RELAXATION
+    if(!relaxed)
+    {
+      Q->read (dr_scalars, 16);                                                                     // Reading DR scalars from queue...
+      relaxed = (dr_scalars->data[3] > 0.0f);                                                       // Checking convergence ("DR_DONE")...
+
+      if(relaxed)
+      {
+        std::cout << "Static equilibrium reached after " << dr_scalars->data[4] << " relaxation steps"
+                  << " (relative residual force = " << dr_scalars->data[2] << ")" << std::endl;
+      }
+    }
+
+#endif
+#if ADAPTIVE
+    Q->read (elapsed, 17);                                                                          // Reading simulated time (single scalar) from queue...
+    simulation_time = elapsed->data[0];                                                             // Updating simulation time [s]...
+#else
+    simulation_time += SUBSTEPS*SEQUENCE_STEPS*dt_simulation;                                       // Updating simulation time [s]...
+#endif
+    time_step_index += SUBSTEPS*SEQUENCE_STEPS;                                                     // Updating time step index [#]...
+
+#if SLEEPING
+    Q->read (active_count, 16);                                                                     // Reading # of active nodes (single scalar) from queue...
+    active_nodes = active_count->data[0];                                                           // Setting # of active nodes [#]...
+    bucket       = SLEEP_BUCKETS - 1;                                                               // Starting from the smallest launch size...
+
+    // Keeping room for the waking front, which grows by one neighbour ring per time step (the kernels
+    // loop over any active nodes beyond the launch size, hence this only balances the work-items):
+    while((bucket > 0) && (bucket_size[bucket] < 2*active_nodes))
+    {
+      bucket--;                                                                                     // Doubling launch size...
+    }
+
+    step_kernels[0] = K1_bucket[bucket];                                                            // Setting 1st kernel of the time step...
+    step_kernels[1] = K2_bucket[bucket];                                                            // Setting 2nd kernel of the time step...
+#endif
 
     bas->get_toc ();                                                                                // Getting "toc" [us]...
   }
 
+#else
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////// BATCH LOOP ////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  std::cout << "Running " << steps << " time steps (headless)..." << std::endl;                     // Printing message...
+
+  auto tic = std::chrono::steady_clock::now ();                                                     // Getting "tic"...
+
+#if ADAPTIVE
+  while((time_step_index < (int)steps) && ((time_max <= 0.0f) || (simulation_time < time_max)))
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  while((time_step_index < (int)steps) && !relaxed)
+#else
+  while(time_step_index < (int)steps)
+#endif
+  {
+    // Enqueueing up to SUBSTEPS time steps back to back, waiting only for the last one:
+    for(substep = 0; (substep < SUBSTEPS - 1) && (time_step_index < (int)steps - SEQUENCE_STEPS); substep++)
+    {
+      enqueue_step (false);                                                                         // Enqueueing time step...
+
+#if !ADAPTIVE
+      simulation_time += SEQUENCE_STEPS*dt_simulation;                                              // Updating simulation time [s]...
+#endif
+      time_step_index += SEQUENCE_STEPS;                                                            // Updating time step index [#]...
+    }
+
+    enqueue_step (true);                                                                            // Executing last time step...
+
+#if ADAPTIVE
+    Q->read (elapsed, 17);                                                                          // Reading simulated time (single scalar) from queue...
+    simulation_time = elapsed->data[0];                                                             // Updating simulation time [s]...
+#else
+    simulation_time += SEQUENCE_STEPS*dt_simulation;                                                // Updating simulation time [s]...
+#endif
+    time_step_index += SEQUENCE_STEPS;                                                              // Updating time step index [#]...
+
+#if INTEGRATOR == DYNAMIC_RELAXATION
+    Q->read (dr_scalars, 16);                                                                       // Reading DR scalars from queue...
+    relaxed = (dr_scalars->data[3] > 0.0f);                                                         // Checking convergence ("DR_DONE")...
+#endif
+#if SLEEPING
+    active_updates += (substep + 1)*(double)active_nodes;                                           // Accumulating # of active node updates...
+    Q->read (active_count, 16);                                                                     // Reading # of active nodes (single scalar) from queue...
+    active_nodes = active_count->data[0];                                                           // Setting # of active nodes [#]...
+    bucket       = SLEEP_BUCKETS - 1;                                                               // Starting from the smallest launch size...
+
+    // Keeping room for the waking front, which grows by one neighbour ring per time step (the kernels
+    // loop over any active nodes beyond the launch size, hence this only balances the work-items):
+    while((bucket > 0) && (bucket_size[bucket] < 2*active_nodes))
+    {
+      bucket--;                                                                                     // Doubling launch size...
+    }
+
+    step_kernels[0] = K1_bucket[bucket];                                                            // Setting 1st kernel of the time step...
+    step_kernels[1] = K2_bucket[bucket];                                                            // Setting 2nd kernel of the time step...
+#endif
+  }
+
+  auto toc = std::chrono::steady_clock::now ();                                                     // Getting "toc"...
+  wall_time = std::chrono::duration<double>(toc - tic).count ();                                    // Computing wall clock time [s]...
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////// FINAL STATISTICS ////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  Q->read (position, 0);                                                                            // Reading position data from queue...
+  Q->read (velocity, 3);                                                                            // Reading velocity data from queue...
+
+  z_min          = +INFINITY;                                                                       // Resetting minimum "z" position [m]...
+  z_max          = -INFINITY;                                                                       // Resetting maximum "z" position [m]...
+  v_max          = 0.0f;                                                                            // Resetting maximum speed [m/s]...
+  z_mean         = 0.0;                                                                             // Resetting mean "z" position [m]...
+  kinetic_energy = 0.0;                                                                             // Resetting kinetic energy [J]...
+  non_finite     = 0;                                                                               // Resetting # of non-finite nodes...
+
+  for(gid = 0; gid < nodes; gid++)
+  {
+#if PACKED
+    v_norm = sqrt (
+                   pow (velocity->data[3*gid + 0], 2) +
+                   pow (velocity->data[3*gid + 1], 2) +
+                   pow (velocity->data[3*gid + 2], 2)
+                  );                                                                                // Computing node speed [m/s]...
+#else
+    v_norm = sqrt (
+                   pow (velocity->data[gid].x, 2) +
+                   pow (velocity->data[gid].y, 2) +
+                   pow (velocity->data[gid].z, 2)
+                  );                                                                                // Computing node speed [m/s]...
+#endif
+
+    if(!std::isfinite (position->data[gid].z) || !std::isfinite (v_norm))
+    {
+      non_finite++;                                                                                 // Counting non-finite node...
+      continue;
+    }
+
+    z_min           = fmin (z_min, position->data[gid].z);                                          // Updating minimum "z" position [m]...
+    z_max           = fmax (z_max, position->data[gid].z);                                          // Updating maximum "z" position [m]...
+    v_max           = fmax (v_max, v_norm);                                                         // Updating maximum speed [m/s]...
+    z_mean         += position->data[gid].z;                                                        // Accumulating "z" position [m]...
+    kinetic_energy += 0.5*mass->data[PARAM(gid)].x*v_norm*v_norm;                                   // Accumulating kinetic energy [J]...
+  }
+
+  z_mean /= (nodes - non_finite > 0) ? (nodes - non_finite) : 1;                                    // Averaging "z" position [m]...
+
+  std::cout << "Time steps = " << time_step_index << "[#]" << std::endl;
+  std::cout << "Simulated time = " << simulation_time << "[s]" << std::endl;
+  std::cout << "Wall clock time = " << wall_time << "[s]" << std::endl;
+  std::cout << "Throughput = " << time_step_index/wall_time << "[steps/s]" << std::endl;
+  std::cout << "Node updates = " << time_step_index*nodes/wall_time << "[nodes/s]" << std::endl;
+  std::cout << "z (min, mean, max) = " << z_min << ", " << z_mean << ", " << z_max << "[m]" << std::endl;
+  std::cout << "Maximum speed = " << v_max << "[m/s]" << std::endl;
+  std::cout << "Kinetic energy = " << kinetic_energy << "[J]" << std::endl;
+  std::cout << "Non-finite nodes = " << non_finite << "[#]" << std::endl;
+
+#if ADAPTIVE
+  std::cout << "Mean time step = " << simulation_time/time_step_index << "[s]" << std::endl;
+#endif
+
+#if SLEEPING
+  std::cout << "Active node updates = " << active_updates/((double)time_step_index*nodes)*100.0 << "[%]" << std::endl;
+  std::cout << "Active nodes (last time step) = " << active_nodes << "[#]" << std::endl;
+#endif
+
+#if INTEGRATOR == BACKWARD_EULER
+  Q->read (scalars, 21);                                                                            // Reading CG scalars from queue...
+  std::cout << "CG iterations (last time step) = " << scalars->data[6] << "[#]" << std::endl;
+  std::cout << "CG relative residual (last time step) = "
+            << ((scalars->data[1] > 0.0f) ? sqrt (scalars->data[0]/scalars->data[1]) : 0.0f) << std::endl;
+#endif
+
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  std::cout << "Relaxation steps = " << dr_scalars->data[4] << "[#]" << std::endl;
+  std::cout << "Kinetic energy peaks = " << dr_scalars->data[5] << "[#]" << std::endl;
+  std::cout << "Relative residual force = " << dr_scalars->data[2] << std::endl;
+
+  if(!relaxed)
+  {
+    std::cout << "Static equilibrium not reached: increase --steps." << std::endl;
+  }
+#endif
+
+  // SAVING FINAL POSITIONS (e.g. as a reference for other integrators or precisions):
+  if(!save_file.empty ())
+  {
+    std::ofstream output (save_file);                                                               // Final positions output file.
+    output.precision (9);                                                                           // Setting float round-trip precision...
+
+    for(gid = 0; gid < nodes; gid++)
+    {
+      output << position->data[gid].x << " " << position->data[gid].y << " " << position->data[gid].z << "\n";
+    }
+
+    std::cout << "Final positions saved in " << save_file << std::endl;
+  }
+
+  // COMPARING FINAL POSITIONS WITH A REFERENCE RUN:
+  if(!compare_file.empty ())
+  {
+    std::ifstream reference (compare_file);                                                         // Reference positions input file.
+    error_max = 0.0f;                                                                               // Resetting maximum position error [m]...
+    error_rms = 0.0;                                                                                // Resetting RMS position error [m]...
+
+    for(gid = 0; (gid < nodes) && (reference >> x_ref >> y_ref >> z_ref); gid++)
+    {
+      error      = sqrt (
+                         pow (position->data[gid].x - x_ref, 2) +
+                         pow (position->data[gid].y - y_ref, 2) +
+                         pow (position->data[gid].z - z_ref, 2)
+                        );                                                                          // Computing position error [m]...
+      error_max  = fmax (error_max, error);                                                         // Updating maximum position error [m]...
+      error_rms += error*error;                                                                     // Accumulating squared position error [m^2]...
+    }
+
+    if(gid != nodes)
+    {
+      std::cerr << "Error: " << compare_file << " does not contain " << nodes << " nodes." << std::endl;
+      compare_error = true;                                                                         // Failing after the cleanup...
+    }
+    else
+    {
+      error_rms = sqrt (error_rms/nodes);                                                           // Computing RMS position error [m]...
+      std::cout << "Position error vs " << compare_file << " (max, RMS) = " << error_max << ", " << error_rms << "[m]" << std::endl;
+    }
+  }
+#endif
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////// CLEANUP ////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   delete bas;                                                                                       // Deleting Neutrino baseline...
+#if INTEROP
   delete gui;                                                                                       // Deleting OpenGL gui...
+#endif
   delete ctx;                                                                                       // Deleting OpenCL context...
 
   delete position;                                                                                  // Deleting position data...
@@ -522,23 +1782,92 @@ int main ()
   delete velocity_int;                                                                              // Deleting intermediate velocity data...
   delete acceleration_int;                                                                          // Deleting intermediate acceleration data...
 
+#if INTEGRATOR == BACKWARD_EULER
+  delete solution;                                                                                  // Deleting CG solution data...
+  delete residual;                                                                                  // Deleting CG residual data...
+  delete direction;                                                                                 // Deleting CG search direction data...
+  delete product;                                                                                   // Deleting CG matrix product data...
+  delete preconditioner;                                                                            // Deleting CG preconditioner data...
+  delete partial;                                                                                   // Deleting CG partial sums...
+  delete scalars;                                                                                   // Deleting CG scalars...
+#endif
+
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  delete dr_partial;                                                                                // Deleting DR partial sums...
+  delete dr_scalars;                                                                                // Deleting DR scalars...
+#endif
+
   delete gravity;                                                                                   // Deleting gravity data...
   delete stiffness;                                                                                 // Deleting stiffness data...
   delete resting;                                                                                   // Deleting resting data...
   delete friction;                                                                                  // Deleting friction data...
   delete mass;                                                                                      // Deleting mass data...
 
-  delete index_R;                                                                                   // Deleting right neighbour index...
-  delete index_U;                                                                                   // Deleting up neighbour index...
-  delete index_L;                                                                                   // Deleting left neighbour index...
-  delete index_D;                                                                                   // Deleting down neighbour index...
+#if !STENCIL
+  delete neighbour;                                                                                 // Deleting packed neighbour indexes...
+#endif
 
   delete freedom;                                                                                   // Deleting freedom flag data...
   delete dt;                                                                                        // Deleting time step data...
+#if DEVICE_INIT
+  delete grid;                                                                                      // Deleting grid generation scalars...
+#endif
+#if SLEEPING
+  delete active;                                                                                    // Deleting active node indexes...
+  delete active_count;                                                                              // Deleting # of active nodes...
+  delete awake;                                                                                     // Deleting awake flags...
+  delete sleep_count;                                                                               // Deleting awake nodes per work-item...
+  delete sleep_limits;                                                                              // Deleting sleeping thresholds...
+#endif
+#if ADAPTIVE
+  delete dt_partial;                                                                                // Deleting time step partial maxima...
+  delete dt_limits;                                                                                 // Deleting time step limits...
+  delete elapsed;                                                                                   // Deleting simulated time...
+#endif
 
   delete Q;                                                                                         // Deleting OpenCL queue...
   delete K1;                                                                                        // Deleting OpenCL kernel...
   delete K2;                                                                                        // Deleting OpenCL kernel...
+#if DEVICE_INIT
+  delete K_init;                                                                                    // Deleting OpenCL kernel...
+#endif
+#if PING_PONG
+  delete K1_pong;                                                                                   // Deleting OpenCL kernel...
+  delete K2_pong;                                                                                   // Deleting OpenCL kernel...
+#endif
+#if INTEGRATOR == BACKWARD_EULER
+  delete K3;                                                                                        // Deleting OpenCL kernel...
+  delete K4;                                                                                        // Deleting OpenCL kernel...
+  delete K5;                                                                                        // Deleting OpenCL kernel...
+  delete K6;                                                                                        // Deleting OpenCL kernel...
+  delete K7;                                                                                        // Deleting OpenCL kernel...
+#endif
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  delete K3;                                                                                        // Deleting OpenCL kernel...
+#endif
+#if SLEEPING
+  for(bucket = 1; bucket < SLEEP_BUCKETS; bucket++)
+  {
+    delete K1_bucket[bucket];                                                                       // Deleting OpenCL kernel...
+    delete K2_bucket[bucket];                                                                       // Deleting OpenCL kernel...
+  }
+
+  delete K_sleep_mark;                                                                              // Deleting OpenCL kernel...
+  delete K_sleep_scan;                                                                              // Deleting OpenCL kernel...
+  delete K_sleep_scatter;                                                                           // Deleting OpenCL kernel...
+#endif
+#if ADAPTIVE
+  delete K_dt_reduce;                                                                               // Deleting OpenCL kernel...
+  delete K_dt_control;                                                                              // Deleting OpenCL kernel...
+  delete K_dt_broadcast;                                                                            // Deleting OpenCL kernel...
+#endif
+
+#if !INTEROP
+  if((non_finite > 0) || compare_error)
+  {
+    return 1;                                                                                       // Signalling diverged simulation or bad reference to batch jobs...
+  }
+#endif
 
   return 0;
 }
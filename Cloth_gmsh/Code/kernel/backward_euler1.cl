@@ -0,0 +1,109 @@
+/// @file
+
+// Backward Euler, 1st kernel: right hand side and Jacobi preconditioner of the linear system
+// (m + dt*B - dt^2*K)*dv = dt*(F_n + dt*K*v_n), solved for the velocity increment "dv"
+// by the conjugate gradient kernels (cg_*.cl). "K" is the stiffness matrix d(F)/d(p), never assembled.
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    solution,                           // CG solution (velocity increment).
+                        __global float4*    residual,                           // CG residual.
+                        __global float4*    direction,                          // CG search direction.
+                        __global float4*    product,                            // CG system matrix times search direction.
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner.
+                        __global float*     partial,                            // CG partial sums.
+                        __global float*     scalars)                            // CG scalars.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long i = get_global_id(0);                                           // Global index [#].
+  unsigned long j = 0;                                                          // Neighbour stride index.
+  unsigned long j_min = 0;                                                      // Neighbour stride minimun index.
+  unsigned long j_max = offset[i];                                              // Neighbour stride maximum index.
+  unsigned long k = 0;                                                          // Neighbour tuple index.
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////// CELL VARIABLES //////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        p                 = position[i];                                // Central node position.
+  float4        v                 = velocity[i];                                // Central node velocity.
+  float         m                 = mass[i];                                    // Central node mass.
+  float4        g                 = gravity[0];                                 // Central node gravity field.
+  float         B                 = friction[0];                                // Central node friction.
+  float         fr                = freedom[i];                                 // Central node freedom flag.
+  float4        Fe                = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Central node elastic force.
+  float4        F                 = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Central node total force.
+  float4        Kv                = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Stiffness matrix times velocity.
+  float4        Kd                = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Stiffness matrix diagonal.
+  float4        b                 = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Right hand side.
+  float4        M                 = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Inverse Jacobi preconditioner.
+  float4        link              = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Neighbour link.
+  float         R                 = 0.0f;                                       // Neighbour link resting length.
+  float         K                 = 0.0f;                                       // Neighbour link stiffness.
+  float         L                 = 0.0f;                                       // Neighbour link length.
+  float         dt                = dt_simulation[0];                           // Simulation time step [s].
+
+  // COMPUTING STRIDE MINIMUM INDEX:
+  if (i == 0)
+  {
+    j_min = 0;                                                                  // Setting stride minimum (first stride)...
+  }
+  else
+  {
+    j_min = offset[i - 1];                                                      // Setting stride minimum (all others)...
+  }
+
+  // COMPUTING ELASTIC FORCE AND STIFFNESS MATRIX TERMS:
+  for (j = j_min; j < j_max; j++)
+  {
+    k = nearest[j];                                                             // Computing neighbour index...
+    link = position[k] - p;                                                     // Getting neighbour link vector...
+    R = resting[j];                                                             // Getting neighbour link resting length...
+    K = stiffness[j];                                                           // Getting neighbour link stiffness...
+    L = length(link);                                                           // Computing neighbour link length...
+    Fe += K*(L - R)*normalize(link);                                            // Building up elastic force on central node...
+    Kv += link_jacobian(link, R, K, velocity[k] - v);                           // Building up stiffness matrix times velocity...
+    Kd += link_jacobian_diagonal(link, R, K);                                   // Building up stiffness matrix diagonal...
+  }
+
+  // COMPUTING TOTAL FORCE:
+  F = m*g + Fe - B*v;                                                           // Computing total node force...
+
+  // COMPUTING RIGHT HAND SIDE (constrained nodes have no increment):
+  b = fr*dt*(F + dt*Kv);                                                        // Computing right hand side...
+  b.w = 0.0f;                                                                   // Adjusting projective space...
+
+  // COMPUTING INVERSE JACOBI PRECONDITIONER:
+  M = fr/(m + dt*B + dt*dt*Kd);                                                 // Computing inverse diagonal...
+  M.w = 0.0f;                                                                   // Adjusting projective space...
+
+  // INITIALIZING CONJUGATE GRADIENT (dv = 0, search direction reset by the 1st "cg_direction"):
+  solution[i] = (float4)(0.0f, 0.0f, 0.0f, 0.0f);                               // Initializing solution...
+  residual[i] = b;                                                              // Initializing residual...
+  direction[i] = (float4)(0.0f, 0.0f, 0.0f, 0.0f);                              // Initializing search direction...
+  product[i] = (float4)(0.0f, 0.0f, 0.0f, 0.0f);                                // Initializing matrix product...
+  preconditioner[i] = M;                                                        // Setting preconditioner...
+
+  if(i == 0)
+  {
+    scalars[CG_RZ] = 1.0f;                                                      // Resetting residual norm...
+    scalars[CG_RZ0] = -1.0f;                                                    // Resetting initial residual norm...
+    scalars[CG_ALPHA] = 0.0f;                                                   // Resetting step length...
+    scalars[CG_BETA] = 0.0f;                                                    // Resetting direction update factor...
+    scalars[CG_DONE] = 0.0f;                                                    // Resetting convergence flag...
+    scalars[CG_ITER] = 0.0f;                                                    // Resetting # of iterations...
+  }
+}
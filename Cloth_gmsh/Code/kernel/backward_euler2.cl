@@ -0,0 +1,57 @@
+/// @file
+
+// Backward Euler, 2nd kernel: v_(n+1) = v_n + dv and p_(n+1) = p_n + dt*v_(n+1), with the velocity
+// increment "dv" solved by the conjugate gradient kernels.
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    solution,                           // CG solution (velocity increment).
+                        __global float4*    residual,                           // CG residual.
+                        __global float4*    direction,                          // CG search direction.
+                        __global float4*    product,                            // CG system matrix times search direction.
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner.
+                        __global float*     partial,                            // CG partial sums.
+                        __global float*     scalars)                            // CG scalars.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long i = get_global_id(0);                                           // Global index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////// CELL VARIABLES //////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        p                 = position[i];                                // Central node position.
+  float4        v                 = velocity[i];                                // Central node velocity.
+  float4        dv                = solution[i];                                // Central node velocity increment.
+  float4        a_new             = (float4)(0.0f, 0.0f, 0.0f, 1.0f);           // Central node acceleration (new).
+  float         fr                = freedom[i];                                 // Central node freedom flag.
+  float         dt                = dt_simulation[0];                           // Simulation time step [s].
+
+  // COMPUTING NEW VELOCITY AND POSITION:
+  a_new = dv/dt;                                                                // Computing acceleration...
+  v += fr*dv;                                                                   // Computing velocity...
+  p += fr*v*dt;                                                                 // Computing position...
+
+  // FIXING PROJECTIVE SPACE:
+  p.w = 1.0f;                                                                   // Adjusting projective space...
+  v.w = 1.0f;                                                                   // Adjusting projective space...
+  a_new.w = 1.0f;                                                               // Adjusting projective space...
+
+  // UPDATING KINEMATICS:
+  position[i] = p;                                                              // Updating position [m]...
+  velocity[i] = v;                                                              // Updating velocity [m/s]...
+  acceleration[i] = a_new;                                                      // Updating acceleration [m/s^2]...
+}
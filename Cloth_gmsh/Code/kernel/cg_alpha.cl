@@ -0,0 +1,56 @@
+/// @file
+
+// Conjugate gradient: step length alpha = (r*z)/(p*q), reducing the partial sums of "cg_matvec"
+// (single work-item).
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    solution,                           // CG solution (velocity increment).
+                        __global float4*    residual,                           // CG residual.
+                        __global float4*    direction,                          // CG search direction.
+                        __global float4*    product,                            // CG system matrix times search direction.
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner.
+                        __global float*     partial,                            // CG partial sums.
+                        __global float*     scalars)                            // CG scalars.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////// CONJUGATE GRADIENT: ALPHA //////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long groups = (unsigned long)scalars[CG_GROUPS];                     // Setting # of partial sums [#]...
+  unsigned long n;                                                              // Partial sum index [#].
+  float       pq = 0.0f;                                                        // Direction*product.
+
+  if(scalars[CG_DONE] != 0.0f)
+  {
+    return;                                                                     // Already converged.
+  }
+
+  for(n = 0; n < groups; n++)
+  {
+    pq += partial[n];                                                           // Reducing partial sums...
+  }
+
+  if(pq > 0.0f)
+  {
+    scalars[CG_ALPHA] = scalars[CG_RZ]/pq;                                      // Computing step length...
+    scalars[CG_ITER] += 1.0f;                                                   // Counting iterations...
+  }
+
+  else
+  {
+    scalars[CG_ALPHA] = 0.0f;                                                   // Null search direction: stopping...
+    scalars[CG_DONE] = 1.0f;                                                    // Setting convergence flag...
+  }
+}
@@ -0,0 +1,58 @@
+/// @file
+
+// Conjugate gradient: direction update factor beta = (r*z)_new/(r*z)_old, reducing the partial sums
+// of "cg_update", and convergence check on the relative preconditioned residual (single work-item).
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    solution,                           // CG solution (velocity increment).
+                        __global float4*    residual,                           // CG residual.
+                        __global float4*    direction,                          // CG search direction.
+                        __global float4*    product,                            // CG system matrix times search direction.
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner.
+                        __global float*     partial,                            // CG partial sums.
+                        __global float*     scalars)                            // CG scalars.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////// CONJUGATE GRADIENT: BETA ///////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long groups = (unsigned long)scalars[CG_GROUPS];                     // Setting # of partial sums [#]...
+  unsigned long n;                                                              // Partial sum index [#].
+  float       rz = 0.0f;                                                        // Residual*preconditioned residual.
+  float       tol = scalars[CG_TOL];                                            // Relative tolerance.
+
+  if(scalars[CG_DONE] != 0.0f)
+  {
+    return;                                                                     // Already converged.
+  }
+
+  for(n = 0; n < groups; n++)
+  {
+    rz += partial[n];                                                           // Reducing partial sums...
+  }
+
+  if(scalars[CG_RZ0] < 0.0f)
+  {
+    scalars[CG_RZ0] = rz;                                                       // Setting initial residual norm...
+  }
+
+  scalars[CG_BETA] = rz/scalars[CG_RZ];                                         // Computing direction update factor...
+  scalars[CG_RZ] = rz;                                                          // Updating residual norm...
+
+  if(rz <= tol*tol*scalars[CG_RZ0])
+  {
+    scalars[CG_DONE] = 1.0f;                                                    // Setting convergence flag...
+  }
+}
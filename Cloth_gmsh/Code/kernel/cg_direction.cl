@@ -0,0 +1,41 @@
+/// @file
+
+// Conjugate gradient: direction = preconditioned residual + beta*direction.
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    solution,                           // CG solution (velocity increment).
+                        __global float4*    residual,                           // CG residual.
+                        __global float4*    direction,                          // CG search direction.
+                        __global float4*    product,                            // CG system matrix times search direction.
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner.
+                        __global float*     partial,                            // CG partial sums.
+                        __global float*     scalars)                            // CG scalars.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// GLOBAL INDEX /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Setting global index "gid"...
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////// CONJUGATE GRADIENT: DIRECTION ////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  if(scalars[CG_DONE] != 0.0f)
+  {
+    return;                                                                     // Already converged.
+  }
+
+  direction[gid] = residual[gid]*preconditioner[gid] + scalars[CG_BETA]*direction[gid];
+}
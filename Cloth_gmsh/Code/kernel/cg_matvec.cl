@@ -0,0 +1,94 @@
+/// @file
+
+// Conjugate gradient: product = (m + dt*B - dt^2*K)*direction, with the stiffness matrix "K" applied
+// link by link on the neighbour tuple (matrix free), and the partial sums of direction*product. Each
+// of the "CG_GROUPS" work-items loops over the nodes with a stride equal to the global size.
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    solution,                           // CG solution (velocity increment).
+                        __global float4*    residual,                           // CG residual.
+                        __global float4*    direction,                          // CG search direction.
+                        __global float4*    product,                            // CG system matrix times search direction.
+                        __global float4*    preconditioner,                     // CG inverse Jacobi preconditioner.
+                        __global float*     partial,                            // CG partial sums.
+                        __global float*     scalars)                            // CG scalars.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Global index [#].
+  unsigned long stride = get_global_size(0);                                    // Node stride [#].
+  unsigned long nodes = (unsigned long)scalars[CG_NODES];                       // Number of nodes [#].
+  unsigned long i = 0;                                                          // Node index [#].
+  unsigned long j = 0;                                                          // Neighbour stride index.
+  unsigned long j_min = 0;                                                      // Neighbour stride minimun index.
+  unsigned long j_max = 0;                                                      // Neighbour stride maximum index.
+  unsigned long k = 0;                                                          // Neighbour tuple index.
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////// CELL VARIABLES //////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        p                 = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Central node position.
+  float4        d                 = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Central node search direction.
+  float4        q                 = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Central node matrix product.
+  float4        Kp                = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Stiffness matrix times direction.
+  float         m                 = 0.0f;                                       // Central node mass.
+  float         B                 = friction[0];                                // Central node friction.
+  float         fr                = 0.0f;                                       // Central node freedom flag.
+  float         dt                = dt_simulation[0];                           // Simulation time step [s].
+  float         dq                = 0.0f;                                       // Partial sum of direction*product.
+
+  if(scalars[CG_DONE] != 0.0f)
+  {
+    return;                                                                     // Already converged.
+  }
+
+  for(i = gid; i < nodes; i += stride)
+  {
+    p = position[i];                                                            // Getting position...
+    d = direction[i];                                                           // Getting search direction...
+    m = mass[i];                                                                // Getting mass...
+    fr = freedom[i];                                                            // Getting freedom flag...
+    Kp = (float4)(0.0f, 0.0f, 0.0f, 0.0f);                                      // Resetting stiffness matrix times direction...
+    j_max = offset[i];                                                          // Setting stride maximum...
+
+    // COMPUTING STRIDE MINIMUM INDEX:
+    if (i == 0)
+    {
+      j_min = 0;                                                                // Setting stride minimum (first stride)...
+    }
+    else
+    {
+      j_min = offset[i - 1];                                                    // Setting stride minimum (all others)...
+    }
+
+    // COMPUTING STIFFNESS MATRIX TIMES DIRECTION:
+    for (j = j_min; j < j_max; j++)
+    {
+      k = nearest[j];                                                           // Computing neighbour index...
+      Kp += link_jacobian(position[k] - p, resting[j], stiffness[j], direction[k] - d);
+    }
+
+    // COMPUTING MATRIX PRODUCT (constrained nodes have no increment):
+    q = fr*((m + dt*B)*d - dt*dt*Kp);                                           // Computing matrix product...
+    q.w = 0.0f;                                                                 // Adjusting projective space...
+
+    product[i] = q;                                                             // Updating matrix product...
+    dq += dot(d, q);                                                            // Accumulating direction*product...
+  }
+
+  partial[gid] = dq;                                                            // Updating partial sum...
+}
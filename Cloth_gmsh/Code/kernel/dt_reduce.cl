@@ -0,0 +1,92 @@
+/// @file
+
+// Adaptive time step, 1st kernel: partial maxima of speed, acceleration and link strain rate
+// over the free nodes, one per work-item (strided loop), reduced by dt_control.cl.
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    dt_partial,                         // Partial maxima (speed, acceleration, strain rate).
+                        __global float*     dt_limits)                          // Time step limits (see "DT_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Global index [#].
+  unsigned long stride = get_global_size(0);                                    // Node stride [#].
+  unsigned long nodes = (unsigned long)dt_limits[DT_NODES];                     // # of nodes [#].
+  unsigned long i;                                                              // Central node index [#].
+  unsigned long j;                                                              // Neighbour tuple index [#].
+  unsigned long j_min;                                                          // Neighbour tuple minimum index [#].
+  unsigned long j_max;                                                          // Neighbour tuple maximum index [#].
+  unsigned long k;                                                              // Neighbour node index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////// CELL VARIABLES //////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        p;                                                              // Central node position.
+  float4        v;                                                              // Central node velocity.
+  float4        a;                                                              // Central node acceleration.
+  float4        link;                                                           // Neighbour link.
+  float4        link_v;                                                         // Neighbour link relative velocity.
+  float         L;                                                              // Neighbour link length.
+  float         v_max             = 0.0f;                                       // Maximum speed [m/s].
+  float         a_max             = 0.0f;                                       // Maximum acceleration [m/s^2].
+  float         s_max             = 0.0f;                                       // Maximum link strain rate [1/s].
+
+  for(i = gid; i < nodes; i += stride)
+  {
+    if(freedom[i] == 0)
+    {
+      continue;                                                                 // Constrained node: skipping...
+    }
+
+    p = position[i];                                                            // Getting central node position...
+    v = velocity[i];                                                            // Getting central node velocity...
+    a = acceleration[i];                                                        // Getting central node acceleration...
+    v.w = 0.0f;                                                                 // Discarding projective component...
+    a.w = 0.0f;                                                                 // Discarding projective component...
+    v_max = fmax(v_max, length(v));                                             // Updating maximum speed [m/s]...
+    a_max = fmax(a_max, length(a));                                             // Updating maximum acceleration [m/s^2]...
+
+    // COMPUTING STRIDE MINIMUM INDEX:
+    if(i == 0)
+    {
+      j_min = 0;                                                                // Setting stride minimum (first stride)...
+    }
+    else
+    {
+      j_min = offset[i - 1];                                                    // Setting stride minimum (all others)...
+    }
+
+    j_max = offset[i];                                                          // Setting stride maximum...
+
+    for(j = j_min; j < j_max; j++)
+    {
+      k = nearest[j];                                                           // Computing neighbour index...
+      link = position[k] - p;                                                   // Getting neighbour link vector...
+      link_v = velocity[k] - v;                                                 // Getting neighbour link relative velocity...
+      link.w = 0.0f;                                                            // Discarding projective component...
+      link_v.w = 0.0f;                                                          // Discarding projective component...
+      L = length(link);                                                         // Computing neighbour link length...
+
+      if(L > 0.0f)
+      {
+        s_max = fmax(s_max, fabs(dot(link, link_v))/(L*L));                     // Updating maximum strain rate [1/s]...
+      }
+    }
+  }
+
+  dt_partial[gid] = (float4)(v_max, a_max, s_max, 0.0f);                        // Updating partial maxima...
+}
@@ -0,0 +1,5 @@
+/// @file
+
+// Prepended (before utilities.cl) to thekernel2.cl and edge_force.cl when EDGE is enabled: each link
+// force is computed once by edge_force.cl and gathered by both end nodes in thekernel2.cl.
+#define EDGE
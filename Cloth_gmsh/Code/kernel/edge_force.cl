@@ -0,0 +1,46 @@
+/// @file
+
+// Edge-based forces: computes the elastic force of each link once (one work-item per edge) @ the
+// intermediate position. The force acts on the 1st node, its opposite on the 2nd node: thekernel2.cl
+// gathers it through "link_edge", hence no atomic accumulation is needed.
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global HISTORY4*  velocity_int,                       // Velocity (intermediate).
+                        __global HISTORY4*  acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global HISTORY*   stiffness,                          // Stiffness.
+                        __global HISTORY*   resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global long*      edge_i,                             // Edge 1st node.
+                        __global long*      edge_j,                             // Edge 2nd node.
+                        __global long*      edge_link,                          // Edge link (neighbour tuple) index.
+                        __global long*      link_edge,                          // Link edge index (< 0 = reversed).
+                        __global float4*    edge_force)                         // Edge force (on 1st node).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long e = get_global_id(0);                                           // Edge index [#].
+  unsigned long i = edge_i[e];                                                  // Edge 1st node index [#].
+  unsigned long k = edge_j[e];                                                  // Edge 2nd node index [#].
+  unsigned long j = edge_link[e];                                               // Edge link index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ///////////////////////////////// EDGE VARIABLES ///////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        link              = position_int[k] - position_int[i];          // Edge link.
+  float         R                 = load_history(resting, j);                   // Edge resting length.
+  float         K                 = load_history(stiffness, j);                 // Edge stiffness.
+  float         L                 = length(link);                               // Edge length.
+  float         S                 = L - R;                                      // Edge strain.
+
+  // UPDATING EDGE FORCE:
+  edge_force[e] = K*S*normalize(link);                                          // Computing elastic force on 1st node...
+}
@@ -0,0 +1,6 @@
+/// @file
+
+// Prepended (before utilities.cl) to thekernel1.cl/thekernel2.cl when MIXED is enabled: acceleration,
+// intermediate velocity, link resting length and link stiffness are then stored as "half" (vload_half
+// and vstore_half, no fp16 extension needed) while all the arithmetic stays in "float".
+#define MIXED
@@ -0,0 +1,121 @@
+/// @file
+
+// Dynamic relaxation, 1st kernel: residual force and trial velocity of the free nodes, one strided
+// loop per work-item. The residual force excludes the viscous force: the damping of dynamic
+// relaxation is kinetic (see relaxation_check.cl). The fictitious mass of each node,
+// m = DR_MASS*dt^2*sum(K), is stable for DR_MASS > 0.5 (Gershgorin bound).
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    dr_partial,                         // Partial sums (kinetic energy, residual^2, load^2).
+                        __global float*     dr_scalars)                         // Dynamic relaxation scalars (see "DR_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long gid = get_global_id(0);                                         // Global index [#].
+  unsigned long stride = get_global_size(0);                                    // Node stride [#].
+  unsigned long nodes = (unsigned long)dr_scalars[DR_NODES];                    // # of nodes [#].
+  unsigned long i;                                                              // Central node index [#].
+  unsigned long j;                                                              // Neighbour tuple index [#].
+  unsigned long j_min;                                                          // Neighbour tuple minimum index [#].
+  unsigned long j_max;                                                          // Neighbour tuple maximum index [#].
+  unsigned long k;                                                              // Neighbour node index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////// CELL VARIABLES //////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        p;                                                              // Central node position.
+  float4        v;                                                              // Central node velocity.
+  float4        g                 = gravity[0];                                 // Central node gravity field.
+  float4        link;                                                           // Neighbour link.
+  float4        Fe;                                                             // Central node elastic force.
+  float4        Fg;                                                             // Central node gravitational force (load).
+  float4        F;                                                              // Central node residual force.
+  float         K;                                                              // Neighbour link stiffness.
+  float         L;                                                              // Neighbour link length.
+  float         K_sum;                                                          // Central node stiffness (sum over links).
+  float         m_f;                                                            // Central node fictitious mass.
+  float         fr;                                                             // Central node freedom flag.
+  float         dt                = dt_simulation[0];                           // Fictitious time step [s].
+  float         scale             = dr_scalars[DR_MASS];                        // Fictitious mass scale factor.
+  float         KE                = 0.0f;                                       // Kinetic energy [J].
+  float         R2                = 0.0f;                                       // Squared residual force [N^2].
+  float         W2                = 0.0f;                                       // Squared load [N^2].
+
+  if(dr_scalars[DR_DONE] > 0.0f)
+  {
+    return;                                                                     // Static equilibrium reached: nothing to do...
+  }
+
+  for(i = gid; i < nodes; i += stride)
+  {
+    p = position[i];                                                            // Getting central node position...
+    v = velocity[i];                                                            // Getting central node velocity...
+    fr = freedom[i];                                                            // Getting central node freedom flag...
+    Fe = (float4)(0.0f, 0.0f, 0.0f, 0.0f);                                      // Resetting elastic force...
+    K_sum = 0.0f;                                                               // Resetting central node stiffness...
+
+    // COMPUTING STRIDE MINIMUM INDEX:
+    if(i == 0)
+    {
+      j_min = 0;                                                                // Setting stride minimum (first stride)...
+    }
+    else
+    {
+      j_min = offset[i - 1];                                                    // Setting stride minimum (all others)...
+    }
+
+    j_max = offset[i];                                                          // Setting stride maximum...
+
+    // COMPUTING ELASTIC FORCE:
+    for(j = j_min; j < j_max; j++)
+    {
+      k = nearest[j];                                                           // Computing neighbour index...
+      link = position[k] - p;                                                   // Getting neighbour link vector...
+      link.w = 0.0f;                                                            // Discarding projective component...
+      K = stiffness[j];                                                         // Getting neighbour link stiffness...
+      L = length(link);                                                         // Computing neighbour link length...
+      Fe += K*(L - resting[j])*normalize(link);                                 // Building up elastic force on central node...
+      K_sum += K;                                                               // Building up central node stiffness...
+    }
+
+    // APPLYING FREEDOM CONSTRAINTS (isolated nodes have no fictitious mass):
+    if((fr == 0) || (K_sum == 0.0f))
+    {
+      velocity_int[i] = (float4)(0.0f, 0.0f, 0.0f, 1.0f);                       // Constraining trial velocity...
+      continue;                                                                 // Constrained node: skipping...
+    }
+
+    // COMPUTING RESIDUAL FORCE (static: no viscous force):
+    Fg = mass[i]*g;                                                             // Computing node gravitational force (load)...
+    Fg.w = 0.0f;                                                                // Discarding projective component...
+    F = Fe + Fg;                                                                // Computing residual force...
+
+    // COMPUTING TRIAL VELOCITY:
+    m_f = scale*dt*dt*K_sum;                                                    // Computing fictitious mass...
+    v = v + dt*F/m_f;                                                           // Computing trial velocity...
+    v.w = 0.0f;                                                                 // Discarding projective component...
+    KE += 0.5f*m_f*dot(v, v);                                                   // Accumulating kinetic energy [J]...
+    R2 += dot(F, F);                                                            // Accumulating squared residual force [N^2]...
+    W2 += dot(Fg, Fg);                                                          // Accumulating squared load [N^2]...
+
+    // FIXING PROJECTIVE SPACE:
+    v.w = 1.0f;                                                                 // Adjusting projective space...
+    velocity_int[i] = v;                                                        // Setting trial velocity [m/s]...
+  }
+
+  dr_partial[gid] = (float4)(KE, R2, W2, 0.0f);                                 // Setting partial sums...
+}
@@ -0,0 +1,53 @@
+/// @file
+
+// Dynamic relaxation, 3rd kernel: position update with the trial velocities, or velocity reset
+// at a kinetic energy peak (see relaxation_check.cl).
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    dr_partial,                         // Partial sums (kinetic energy, residual^2, load^2).
+                        __global float*     dr_scalars)                         // Dynamic relaxation scalars (see "DR_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long i = get_global_id(0);                                           // Global index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////// CELL VARIABLES //////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        p                 = position[i];                                // Central node position.
+  float4        v                 = velocity_int[i];                            // Central node velocity (trial).
+  float         dt                = dt_simulation[0];                           // Fictitious time step [s].
+
+  if(dr_scalars[DR_DONE] > 0.0f)
+  {
+    return;                                                                     // Static equilibrium reached: nothing to do...
+  }
+
+  // KINETIC DAMPING:
+  if(dr_scalars[DR_RESET] > 0.0f)
+  {
+    v = (float4)(0.0f, 0.0f, 0.0f, 1.0f);                                       // Kinetic energy peak: zeroing velocity...
+  }
+  else
+  {
+    p += dt*(float4)(v.x, v.y, v.z, 0.0f);                                      // Updating position...
+  }
+
+  // UPDATING KINEMATICS:
+  position[i] = p;                                                              // Updating position [m]...
+  velocity[i] = v;                                                              // Updating velocity [m/s]...
+}
@@ -0,0 +1,66 @@
+/// @file
+
+// Dynamic relaxation, 2nd kernel (single work-item): reduces the partial sums and applies the
+// kinetic damping. When the kinetic energy of the trial velocities drops below the one of the last
+// step a peak has just been passed: the velocities are set to zero (see relaxation2.cl) and the
+// motion restarts from rest. The relaxation stops when the residual force relative to the load
+// drops below "DR_TOL".
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global float4*    dr_partial,                         // Partial sums (kinetic energy, residual^2, load^2).
+                        __global float*     dr_scalars)                         // Dynamic relaxation scalars (see "DR_*" in utilities.cl).
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////// KINETIC DAMPING /////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long groups = (unsigned long)dr_scalars[DR_GROUPS];                  // Setting # of partial sums [#]...
+  unsigned long n;                                                              // Partial sum index [#].
+  float       KE = 0.0f;                                                        // Kinetic energy [J].
+  float       R2 = 0.0f;                                                        // Squared residual force [N^2].
+  float       W2 = 0.0f;                                                        // Squared load [N^2].
+
+  if(dr_scalars[DR_DONE] > 0.0f)
+  {
+    return;                                                                     // Static equilibrium reached: nothing to do...
+  }
+
+  for(n = 0; n < groups; n++)
+  {
+    KE += dr_partial[n].x;                                                      // Reducing kinetic energy [J]...
+    R2 += dr_partial[n].y;                                                      // Reducing squared residual force [N^2]...
+    W2 += dr_partial[n].z;                                                      // Reducing squared load [N^2]...
+  }
+
+  dr_scalars[DR_RESIDUAL] = (W2 > 0.0f) ? sqrt(R2/W2) : sqrt(R2);               // Setting relative residual force...
+  dr_scalars[DR_STEPS] += 1.0f;                                                 // Counting relaxation steps...
+
+  if(dr_scalars[DR_RESIDUAL] < dr_scalars[DR_TOL])
+  {
+    dr_scalars[DR_DONE] = 1.0f;                                                 // Static equilibrium reached...
+  }
+
+  if(KE < dr_scalars[DR_KE])
+  {
+    dr_scalars[DR_RESET] = 1.0f;                                                // Kinetic energy peak: zeroing velocities...
+    dr_scalars[DR_PEAKS] += 1.0f;                                               // Counting kinetic energy peaks...
+    dr_scalars[DR_KE] = 0.0f;                                                   // Restarting from rest...
+  }
+  else
+  {
+    dr_scalars[DR_RESET] = 0.0f;                                                // Accepting trial velocities...
+    dr_scalars[DR_KE] = KE;                                                     // Setting kinetic energy [J]...
+  }
+}
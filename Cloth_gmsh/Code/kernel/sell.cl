@@ -0,0 +1,8 @@
+/// @file
+
+// Prepended (before utilities.cl) to thekernel2.cl when the host chooses the SELL-C-sigma layout: the
+// neighbour indexes (32-bit), link resting lengths and stiffnesses are stored in it instead of CSR. The nodes are
+// sorted by # of neighbours within windows of "SELL_SIGMA" rows and the slots of each chunk of
+// "SELL_C" rows are interleaved: slot "s" of the rows of a chunk are contiguous, hence coalesced.
+#define SELL
+#define SELL_C                    32                                            // Chunk size: # of rows with interleaved slots [#].
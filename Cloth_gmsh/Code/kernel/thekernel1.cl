@@ -4,15 +4,15 @@ __kernel void thekernel(__global float4*    color,
                         __global float4*    position,                           // Position.
                         __global float4*    position_int,                       // Position (intermediate).
                         __global float4*    velocity,                           // Velocity.
-                        __global float4*    velocity_int,                       // Velocity (intermediate).
-                        __global float4*    acceleration,                       // Acceleration.
+                        __global HISTORY4*  velocity_int,                       // Velocity (intermediate).
+                        __global HISTORY4*  acceleration,                       // Acceleration.
                         __global float4*    gravity,                            // Gravity.
-                        __global float*     stiffness,                          // Stiffness.
-                        __global float*     resting,                            // Resting distance.
+                        __global HISTORY*   stiffness,                          // Stiffness.
+                        __global HISTORY*   resting,                            // Resting distance.
                         __global float*     friction,                           // Friction.
                         __global float*     mass,                               // Mass.
-                        __global long*      nearest,                            // Neighbour.
-                        __global long*      offset,                             // Offset.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
                         __global long*      freedom,                            // Freedom flag.
                         __global float*     dt_simulation)                      // Simulation time step.
 {
@@ -30,7 +30,7 @@ __kernel void thekernel(__global float4*    color,
   ////////////////////////////////////////////////////////////////////////////////
   float4        p                 = position[i];                                // Central node position.
   float4        v                 = velocity[i];                                // Central node velocity.
-  float4        a                 = acceleration[i];                            // Central node acceleration.
+  float4        a                 = load_history4(acceleration, i);             // Central node acceleration.
   float4        p_new             = (float4)(0.0f, 0.0f, 0.0f, 1.0f);           // Central node position. 
   float         fr                = freedom[i];                                 // Central node freedom flag.
   float         dt                = dt_simulation[0];                           // Simulation time step [s].
@@ -50,5 +50,5 @@ __kernel void thekernel(__global float4*    color,
   
   // UPDATING INTERMEDIATE POSITION:
   position_int[i] = p_new;                                                      // Updating intermediate position...
-  velocity_int[i] = v + a*dt;                                                   // Updating intermediate velocity...
+  store_history4(velocity_int, i, v + a*dt);                                    // Updating intermediate velocity...
 }
@@ -4,34 +4,62 @@ __kernel void thekernel(__global float4*    color,
                         __global float4*    position,                           // Position.
                         __global float4*    position_int,                       // Position (intermediate).
                         __global float4*    velocity,                           // Velocity.
-                        __global float4*    velocity_int,                       // Velocity (intermediate).
-                        __global float4*    acceleration,                       // Acceleration.
+                        __global HISTORY4*  velocity_int,                       // Velocity (intermediate).
+                        __global HISTORY4*  acceleration,                       // Acceleration.
                         __global float4*    gravity,                            // Gravity.
-                        __global float*     stiffness,                          // Stiffness.
-                        __global float*     resting,                            // Resting distance.
+                        __global HISTORY*   stiffness,                          // Stiffness.
+                        __global HISTORY*   resting,                            // Resting distance.
                         __global float*     friction,                           // Friction.
                         __global float*     mass,                               // Mass.
-                        __global long*      nearest,                            // Neighbour.
-                        __global long*      offset,                             // Offset.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
                         __global long*      freedom,                            // Freedom flag.
+#ifdef EDGE
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global long*      edge_i,                             // Edge 1st node.
+                        __global long*      edge_j,                             // Edge 2nd node.
+                        __global long*      edge_link,                          // Edge link (neighbour tuple) index.
+                        __global long*      link_edge,                          // Link edge index (< 0 = reversed).
+                        __global float4*    edge_force)                         // Edge force (on 1st node).
+#elif defined(SELL)
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global int2*      sell_row,                           // Sorted row (node index, # of neighbours).
+                        __global int*       sell_chunk,                         // Chunk offset.
+                        __global int*       sell_nearest)                       // Neighbour (SELL slots).
+#else
                         __global float*     dt_simulation)                      // Simulation time step.
+#endif
 {
   ////////////////////////////////////////////////////////////////////////////////
   //////////////////////////////////// INDEXES ///////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////
+#ifdef SELL
+  unsigned long r = get_global_id(0);                                           // Sorted row index [#].
+  int2          row = sell_row[r];                                              // Sorted row (node index, # of neighbours).
+  unsigned long i = row.x;                                                      // Global index [#].
+  unsigned long j = 0;                                                          // Neighbour slot index.
+  unsigned long j_min = sell_chunk[r/SELL_C] + r%SELL_C;                        // Neighbour slot minimum index.
+  unsigned long j_max = j_min + SELL_C*row.y;                                   // Neighbour slot maximum index.
+  unsigned long j_step = SELL_C;                                                // Neighbour slot step (interleaved chunk).
+#else
   unsigned long i = get_global_id(0);                                           // Global index [#].
   unsigned long j = 0;                                                          // Neighbour stride index.
   unsigned long j_min = 0;                                                      // Neighbour stride minimun index.
   unsigned long j_max = offset[i];                                              // Neighbour stride maximum index.
+  unsigned long j_step = 1;                                                     // Neighbour stride step.
+#endif
   unsigned long k = 0;                                                          // Neighbour tuple index.
+#ifdef EDGE
+  long          e = 0;                                                          // Link edge index (< 0 = reversed).
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////// CELL VARIABLES //////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////
   float4        v                 = velocity[i];                                // Central node velocity.
-  float4        a                 = acceleration[i];                            // Central node acceleration.
+  float4        a                 = load_history4(acceleration, i);             // Central node acceleration.
   float4        p_int             = position_int[i];                            // Central node position (intermediate).
-  float4        v_int             = velocity_int[i];                            // Central node velocity (intermediate).
+  float4        v_int             = load_history4(velocity_int, i);             // Central node velocity (intermediate).
   float4        p_new             = (float4)(0.0f, 0.0f, 0.0f, 1.0f);           // Central node position (new).
   float4        v_new             = (float4)(0.0f, 0.0f, 0.0f, 1.0f);           // Central node velocity (new).
   float4        a_new             = (float4)(0.0f, 0.0f, 0.0f, 1.0f);           // Central node acceleration (new).
@@ -56,6 +84,7 @@ __kernel void thekernel(__global float4*    color,
   float         L                 = 0.0f;                                       // Neighbour link length.
   float         dt                = dt_simulation[0];                           // Simulation time step [s].
   
+#ifndef SELL
   // COMPUTING STRIDE MINIMUM INDEX:
   if (i == 0)
   {
@@ -65,20 +94,42 @@ __kernel void thekernel(__global float4*    color,
   {
     j_min = offset[i - 1];                                                      // Setting stride minimum (all others)...
   }
+#endif
 
   // COMPUTING ELASTIC FORCE:
+#ifdef EDGE
+  // Gathering the link forces computed once per edge by edge_force.cl:
   for (j = j_min; j < j_max; j++)
   {
+    e = link_edge[j];                                                           // Getting link edge index...
+
+    if (e >= 0)
+    {
+      Fe += edge_force[e];                                                      // Building up elastic force (1st node)...
+    }
+    else
+    {
+      Fe -= edge_force[-1 - e];                                                 // Building up elastic force (2nd node)...
+    }
+  }
+#else
+  for (j = j_min; j < j_max; j += j_step)
+  {
+#ifdef SELL
+    k = sell_nearest[j];                                                        // Computing neighbour index...
+#else
     k = nearest[j];                                                             // Computing neighbour index...
+#endif
     neighbour = position_int[k];                                                // Getting neighbour position...
     link = neighbour - p_int;                                                   // Getting neighbour link vector...
-    R = resting[j];                                                             // Getting neighbour link resting length...
-    K = stiffness[j];                                                           // Getting neighbour link stiffness...
+    R = load_history(resting, j);                                               // Getting neighbour link resting length...
+    K = load_history(stiffness, j);                                             // Getting neighbour link stiffness...
     L = length(link);                                                           // Computing neighbour link length...
     S = L - R;                                                                  // Computing neighbour link strain...
     D = S*normalize(link);                                                      // Computing neighbour link displacement...
     Fe += K*D;                                                                  // Building up elastic force on central node...
   }
+#endif
 
   // COMPUTING TOTAL FORCE:
   Fg = m*g;                                                                     // Computing node gravitational force...
@@ -122,5 +173,5 @@ __kernel void thekernel(__global float4*    color,
   // UPDATING KINEMATICS:
   position[i] = p_int;                                                          // Updating position [m]...
   velocity[i] = v_new;                                                          // Updating velocity [m/s]...
-  acceleration[i] = a_new;                                                      // Updating acceleration [m/s^2]...
+  store_history4(acceleration, i, a_new);                                       // Updating acceleration [m/s^2]...
 }
@@ -10,6 +10,53 @@
 #define BMAX                      1.0f                                          // Maximum blue channel for colormap
 #define SCALE                     1.5f                                          // Scale factor for plot
 
+// History quantities (acceleration, intermediate velocity, link resting length and stiffness):
+#ifdef MIXED
+  #define HISTORY                 half                                          // "half" storage, "float" arithmetic (see mixed.cl).
+  #define HISTORY4                half                                          // "half" storage of "float4" vectors (see mixed.cl).
+  #define load_history(a, i)      vload_half((i), (a))                          // Loading element "i".
+  #define load_history4(a, i)     vload_half4((i), (a))                         // Loading vector "i".
+  #define store_history4(a, i, v) vstore_half4((v), (i), (a))                   // Storing vector "i" (rounded to nearest).
+#else
+  #define HISTORY                 float                                         // "float" storage.
+  #define HISTORY4                float4                                        // "float4" storage.
+  #define load_history(a, i)      (a)[i]                                        // Loading element "i".
+  #define load_history4(a, i)     (a)[i]                                        // Loading vector "i".
+  #define store_history4(a, i, v) (a)[i] = (v)                                  // Storing vector "i".
+#endif
+
+// Conjugate gradient scalars (implicit integration):
+#define CG_RZ                     0                                             // Residual times preconditioned residual.
+#define CG_RZ0                    1                                             // Initial "CG_RZ" (< 0 = not yet computed).
+#define CG_ALPHA                  2                                             // Step length.
+#define CG_BETA                   3                                             // Search direction update factor.
+#define CG_DONE                   4                                             // Convergence flag (1 = converged).
+#define CG_TOL                    5                                             // Relative tolerance (set by host).
+#define CG_ITER                   6                                             // # of iterations of the last solve.
+#define CG_GROUPS                 7                                             // # of partial sums (set by host).
+#define CG_NODES                  8                                             // # of nodes (set by host).
+
+// Adaptive time step limits (set by host):
+#define DT_MIN                    0                                             // Minimum time step [s].
+#define DT_MAX                    1                                             // Maximum time step (stability bound) [s].
+#define DT_LENGTH                 2                                             // Mesh size [m].
+#define DT_CFL                    3                                             // Maximum node travel and link strain per time step.
+#define DT_GROWTH                 4                                             // Maximum time step growth per time step.
+#define DT_GROUPS                 5                                             // # of partial maxima.
+#define DT_NODES                  6                                             // # of nodes.
+
+// Dynamic relaxation scalars:
+#define DR_KE                     0                                             // Kinetic energy of the last step (0 after a peak) [J].
+#define DR_RESET                  1                                             // Kinetic energy peak flag (1 = velocities set to zero).
+#define DR_RESIDUAL               2                                             // Relative residual force.
+#define DR_DONE                   3                                             // Convergence flag (1 = static equilibrium reached).
+#define DR_STEPS                  4                                             // # of relaxation steps.
+#define DR_PEAKS                  5                                             // # of kinetic energy peaks.
+#define DR_TOL                    6                                             // Relative residual tolerance (set by host).
+#define DR_MASS                   7                                             // Fictitious mass scale factor (set by host).
+#define DR_GROUPS                 8                                             // # of partial sums (set by host).
+#define DR_NODES                  9                                             // # of nodes (set by host).
+
 void link_displacements (
                           float4 position_R,                                    // Right neighbour position [m].
                           float4 position_U,                                    // Up neighbour position [m].
@@ -106,6 +153,61 @@ float4 node_force (
   return F;
 }
 
+// Link stiffness matrix K = d(F)/d(P_j) applied to vector "y" (implicit integration).
+// The transverse term is clamped at 0 for compressed links, so that K stays positive semidefinite.
+float4 link_jacobian (
+                       float4 link,                                             // Link vector (neighbour - node) [m].
+                       float  resting,                                          // Link resting length [m].
+                       float  stiffness,                                        // Link stiffness.
+                       float4 y                                                 // Applied vector.
+                     )
+{
+  float4      u;                                                                // Link direction.
+  float4      y_par;                                                            // Component of "y" along the link.
+  float       l;                                                                // Link length [m].
+  float       s;                                                                // Transverse stiffness ratio.
+
+  link.w = 0.0f;                                                                // Discarding projective component...
+  y.w = 0.0f;                                                                   // Discarding projective component...
+  l = length(link);                                                             // Computing link length...
+
+  if(l == 0.0f)
+  {
+    return (float4)(0.0f, 0.0f, 0.0f, 0.0f);                                    // Non-existing link.
+  }
+
+  u = link/l;                                                                   // Computing link direction...
+  s = fmax(1.0f - resting/l, 0.0f);                                             // Computing transverse stiffness ratio...
+  y_par = dot(u, y)*u;                                                          // Projecting "y" along the link...
+
+  return stiffness*(y_par + s*(y - y_par));
+}
+
+// Diagonal of the link stiffness matrix K = d(F)/d(P_j) (Jacobi preconditioner).
+float4 link_jacobian_diagonal (
+                                float4 link,                                    // Link vector (neighbour - node) [m].
+                                float  resting,                                 // Link resting length [m].
+                                float  stiffness                                // Link stiffness.
+                              )
+{
+  float4      u;                                                                // Link direction.
+  float       l;                                                                // Link length [m].
+  float       s;                                                                // Transverse stiffness ratio.
+
+  link.w = 0.0f;                                                                // Discarding projective component...
+  l = length(link);                                                             // Computing link length...
+
+  if(l == 0.0f)
+  {
+    return (float4)(0.0f, 0.0f, 0.0f, 0.0f);                                    // Non-existing link.
+  }
+
+  u = link/l;                                                                   // Computing link direction...
+  s = fmax(1.0f - resting/l, 0.0f);                                             // Computing transverse stiffness ratio...
+
+  return stiffness*(u*u + s*((float4)(1.0f, 1.0f, 1.0f, 0.0f) - u*u));
+}
+
 void fix_projective_space (
                             float4* vector
                           )
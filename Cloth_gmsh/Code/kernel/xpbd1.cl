@@ -0,0 +1,62 @@
+/// @file
+
+// XPBD, 1st kernel: the previous position is saved in "position_int" and the position is predicted
+// from the velocity, after applying gravity and the viscous damping (implicitly, unconditionally stable).
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global long*      edge_i,                             // Constraint 1st node.
+                        __global long*      edge_j,                             // Constraint 2nd node.
+                        __global float*     edge_resting,                       // Constraint resting length.
+                        __global float*     edge_compliance,                    // Constraint compliance.
+                        __global float*     lambda,                             // Constraint Lagrange multiplier.
+                        __global long*      batch)                              // Colour batch offset.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long i = get_global_id(0);                                           // Global index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////// CELL VARIABLES //////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        p                 = position[i];                                // Central node position.
+  float4        v                 = velocity[i];                                // Central node velocity.
+  float4        p_new             = (float4)(0.0f, 0.0f, 0.0f, 1.0f);           // Central node position (predicted).
+  float         m                 = mass[i];                                    // Central node mass.
+  float4        g                 = gravity[0];                                 // Central node gravity field.
+  float         B                 = friction[0];                                // Central node friction.
+  float         fr                = freedom[i];                                 // Central node freedom flag.
+  float         dt                = dt_simulation[0];                           // Simulation time step [s].
+
+  // APPLYING EXTERNAL FORCES:
+  v = (v + g*dt)/(1.0f + B*dt/m);                                               // Applying gravity and viscous damping...
+
+  // APPLYING FREEDOM CONSTRAINTS:
+  if (fr == 0)
+  {
+    v = (float4)(0.0f, 0.0f, 0.0f, 1.0f);                                       // Constraining velocity...
+  }
+
+  // COMPUTING PREDICTED POSITION:
+  p_new = p + v*dt;                                                             // Computing predicted position...
+
+  // FIXING PROJECTIVE SPACE:
+  p_new.w = 1.0f;                                                               // Adjusting projective space...
+
+  // UPDATING KINEMATICS:
+  position_int[i] = p;                                                          // Saving previous position [m]...
+  position[i] = p_new;                                                          // Updating position [m]...
+}
@@ -0,0 +1,60 @@
+/// @file
+
+// XPBD, 2nd kernel: the velocity is derived from the corrected and the previous position.
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global long*      edge_i,                             // Constraint 1st node.
+                        __global long*      edge_j,                             // Constraint 2nd node.
+                        __global float*     edge_resting,                       // Constraint resting length.
+                        __global float*     edge_compliance,                    // Constraint compliance.
+                        __global float*     lambda,                             // Constraint Lagrange multiplier.
+                        __global long*      batch)                              // Colour batch offset.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long i = get_global_id(0);                                           // Global index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////// CELL VARIABLES //////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        p                 = position[i];                                // Central node position (corrected).
+  float4        p_old             = position_int[i];                            // Central node position (previous).
+  float4        v                 = velocity[i];                                // Central node velocity.
+  float4        v_new             = (float4)(0.0f, 0.0f, 0.0f, 1.0f);           // Central node velocity (new).
+  float4        a_new             = (float4)(0.0f, 0.0f, 0.0f, 1.0f);           // Central node acceleration (new).
+  float         fr                = freedom[i];                                 // Central node freedom flag.
+  float         dt                = dt_simulation[0];                           // Simulation time step [s].
+
+  // COMPUTING NEW VELOCITY:
+  v_new = (p - p_old)/dt;                                                       // Computing velocity...
+  a_new = (v_new - v)/dt;                                                       // Computing acceleration...
+
+  // APPLYING FREEDOM CONSTRAINTS:
+  if (fr == 0)
+  {
+    v_new = (float4)(0.0f, 0.0f, 0.0f, 1.0f);                                   // Constraining velocity...
+    a_new = (float4)(0.0f, 0.0f, 0.0f, 1.0f);                                   // Constraining acceleration...
+  }
+
+  // FIXING PROJECTIVE SPACE:
+  v_new.w = 1.0f;                                                               // Adjusting projective space...
+  a_new.w = 1.0f;                                                               // Adjusting projective space...
+
+  // UPDATING KINEMATICS:
+  velocity[i] = v_new;                                                          // Updating velocity [m/s]...
+  acceleration[i] = a_new;                                                      // Updating acceleration [m/s^2]...
+}
@@ -0,0 +1,69 @@
+/// @file
+
+// XPBD: solves the distance constraints of one colour batch (one work-item per constraint). The
+// constraints are sorted by colour and no two constraints of the same colour share a node, hence the
+// position updates of a batch are race free (parallel Gauss-Seidel).
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global long*      edge_i,                             // Constraint 1st node.
+                        __global long*      edge_j,                             // Constraint 2nd node.
+                        __global float*     edge_resting,                       // Constraint resting length.
+                        __global float*     edge_compliance,                    // Constraint compliance.
+                        __global float*     lambda,                             // Constraint Lagrange multiplier.
+                        __global long*      batch)                              // Colour batch offset.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long e = batch[0] + get_global_id(0);                                // Constraint index [#].
+  unsigned long i = edge_i[e];                                                  // Constraint 1st node index [#].
+  unsigned long j = edge_j[e];                                                  // Constraint 2nd node index [#].
+
+  ////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////// CONSTRAINT VARIABLES ////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  float4        p_i               = position[i];                                // 1st node position.
+  float4        p_j               = position[j];                                // 2nd node position.
+  float         w_i               = freedom[i]/mass[i];                         // 1st node inverse mass.
+  float         w_j               = freedom[j]/mass[j];                         // 2nd node inverse mass.
+  float         R                 = edge_resting[e];                            // Constraint resting length.
+  float         dt                = dt_simulation[0];                           // Simulation time step [s].
+  float         alpha             = edge_compliance[e]/(dt*dt);                 // Time step scaled compliance.
+  float         l                 = lambda[e];                                  // Lagrange multiplier.
+  float4        link              = p_j - p_i;                                  // Constraint link.
+  float         L                 = length(link);                               // Constraint link length.
+  float4        n                 = (float4)(0.0f, 0.0f, 0.0f, 0.0f);           // Constraint gradient.
+  float         C                 = L - R;                                      // Constraint violation.
+  float         dl                = 0.0f;                                       // Lagrange multiplier increment.
+
+  if ((L == 0.0f) || (w_i + w_j == 0.0f))
+  {
+    return;                                                                     // Degenerate or fully constrained link.
+  }
+
+  // COMPUTING LAGRANGE MULTIPLIER INCREMENT:
+  n = link/L;                                                                   // Computing constraint gradient...
+  dl = (-C - alpha*l)/(w_i + w_j + alpha);                                      // Computing multiplier increment...
+
+  // CORRECTING POSITIONS:
+  p_i -= w_i*dl*n;                                                              // Correcting 1st node position...
+  p_j += w_j*dl*n;                                                              // Correcting 2nd node position...
+
+  // UPDATING CONSTRAINT:
+  lambda[e] = l + dl;                                                           // Updating Lagrange multiplier...
+  position[i] = p_i;                                                            // Updating 1st node position [m]...
+  position[j] = p_j;                                                            // Updating 2nd node position [m]...
+}
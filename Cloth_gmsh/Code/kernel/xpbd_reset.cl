@@ -0,0 +1,32 @@
+/// @file
+
+// XPBD: resets the Lagrange multipliers of all constraints (one work-item per constraint).
+__kernel void thekernel(__global float4*    color,                              // Color.
+                        __global float4*    position,                           // Position.
+                        __global float4*    position_int,                       // Position (intermediate).
+                        __global float4*    velocity,                           // Velocity.
+                        __global float4*    velocity_int,                       // Velocity (intermediate).
+                        __global float4*    acceleration,                       // Acceleration.
+                        __global float4*    gravity,                            // Gravity.
+                        __global float*     stiffness,                          // Stiffness.
+                        __global float*     resting,                            // Resting distance.
+                        __global float*     friction,                           // Friction.
+                        __global float*     mass,                               // Mass.
+                        __global int*       nearest,                            // Neighbour.
+                        __global int*       offset,                             // Offset.
+                        __global long*      freedom,                            // Freedom flag.
+                        __global float*     dt_simulation,                      // Simulation time step.
+                        __global long*      edge_i,                             // Constraint 1st node.
+                        __global long*      edge_j,                             // Constraint 2nd node.
+                        __global float*     edge_resting,                       // Constraint resting length.
+                        __global float*     edge_compliance,                    // Constraint compliance.
+                        __global float*     lambda,                             // Constraint Lagrange multiplier.
+                        __global long*      batch)                              // Colour batch offset.
+{
+  ////////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////// INDEXES ///////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long e = get_global_id(0);                                           // Constraint index [#].
+
+  lambda[e] = 0.0f;                                                             // Resetting Lagrange multiplier...
+}
@@ -29,12 +29,187 @@
 #define SHADER_FRAG   "voxel_fragment.frag"                                                         // OpenGL fragment shader.
 #define GMSH_MESH     "Square_triangles.msh"                                                        // GMSH mesh.
 
+// NODE RENUMBERING (after loading the mesh):
+#define RENUMBER_NONE    0                                                                          // gmsh node numbering.
+#define RENUMBER_RCM     1                                                                          // Reverse Cuthill-McKee (minimum bandwidth).
+#define RENUMBER_HILBERT 2                                                                          // Hilbert curve of the node positions (spatial locality).
+#define RENUMBER      RENUMBER_NONE                                                                 // Node renumbering.
+#define RENUMBER_FILE "renumbering.txt"                                                             // New to original (gmsh) node index mapping output file.
+
+// MESH CACHE:
+#define MESH_CACHE    true                                                                          // "true" = binary mesh cache ("GMSH_MESH.cache"), rebuilt when the mesh changes.
+
 // OPENCL:
 #define QUEUE_NUM     1                                                                             // # of OpenCL queues [#].
-#define KERNEL_NUM    2                                                                             // # of OpenCL kernel [#].
+#define SUBSTEPS      1                                                                             // # of time steps per rendered frame [#].
+#define VENDOR_CACHE  true                                                                          // "true" = persistent program binary cache of the vendor OpenCL runtimes ("CACHE_HOME").
+#define CACHE_HOME    "vendor_cache"                                                                // Vendor OpenCL program cache directory (relative to the executable).
+
+// INTEGRATOR:
+#define PREDICTOR_CORRECTOR 0                                                                       // Verlet predictor-corrector.
+#define BACKWARD_EULER      1                                                                       // Implicit backward Euler, conjugate gradient solver (stiff cloth).
+#define XPBD                2                                                                       // Extended position based dynamics, graph coloured Gauss-Seidel.
+#define DYNAMIC_RELAXATION  3                                                                       // Dynamic relaxation, kinetic damping (static equilibrium only).
+#define INTEGRATOR    PREDICTOR_CORRECTOR                                                           // Time integration scheme.
+
+// IMPLICIT SOLVER (INTEGRATOR = BACKWARD_EULER):
+#define IMPLICIT_DT   20.0f                                                                         // Time step, in units of the critical time step [#].
+#define CG_ITERATIONS 100                                                                           // Maximum # of conjugate gradient iterations per time step [#].
+#define CG_TOLERANCE  1.0E-3f                                                                       // Conjugate gradient relative tolerance (preconditioned residual).
+#define CG_GROUPS     1024                                                                          // # of conjugate gradient partial sums (reduction work-items) [#].
+#define CG_CHECK      10                                                                            // # of CG iterations between two convergence flag reads [#].
+
+// XPBD SOLVER (INTEGRATOR = XPBD):
+#define XPBD_DT       2.0f                                                                          // Time step, in units of the critical time step [#].
+#define XPBD_ITERATIONS 10                                                                          // # of constraint iterations (all colour batches) per time step [#].
+
+// DYNAMIC RELAXATION (INTEGRATOR = DYNAMIC_RELAXATION):
+#define DR_MASS_SCALE 1.0f                                                                          // Fictitious mass scale factor (stable if > 0.5) [#].
+#define DR_TOLERANCE  1.0E-3f                                                                       // Residual force tolerance, relative to the load.
+#define DR_GROUPS     1024                                                                          // # of dynamic relaxation partial sums (reduction work-items) [#].
+
+#if INTEGRATOR == BACKWARD_EULER
+  #define KERNEL_NUM  7                                                                             // # of OpenCL kernel [#].
+#elif INTEGRATOR == XPBD
+  #define KERNEL_NUM  3                                                                             // # of OpenCL kernel, colour batch kernels excluded [#].
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  #define KERNEL_NUM  3                                                                             // # of OpenCL kernel [#].
+#else
+  #define KERNEL_NUM  2                                                                             // # of OpenCL kernel [#].
+#endif
+
+// ADAPTIVE TIME STEP:
+#define ADAPTIVE      false                                                                         // "true" = time step driven by an on-device CFL reduction.
+#define DT_CFL        0.05f                                                                         // Max node travel (in mesh sizes) and link strain change per time step.
+#define DT_GROWTH     1.02f                                                                         // Max time step growth per time step [#].
+#define DT_MIN        0.05f                                                                         // Min time step, in units of the critical time step [#].
+#define DT_GROUPS     1024                                                                          // # of time step partial maxima (reduction work-items) [#].
+
+#if INTEGRATOR == BACKWARD_EULER
+  #define DT_MAX      100.0f                                                                        // Max time step, in units of the critical time step [#] (accuracy only).
+#elif INTEGRATOR == XPBD
+  #define DT_MAX      10.0f                                                                         // Max time step, in units of the critical time step [#] (constraint convergence).
+#else
+  // NOTE: measured stability limit of the shipped meshes: 0.68 (quadrangles), 0.75 (triangles).
+  #define DT_MAX      0.6f                                                                          // Max time step, in units of the critical time step [#] (stability bound).
+#endif
+
+#if ADAPTIVE
+  #define DT_KERNELS  2                                                                             // # of adaptive time step OpenCL kernels [#].
+#else
+  #define DT_KERNELS  0                                                                             // # of adaptive time step OpenCL kernels [#].
+#endif
+
+#if ADAPTIVE && (INTEGRATOR == DYNAMIC_RELAXATION)
+  #error "Dynamic relaxation uses a fictitious time step: set ADAPTIVE to false."
+#endif
+
+// MIXED PRECISION (INTEGRATOR = PREDICTOR_CORRECTOR):
+#define MIXED         false                                                                         // "true" = acceleration, intermediate velocity, link resting and stiffness stored as "half".
+#define CHECK_STEPS   0                                                                             // # of time steps before saving (float) or comparing (MIXED) positions [#] (0 = no check).
+#define CHECK_FILE    "positions_float.txt"                                                         // Full float positions (reference of the MIXED build).
+
+#if MIXED && ((INTEGRATOR != PREDICTOR_CORRECTOR) || ADAPTIVE)
+  #error "Mixed precision storage is implemented by the predictor-corrector kernels only: set MIXED to false."
+#endif
+
+#if MIXED
+  #define HISTORY_SIZE 2                                                                            // # of float buffer elements per "half4" node vector [#].
+#else
+  #define HISTORY_SIZE 1                                                                            // # of float4 buffer elements per node vector [#].
+#endif
+
+// EDGE-BASED FORCES (INTEGRATOR = PREDICTOR_CORRECTOR):
+#define EDGE          false                                                                         // "true" = each link force computed once (edge_force.cl) and gathered by both nodes.
+
+#if EDGE && (INTEGRATOR != PREDICTOR_CORRECTOR)
+  #error "Edge-based forces are implemented by the predictor-corrector kernels only: set EDGE to false."
+#endif
+
+#if EDGE
+  #define EDGE_KERNELS 1                                                                            // # of edge-based force OpenCL kernels [#].
+#else
+  #define EDGE_KERNELS 0                                                                            // # of edge-based force OpenCL kernels [#].
+#endif
+
+// NEIGHBOUR LAYOUT (INTEGRATOR = PREDICTOR_CORRECTOR):
+#define SELL          true                                                                          // "true" = SELL-C-sigma neighbour layout if its fill reaches SELL_FILL, "false" = CSR.
+#define SELL_C        32                                                                            // Chunk size: # of rows with interleaved slots ("SELL_C" in sell.cl) [#].
+#define SELL_SIGMA    256                                                                           // Sorting window: # of rows sorted by # of neighbours [#].
+#define SELL_FILL     0.8f                                                                          // Minimum SELL-C-sigma fill (# of links/# of slots, padding included) [-].
+
+#if SELL && ((INTEGRATOR != PREDICTOR_CORRECTOR) || EDGE)
+  #undef SELL
+  #define SELL        false                                                                         // SELL-C-sigma layout: predictor-corrector kernels only, not edge-based.
+#endif
 
 // INCLUDES:
 #include "nu.hpp"                                                                                   // Neutrino's header file.
+#include "mesh_io.hpp"                                                                              // Mesh input (cache, gmsh and STL parsers, adjacency).
+#include "mesh_reorder.hpp"                                                                         // Node renumbering.
+#include "vendor_cache.hpp"                                                                         // OpenCL vendor program caches.
+#include "int32_buffer.hpp"                                                                         // 32-bit integer buffers.
+#include <algorithm>                                                                                // Constraint colouring.
+#include <cstring>                                                                                  // Packing "half" history values.
+#include <fstream>                                                                                  // Position files for accuracy checks.
+#include <cmath>                                                                                    // Critical time step.
+#include <map>                                                                                      // gmsh parser physical groups.
+#include <chrono>                                                                                   // gmsh parser throughput.
+
+// Converting a float to the nearest "half" (IEEE 754 binary16, ties to even), returned as bits:
+cl_half float_to_half (
+                       float value                                                                  // Value.
+                      )
+{
+  cl_uint                  bits;                                                                    // Float bits.
+  cl_uint                  sign;                                                                    // Half sign bit.
+  cl_int                   exponent;                                                                // Half biased exponent.
+  cl_uint                  mantissa;                                                                // Float mantissa.
+  cl_uint                  shift;                                                                   // Mantissa shift [#].
+  cl_uint                  half;                                                                    // Half exponent and mantissa bits.
+  cl_uint                  rest;                                                                    // Shifted out mantissa bits.
+
+  std::memcpy (&bits, &value, sizeof (bits));                                                       // Getting float bits...
+  sign     = (bits >> 16) & 0x8000;                                                                 // Getting sign bit...
+  exponent = (cl_int)((bits >> 23) & 0xFF) - 127 + 15;                                              // Rebiasing exponent...
+  mantissa = bits & 0x7FFFFF;                                                                       // Getting mantissa...
+
+  if(((bits >> 23) & 0xFF) == 0xFF)
+  {
+    return (cl_half)(sign | 0x7C00 | (mantissa ? 0x200 : 0));                                       // Infinity or NaN...
+  }
+
+  if(exponent >= 31)
+  {
+    return (cl_half)(sign | 0x7C00);                                                                // Overflow: infinity...
+  }
+
+  if(exponent <= 0)
+  {
+    if(exponent < -10)
+    {
+      return (cl_half)sign;                                                                         // Underflow: zero...
+    }
+
+    mantissa |= 0x800000;                                                                           // Adding implicit bit...
+    shift     = 14 - exponent;                                                                      // Setting subnormal shift...
+  }
+  else
+  {
+    mantissa |= (cl_uint)exponent << 23;                                                            // Adding exponent (carried by rounding)...
+    shift     = 13;                                                                                 // Setting normal shift...
+  }
+
+  half = mantissa >> shift;                                                                         // Truncating mantissa...
+  rest = mantissa & ((1u << shift) - 1);                                                            // Getting shifted out bits...
+
+  if((rest > (1u << (shift - 1))) || ((rest == (1u << (shift - 1))) && (half & 1)))
+  {
+    half++;                                                                                         // Rounding to nearest even...
+  }
+
+  return (cl_half)(sign | half);                                                                    // Returning half bits...
+}
 
 int main ()
 {
@@ -42,6 +217,25 @@ int main ()
   std::string              kernel_home;                                                             // Kernel home directory.
   std::vector<std::string> kernel_1;                                                                // Kernel_1 source files.
   std::vector<std::string> kernel_2;                                                                // Kernel_2 source files.
+#if INTEGRATOR == BACKWARD_EULER
+  std::vector<std::string> kernel_3;                                                                // Kernel_3 source files.
+  std::vector<std::string> kernel_4;                                                                // Kernel_4 source files.
+  std::vector<std::string> kernel_5;                                                                // Kernel_5 source files.
+  std::vector<std::string> kernel_6;                                                                // Kernel_6 source files.
+  std::vector<std::string> kernel_7;                                                                // Kernel_7 source files.
+#elif INTEGRATOR == XPBD
+  std::vector<std::string> kernel_3;                                                                // Kernel_3 source files.
+  std::vector<std::string> kernel_4;                                                                // Kernel_4 source files (colour batches).
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  std::vector<std::string> kernel_3;                                                                // Kernel_3 source files.
+#endif
+#if ADAPTIVE
+  std::vector<std::string> kernel_dt_reduce;                                                        // Adaptive time step reduction kernel source files.
+  std::vector<std::string> kernel_dt_control;                                                       // Adaptive time step control kernel source files.
+#endif
+#if EDGE
+  std::vector<std::string> kernel_edge;                                                             // Edge-based force kernel source files.
+#endif
 
   // INDEXES:
   size_t                   i;                                                                       // Index [#].
@@ -49,6 +243,7 @@ int main ()
   size_t                   j_min;                                                                   // Index [#].
   size_t                   j_max;                                                                   // Index [#].
   size_t                   k;                                                                       // Index [#].
+  size_t                   l;                                                                       // Index [#].
 
   // GUI PARAMETERS (orbit):
   float                    orbit_x_init       = 0.0f;                                               // x-axis orbit initial rotation.
@@ -78,6 +273,35 @@ int main ()
   queue*                   Q                  = new queue ();                                       // OpenCL queue.
   kernel*                  K1                 = new kernel ();                                      // OpenCL kernel array.
   kernel*                  K2                 = new kernel ();                                      // OpenCL kernel array.
+#if INTEGRATOR == BACKWARD_EULER
+  kernel*                  K3                 = new kernel ();                                      // OpenCL kernel (CG matrix product).
+  kernel*                  K4                 = new kernel ();                                      // OpenCL kernel (CG step length).
+  kernel*                  K5                 = new kernel ();                                      // OpenCL kernel (CG update).
+  kernel*                  K6                 = new kernel ();                                      // OpenCL kernel (CG direction factor).
+  kernel*                  K7                 = new kernel ();                                      // OpenCL kernel (CG direction).
+  size_t                   cg_groups;                                                               // CG reduction work-items [#].
+  int                      iteration;                                                               // CG iteration index [#].
+  std::vector<kernel*>     cg_kernels;                                                              // OpenCL kernels of one CG iteration, in enqueueing order.
+  size_t                   cg_start;                                                                // Index of the time step kernel preceded by the CG iterations [#].
+#elif INTEGRATOR == XPBD
+  kernel*                  K3                 = new kernel ();                                      // OpenCL kernel (Lagrange multiplier reset).
+  std::vector<kernel*>     K_batch;                                                                 // OpenCL kernels (one per colour batch).
+  int                      iteration;                                                               // XPBD iteration index [#].
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  kernel*                  K3                 = new kernel ();                                      // OpenCL kernel (DR kinetic damping).
+  size_t                   dr_groups;                                                               // DR reduction work-items [#].
+  bool                     relaxed            = false;                                              // Static equilibrium flag.
+#endif
+#if ADAPTIVE
+  kernel*                  K_dt_reduce        = new kernel ();                                      // OpenCL kernel (time step partial maxima).
+  kernel*                  K_dt_control       = new kernel ();                                      // OpenCL kernel (next time step).
+  size_t                   dt_groups;                                                               // Time step reduction work-items [#].
+#endif
+#if EDGE
+  kernel*                  K_edge             = new kernel ();                                      // OpenCL kernel (edge forces).
+#endif
+  std::vector<kernel*>     step_kernels;                                                            // OpenCL kernels of one time step, in enqueueing order.
+  size_t                   step_kernel;                                                             // Time step kernel index [#].
   size_t                   kernel_sx;                                                               // Kernel dimension "x" [#].
   size_t                   kernel_sy;                                                               // Kernel dimension "y" [#].
   size_t                   kernel_sz;                                                               // Kernel dimension "z" [#].
@@ -88,16 +312,95 @@ int main ()
   // NODE KINEMATICS:
   float4G*                 position           = new float4G ();                                     // Position [m].
   float4*                  velocity           = new float4 ();                                      // Velocity [m/s].
+#if MIXED
+  float1*                  acceleration       = new float1 ();                                      // Acceleration, "half4" [m/s^2].
+#else
   float4*                  acceleration       = new float4 ();                                      // Acceleration [m/s^2].
+#endif
 
   // NODE KINEMATICS (INTERMEDIATE):
   float4*                  position_int       = new float4 ();                                      // Position (intermediate) [m].
+#if MIXED
+  float1*                  velocity_int       = new float1 ();                                      // Velocity (intermediate), "half4" [m/s].
+#else
   float4*                  velocity_int       = new float4 ();                                      // Velocity (intermediate) [m/s].
+#endif
+
+#if INTEGRATOR == BACKWARD_EULER
+  // IMPLICIT SOLVER (conjugate gradient):
+  float4*                  solution           = new float4 ();                                      // Velocity increment [m/s].
+  float4*                  residual           = new float4 ();                                      // Residual [N*s].
+  float4*                  direction          = new float4 ();                                      // Search direction [m/s].
+  float4*                  product            = new float4 ();                                      // System matrix times search direction [N*s].
+  float4*                  preconditioner     = new float4 ();                                      // Inverse Jacobi preconditioner [1/kg].
+  float1*                  partial            = new float1 ();                                      // Partial sums [#].
+  float1*                  scalars            = new float1 ();                                      // Scalars (see "CG_*" in utilities.cl) [#].
+#elif INTEGRATOR == XPBD
+  // XPBD CONSTRAINTS (one per link):
+  int1*                    edge_i             = new int1 ();                                        // Constraint 1st node [#].
+  int1*                    edge_j             = new int1 ();                                        // Constraint 2nd node [#].
+  float1*                  edge_resting       = new float1 ();                                      // Constraint resting length [m].
+  float1*                  edge_compliance    = new float1 ();                                      // Constraint compliance [s^2/kg].
+  float1*                  lambda             = new float1 ();                                      // Constraint Lagrange multiplier [kg*m/s^2].
+  std::vector<int1*>       batch;                                                                   // Colour batch offsets [#].
+  size_t                   edges;                                                                   // Number of constraints [#].
+  size_t                   colours;                                                                 // Number of colours [#].
+  size_t                   colour;                                                                  // Colour index [#].
+  size_t                   e;                                                                       // Constraint index [#].
+  std::vector<size_t>      link_i;                                                                  // Constraint 1st node (unsorted) [#].
+  std::vector<size_t>      link_j;                                                                  // Constraint 2nd node (unsorted) [#].
+  std::vector<float>       link_resting;                                                            // Constraint resting length (unsorted) [m].
+  std::vector<float>       link_stiffness;                                                          // Constraint stiffness (unsorted) [kg/s^2].
+  std::vector<size_t>      link_colour;                                                             // Constraint colour [#].
+  std::vector<std::vector<size_t>> node_colours;                                                    // Colours of the constraints of each node [#].
+  std::vector<size_t>      colour_offset;                                                           // Colour batch offsets (sorted constraints) [#].
+  std::vector<size_t>      colour_fill;                                                             // Colour batch fill counters [#].
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  // DYNAMIC RELAXATION:
+  float4*                  dr_partial         = new float4 ();                                      // Partial sums (kinetic energy, residual^2, load^2).
+  float1*                  dr_scalars         = new float1 ();                                      // Scalars (see "DR_*" in utilities.cl) [#].
+#endif
+#if SELL
+  // SELL-C-SIGMA NEIGHBOUR LAYOUT:
+  int32_buffer<float1>*    sell_row           = new int32_buffer<float1> ();                        // Sorted row (node index, # of neighbours) [#].
+  int32_buffer<float1>*    sell_chunk         = new int32_buffer<float1> ();                        // Chunk offset [#].
+  int32_buffer<float1>*    sell_nearest       = new int32_buffer<float1> ();                        // Neighbour (SELL slots) [#].
+  bool                     sell;                                                                    // SELL-C-sigma layout flag (fill >= SELL_FILL).
+  float                    fill;                                                                    // SELL-C-sigma fill (# of links/# of slots) [-].
+  size_t                   rows;                                                                    // Number of rows (nodes) [#].
+  size_t                   chunks;                                                                  // Number of chunks [#].
+  size_t                   slots;                                                                   // Number of slots, padding included [#].
+  size_t                   width;                                                                   // Chunk width (max # of neighbours) [#].
+  size_t                   r;                                                                       // Row index [#].
+  size_t                   c;                                                                       // Chunk index [#].
+  std::vector<size_t>      row_node;                                                                // Node of each sorted row [#].
+  std::vector<size_t>      degree;                                                                  // # of neighbours of each node [#].
+  std::vector<size_t>      chunk_offset;                                                            // Chunk offsets [#].
+  std::vector<size_t>      link_slot;                                                               // SELL slot of each CSR link [#].
+#endif
+#if EDGE
+  // EDGE-BASED FORCES (one per link):
+  int1*                    edge_i             = new int1 ();                                        // Edge 1st node [#].
+  int1*                    edge_j             = new int1 ();                                        // Edge 2nd node [#].
+  int1*                    edge_link          = new int1 ();                                        // Edge link (neighbour tuple) index [#].
+  int1*                    link_edge          = new int1 ();                                        // Link edge index (< 0 = reversed) [#].
+  float4*                  edge_force         = new float4 ();                                      // Edge force (on 1st node) [N].
+  size_t                   edges;                                                                   // Number of edges [#].
+  size_t                   e;                                                                       // Edge index [#].
+  std::vector<size_t>      link_i;                                                                  // Edge 1st node [#].
+  std::vector<size_t>      link_j;                                                                  // Edge 2nd node [#].
+  std::vector<size_t>      link_index;                                                              // Edge link index [#].
+#endif
 
   // NODE DYNAMICS:
   float4*                  gravity            = new float4 ();                                      // Gravity [m/s^2].
-  float1*                  stiffness          = new float1 ();                                      // Stiffness.
-  float1*                  resting            = new float1 ();                                      // Resting.
+  float1*                  stiffness          = new float1 ();                                      // Stiffness (MIXED: 2 "half" per element).
+  float1*                  resting            = new float1 ();                                      // Resting (MIXED: 2 "half" per element).
+#if MIXED
+  cl_half                  history[4];                                                              // "half4" history vector.
+  cl_half                  link_resting_half;                                                       // "half" link resting length [m].
+  cl_half                  link_stiffness_half;                                                     // "half" link stiffness.
+#endif
   float1*                  friction           = new float1 ();                                      // Friction.
   float1*                  mass               = new float1 ();                                      // Mass [kg].
 
@@ -106,9 +409,26 @@ int main ()
   size_t                   nodes;                                                                   // Number of nodes.
   size_t                   elements;                                                                // Number of elements.
   size_t                   neighbours;                                                              // Number of neighbours.
+  size_t                   link_slots;                                                              // Number of link resting/stiffness slots (CSR links or SELL slots).
   size_t                   border_nodes;                                                            // Number of border nodes.
-  std::vector<size_t>      neighbourhood;                                                           // Neighbourhood.
-  std::vector<size_t>      neighbour;                                                               // Neighbour tuple.
+  std::vector<cl_uint>     mesh_offset;                                                             // Neighbour stride start (original indexes) [#].
+  std::vector<cl_uint>     mesh_nearest;                                                            // Neighbour indexes (original indexes) [#].
+  std::vector<float>       mesh_length;                                                             // Link lengths (original indexes) [m].
+  std::string              mesh_file          = std::string (GMSH_HOME) + std::string (GMSH_MESH);  // Mesh file.
+  std::map<std::pair<long, long>, std::vector<size_t> > mesh_physical;                              // Physical group nodes ("dim, tag").
+  std::chrono::steady_clock::time_point mesh_start;                                                 // Mesh parser start time.
+  double                   mesh_seconds;                                                            // Mesh parser time [s].
+  double                   mesh_megabytes;                                                          // Mesh file size [MB].
+  bool                     mesh_stl;                                                                // STL mesh flag.
+#if MESH_CACHE
+  bool                     mesh_cached;                                                             // Mesh cache hit flag.
+  bool                     mesh_saved         = false;                                              // Mesh cache written flag.
+#endif
+  std::vector<size_t>      original;                                                                // Original (gmsh) index of each node [#].
+  std::vector<size_t>      renumber;                                                                // New index of each original node [#].
+  size_t                   bandwidth_gmsh;                                                          // Bandwidth of the gmsh numbering [#].
+  std::vector<cl_uint>     neighbour;                                                               // Neighbour tuple (32-bit).
+  std::vector<float>       link_length;                                                             // Link length of the neighbour tuple [m].
   std::vector<size_t>      border;                                                                  // Nodes on border.
   std::vector<size_t>      side_x;                                                                  // Nodes on "x" side.
   std::vector<size_t>      side_y;                                                                  // Nodes on "y" side.
@@ -120,12 +440,9 @@ int main ()
   size_t                   side_y_nodes;                                                            // Number of nodes in "x" direction [#].
   float                    dx;                                                                      // x-axis mesh spatial size [m].
   float                    dy;                                                                      // y-axis mesh spatial size [m].
-  float                    link_x;                                                                  // Link "x" component...
-  float                    link_y;                                                                  // Link "y" component...
-  float                    link_z;                                                                  // Link "z" component...
   int1*                    freedom            = new int1 ();                                        // Freedom.
-  int1*                    nearest            = new int1 ();                                        // Neighbour.
-  int1*                    offset             = new int1 ();                                        // Offset.
+  int32_buffer<float1>*    nearest            = new int32_buffer<float1> ();                        // Neighbour.
+  int32_buffer<float1>*    offset             = new int32_buffer<float1> ();                        // Offset.
 
   // SIMULATION PARAMETERS:
   float                    h                  = 0.01f;                                              // Cloth's thickness [m].
@@ -141,27 +458,169 @@ int main ()
   float                    dt_critical;                                                             // Critical time step [s].
   float                    dt_simulation;                                                           // Simulation time step [s].
   float1*                  dt                 = new float1 ();                                      // Time step [s].
+#if ADAPTIVE
+  float4*                  dt_partial         = new float4 ();                                      // Time step partial maxima (speed, acceleration, strain rate).
+  float1*                  dt_limits          = new float1 ();                                      // Time step limits (see "DT_*" in utilities.cl).
+#endif
+  int                      substep;                                                                 // Substep index [#].
+  int                      time_step_index    = 0;                                                  // Time step index [#].
+#if CHECK_STEPS > 0
+  float                    x_ref;                                                                   // Reference "x" position [m].
+  float                    y_ref;                                                                   // Reference "y" position [m].
+  float                    z_ref;                                                                   // Reference "z" position [m].
+  float                    error;                                                                   // Position error [m].
+  float                    error_max;                                                               // Maximum position error [m].
+  double                   error_rms;                                                               // RMS position error [m].
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   ///////////////////////////////////////// DATA INITIALIZATION //////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   // MESH:
-  object->init (bas, std::string (GMSH_HOME) + std::string (GMSH_MESH));                            // Initializing object mesh...
+#if MESH_CACHE
+  mesh_cached        = mesh_cache_load (
+                                        mesh_file + ".cache",                                       // Cache file.
+                                        mesh_file,                                                  // Mesh file.
+                                        object,                                                     // Mesh object.
+                                        border,                                                     // Nodes on border.
+                                        side_x,                                                     // Nodes on "x" side.
+                                        side_y,                                                     // Nodes on "y" side.
+                                        mesh_offset,                                                // Neighbour stride start.
+                                        mesh_nearest,                                               // Neighbour indexes.
+                                        mesh_length                                                 // Link lengths.
+                                       );                                                           // Loading mesh cache...
+
+  if(!mesh_cached)
+  {
+#endif
+  mesh_start         = std::chrono::steady_clock::now ();                                           // Starting mesh parser timer...
+  mesh_stl           = (mesh_file.size () > 4) &&
+                       ((mesh_file.substr (mesh_file.size () - 4) == ".stl") ||
+                        (mesh_file.substr (mesh_file.size () - 4) == ".STL"));                      // Checking STL extension...
+
+  if(mesh_stl ? stl_parse (mesh_file, object) : msh_parse (mesh_file, object, mesh_physical))
+  {
+    if(mesh_stl)
+    {
+      mesh_physical[std::make_pair (1, 1)] = mesh_open_boundary (object);                           // Anchoring the open boundary (no STL physical groups)...
+    }
+
+    mesh_seconds   = std::chrono::duration<double> (std::chrono::steady_clock::now () - mesh_start).count ();
+    mesh_megabytes = std::ifstream (mesh_file, std::ios::binary | std::ios::ate).tellg ()/1.0E6;    // Getting mesh file size...
+    border         = mesh_physical[std::make_pair (1, 1)];                                          // Getting nodes on border...
+    side_x         = mesh_physical[std::make_pair (1, 2)];                                          // Getting nodes on side_x...
+    side_y         = mesh_physical[std::make_pair (1, 3)];                                          // Getting nodes on side_y...
+    std::cout << "Mesh parser: " << mesh_megabytes << " MB in " << mesh_seconds << " s ("
+              << mesh_megabytes/mesh_seconds << " MB/s)" << std::endl;
+  }
+  else
+  {
+    object->init (bas, mesh_file);                                                                  // Initializing object mesh (gmsh)...
+    border         = object->physical (1, 1);                                                       // Getting nodes on border...
+    side_x         = object->physical (1, 2);                                                       // Getting nodes on side_x...
+    side_y         = object->physical (1, 3);                                                       // Getting nodes on side_y...
+  }
+
+  // BUILDING MESH ADJACENCY (from the elements, original indexes):
+  mesh_adjacency (object, mesh_offset, mesh_nearest);                                               // Building mesh adjacency...
+  mesh_lengths (object, mesh_offset, mesh_nearest, mesh_length);                                    // Computing link lengths...
+#if MESH_CACHE
+  mesh_saved         = mesh_cache_save (
+                                        mesh_file + ".cache",                                       // Cache file.
+                                        mesh_file,                                                  // Mesh file.
+                                        object,                                                     // Mesh object.
+                                        border,                                                     // Nodes on border.
+                                        side_x,                                                     // Nodes on "x" side.
+                                        side_y,                                                     // Nodes on "y" side.
+                                        mesh_offset,                                                // Neighbour stride start.
+                                        mesh_nearest,                                               // Neighbour indexes.
+                                        mesh_length                                                 // Link lengths.
+                                       );                                                           // Saving mesh cache...
+  }
+
+  if(mesh_cached || mesh_saved)
+  {
+    std::cout << "Mesh cache: " << (mesh_cached ? "loaded " : "saved ") << mesh_file << ".cache" << std::endl;
+  }
+  else
+  {
+    std::cerr << "Warning: could not write the mesh cache " << mesh_file << ".cache" << std::endl;
+  }
+#endif
   nodes              = object->node.size ();                                                        // Getting number of nodes...
   elements           = object->element.size ();                                                     // Getting number of elements...
-  border             = object->physical (1, 1);                                                     // Getting nodes on border...
-  side_x             = object->physical (1, 2);                                                     // Getting nodes on side_x...
-  side_y             = object->physical (1, 3);                                                     // Getting nodes on side_y...
   border_nodes       = border.size ();                                                              // Getting number of nodes on border...
   side_x_nodes       = side_x.size ();                                                              // Getting number of nodes on side_x...
   side_y_nodes       = side_y.size ();                                                              // Getting number of nodes on side_y...
-  dx                 = (x_max - x_min)/(side_x_nodes - 1);                                          // x-axis mesh spatial size [m].
-  dy                 = (y_max - y_min)/(side_y_nodes - 1);                                          // y-axis mesh spatial size [m].
+
+  if(border_nodes == 0)
+  {
+    std::cerr << "Warning: the mesh has no border nodes, the cloth is not anchored." << std::endl;
+  }
+
+  // RENUMBERING NODES:
+  for(i = 0; i < nodes; i++)
+  {
+    original.push_back (i);                                                                         // Setting gmsh order...
+  }
+
+  bandwidth_gmsh = bandwidth (mesh_offset, mesh_nearest, original);                                 // Computing gmsh numbering bandwidth...
+
+#if RENUMBER == RENUMBER_RCM
+  original = rcm_order (mesh_offset, mesh_nearest);                                                 // Ordering nodes by reverse Cuthill-McKee...
+#elif RENUMBER == RENUMBER_HILBERT
+  original = hilbert_order (object);                                                                // Ordering nodes along a Hilbert curve...
+#endif
+
+  renumber.resize (nodes);                                                                          // Initializing new node indexes...
+
+  for(i = 0; i < nodes; i++)
+  {
+    renumber[original[i]] = i;                                                                      // Inverting node order...
+  }
+
+#if RENUMBER != RENUMBER_NONE
+  std::cout << "Node bandwidth: gmsh = " << bandwidth_gmsh << ", renumbered = " << bandwidth (mesh_offset, mesh_nearest, renumber)
+            << std::endl;
+
+  std::ofstream renumbering (RENUMBER_FILE);                                                        // Node index mapping output file.
+
+  for(i = 0; i < nodes; i++)
+  {
+    renumbering << i << " " << original[i] << "\n";                                                 // Writing new and original node index...
+  }
+#endif
+
+  if((side_x_nodes > 1) && (side_y_nodes > 1))
+  {
+    dx               = (x_max - x_min)/(side_x_nodes - 1);                                          // x-axis mesh spatial size [m].
+    dy               = (y_max - y_min)/(side_y_nodes - 1);                                          // y-axis mesh spatial size [m].
+  }
+  else
+  {
+    dx               = 0.0f;                                                                        // Resetting mesh spatial size...
+
+    for(i = 0; i < mesh_length.size (); i++)
+    {
+      dx            += mesh_length[i]/mesh_length.size ();                                          // Averaging link length (no "side" groups, e.g. STL)...
+    }
+
+    dy               = dx;                                                                          // y-axis mesh spatial size [m].
+  }
+
   m                  = rho*h*dx*dy;                                                                 // Node mass [kg].
   K                  = E*h*dy/dx;                                                                   // Elastic constant [kg/s^2].
   B                  = mu*h*dx*dy;                                                                  // Damping [kg*s*m].
   dt_critical        = sqrt (m/K);                                                                  // Critical time step [s].
+#if INTEGRATOR == BACKWARD_EULER
+  dt_simulation      = IMPLICIT_DT*dt_critical;                                                     // Simulation time step [s].
+#elif INTEGRATOR == XPBD
+  dt_simulation      = XPBD_DT*dt_critical;                                                         // Simulation time step [s].
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  dt_simulation      = dt_critical;                                                                 // Fictitious time step [s].
+#else
   dt_simulation      = 0.5*dt_critical;                                                             // Simulation time step [s].
+#endif
 
   // SETTING KERNEL DIMENSIONS:
   kernel_sx          = nodes;                                                                       // Setting OpenCL kernel "x" dimension...
@@ -184,12 +643,53 @@ int main ()
   position->init (nodes);                                                                           // Initializing position data...
   position_int->init (nodes);                                                                       // Initializing intermediate position data...
   velocity->init (nodes);                                                                           // Initializing velocity data...
-  velocity_int->init (nodes);                                                                       // Initializing intermediate position data...
-  acceleration->init (nodes);                                                                       // Initializing acceleration data...
+  velocity_int->init (HISTORY_SIZE*nodes);                                                          // Initializing intermediate velocity data...
+  acceleration->init (HISTORY_SIZE*nodes);                                                          // Initializing acceleration data...
   mass->init (nodes);                                                                               // Initializing mass data...
   offset->init (nodes);                                                                             // Initializing node offset...
   freedom->init (nodes);                                                                            // Initializing freedom...
 
+#if INTEGRATOR == BACKWARD_EULER
+  cg_groups          = std::min<size_t> (CG_GROUPS, nodes);                                         // Setting # of CG reduction work-items...
+  solution->init (nodes);                                                                           // Initializing CG solution data...
+  residual->init (nodes);                                                                           // Initializing CG residual data...
+  direction->init (nodes);                                                                          // Initializing CG search direction data...
+  product->init (nodes);                                                                            // Initializing CG matrix product data...
+  preconditioner->init (nodes);                                                                     // Initializing CG preconditioner data...
+  partial->init (cg_groups);                                                                        // Initializing CG partial sums...
+  scalars->init (9);                                                                                // Initializing CG scalars...
+  scalars->data[5] = CG_TOLERANCE;                                                                  // Setting CG relative tolerance ("CG_TOL")...
+  scalars->data[7] = cg_groups;                                                                     // Setting # of CG partial sums ("CG_GROUPS")...
+  scalars->data[8] = nodes;                                                                         // Setting # of nodes ("CG_NODES")...
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  dr_groups          = std::min<size_t> (DR_GROUPS, nodes);                                         // Setting # of DR reduction work-items...
+  dr_partial->init (dr_groups);                                                                     // Initializing DR partial sums...
+  dr_scalars->init (10);                                                                            // Initializing DR scalars...
+  dr_scalars->data[0] = 0.0f;                                                                       // Resetting kinetic energy ("DR_KE") [J]...
+  dr_scalars->data[1] = 0.0f;                                                                       // Resetting kinetic energy peak flag ("DR_RESET")...
+  dr_scalars->data[2] = 1.0f;                                                                       // Resetting relative residual force ("DR_RESIDUAL")...
+  dr_scalars->data[3] = 0.0f;                                                                       // Resetting convergence flag ("DR_DONE")...
+  dr_scalars->data[4] = 0.0f;                                                                       // Resetting # of relaxation steps ("DR_STEPS")...
+  dr_scalars->data[5] = 0.0f;                                                                       // Resetting # of kinetic energy peaks ("DR_PEAKS")...
+  dr_scalars->data[6] = DR_TOLERANCE;                                                               // Setting relative residual tolerance ("DR_TOL")...
+  dr_scalars->data[7] = DR_MASS_SCALE;                                                              // Setting fictitious mass scale factor ("DR_MASS")...
+  dr_scalars->data[8] = dr_groups;                                                                  // Setting # of DR partial sums ("DR_GROUPS")...
+  dr_scalars->data[9] = nodes;                                                                      // Setting # of nodes ("DR_NODES")...
+#endif
+
+#if ADAPTIVE
+  dt_groups          = std::min<size_t> (DT_GROUPS, nodes);                                         // Setting # of time step reduction work-items...
+  dt_partial->init (dt_groups);                                                                     // Initializing time step partial maxima...
+  dt_limits->init (7);                                                                              // Initializing time step limits...
+  dt_limits->data[0] = DT_MIN*dt_critical;                                                          // Setting minimum time step ("DT_MIN") [s]...
+  dt_limits->data[1] = DT_MAX*dt_critical;                                                          // Setting maximum time step ("DT_MAX") [s]...
+  dt_limits->data[2] = std::min (dx, dy);                                                           // Setting mesh size ("DT_LENGTH") [m]...
+  dt_limits->data[3] = DT_CFL;                                                                      // Setting maximum travel and strain per step ("DT_CFL")...
+  dt_limits->data[4] = DT_GROWTH;                                                                   // Setting maximum time step growth ("DT_GROWTH")...
+  dt_limits->data[5] = dt_groups;                                                                   // Setting # of partial maxima ("DT_GROUPS")...
+  dt_limits->data[6] = nodes;                                                                       // Setting # of nodes ("DT_NODES")...
+#endif
+
   for(i = 0; i < nodes; i++)
   {
     color->data[i].x        = 0.01f*(rand () % 100);                                                // Setting "r" color coordinate...
@@ -197,48 +697,159 @@ int main ()
     color->data[i].z        = 0.01f*(rand () % 100);                                                // Setting "b" color coordinate...
     color->data[i].w        = 1.0f;                                                                 // Setting "a" color coordinate...
 
-    position->data[i].x     = object->node[i].x;                                                    // Setting "x" position...
-    position->data[i].y     = object->node[i].y;                                                    // Setting "y" position...
-    position->data[i].z     = object->node[i].z;                                                    // Setting "z" position...
-    position->data[i].w     = object->node[i].w;                                                    // Setting "w" position...
+    position->data[i].x     = object->node[original[i]].x;                                          // Setting "x" position...
+    position->data[i].y     = object->node[original[i]].y;                                          // Setting "y" position...
+    position->data[i].z     = object->node[original[i]].z;                                          // Setting "z" position...
+    position->data[i].w     = object->node[original[i]].w;                                          // Setting "w" position...
 
     velocity->data[i].x     = 0.0f;                                                                 // Setting "x" velocity...
     velocity->data[i].y     = 0.0f;                                                                 // Setting "y" velocity...
     velocity->data[i].z     = 0.0f;                                                                 // Setting "z" velocity...
     velocity->data[i].w     = 1.0f;                                                                 // Setting "w" velocity...
 
+#if MIXED
+    history[0]              = float_to_half (0.0f);                                                 // Setting "x" acceleration...
+    history[1]              = float_to_half (0.0f);                                                 // Setting "y" acceleration...
+    history[2]              = float_to_half (-g);                                                   // Setting "z" acceleration...
+    history[3]              = float_to_half (1.0f);                                                 // Setting "w" acceleration...
+    std::memcpy (&acceleration->data[HISTORY_SIZE*i], history, sizeof (history));                   // Packing acceleration...
+#else
     acceleration->data[i].x = 0.0f;                                                                 // Setting "x" acceleration...
     acceleration->data[i].y = 0.0f;                                                                 // Setting "y" acceleration...
     acceleration->data[i].z = -g;                                                                   // Setting "z" acceleration...
     acceleration->data[i].w = 1.0f;                                                                 // Setting "w" acceleration...
+#endif
 
     mass->data[i]           = m;                                                                    // Setting "x" mass...
     freedom->data[i]        = 1;                                                                    // Setting freedom flag...
   }
 
-  // COMPUTING TOTAL NUMBER OF NEIGHBOURS:
+  // COMPUTING NEIGHBOUR OFFSETS (prefix sum, new numbering):
   neighbours = 0;                                                                                   // Resetting number of neighbours...
 
   for(i = 0; i < nodes; i++)
   {
-    neighbourhood   = object->neighbours (i);                                                       // Getting neighbourhood...
-    neighbours     += neighbourhood.size ();                                                        // Accumulating number of neighbours...
-    offset->data[i] = neighbours;                                                                   // Setting neighbour offset...
+    neighbours     += mesh_offset[original[i] + 1] - mesh_offset[original[i]];                      // Accumulating number of neighbours...
+    offset->set (i, neighbours);                                                                    // Setting neighbour offset...
+  }
+
+  // ASSEMBLING NEIGHBOUR TUPLE AND LINK LENGTHS (new numbering, in parallel):
+  neighbour.resize (neighbours);                                                                    // Initializing neighbour tuple...
+  link_length.resize (neighbours);                                                                  // Initializing link lengths...
 
-    for(j = 0; j < neighbourhood.size (); j++)
+  parallel_for (nodes, [&](size_t first, size_t last)
+  {
+    std::vector<std::pair<cl_uint, float> > stride;                                                 // Neighbour stride (new index, link length).
+    size_t                 stride_min;                                                              // Neighbour stride minimum [#].
+    size_t                 q;                                                                       // Neighbour tuple index [#].
+
+    for(size_t n = first; n < last; n++)
     {
-      neighbour.push_back (neighbourhood[j]);                                                       // Assembling neighbour tuple...
+      stride_min = (n == 0) ? 0 : offset->get (n - 1);                                              // Setting stride minimum...
+      stride.clear ();                                                                              // Resetting neighbour stride...
+
+      for(q = mesh_offset[original[n]]; q < mesh_offset[original[n] + 1]; q++)
+      {
+        stride.push_back (std::make_pair ((cl_uint)renumber[mesh_nearest[q]], mesh_length[q]));     // Renumbering neighbour...
+      }
+
+      std::sort (stride.begin (), stride.end ());                                                   // Sorting neighbours (ascending memory order)...
+
+      for(q = 0; q < stride.size (); q++)
+      {
+        neighbour[stride_min + q]   = stride[q].first;                                              // Setting neighbour...
+        link_length[stride_min + q] = stride[q].second;                                             // Setting link length...
+      }
     }
+  });
+
+  link_slots = neighbours;                                                                          // Setting number of link slots (CSR)...
+
+#if SELL
+  // BUILDING SELL-C-SIGMA LAYOUT (rows sorted by # of neighbours within windows, slots interleaved by chunk):
+  rows   = nodes;                                                                                   // Setting number of rows...
+  chunks = (rows + SELL_C - 1)/SELL_C;                                                              // Setting number of chunks...
+
+  for(i = 0; i < nodes; i++)
+  {
+    degree.push_back (offset->get (i) - ((i == 0) ? 0 : offset->get (i - 1)));                      // Setting # of neighbours...
+    row_node.push_back (i);                                                                         // Setting row node (unsorted)...
+  }
+
+  for(r = 0; r < rows; r += SELL_SIGMA)
+  {
+    std::stable_sort (
+                      row_node.begin () + r,                                                        // Window begin.
+                      row_node.begin () + std::min<size_t> (r + SELL_SIGMA, rows),                  // Window end.
+                      [&degree](size_t a, size_t b) {return degree[a] > degree[b];}                 // Decreasing # of neighbours.
+                     );
+  }
+
+  slots = 0;                                                                                        // Resetting number of slots...
+
+  for(c = 0; c < chunks; c++)
+  {
+    width = 0;                                                                                      // Resetting chunk width...
+
+    for(r = c*SELL_C; r < std::min<size_t> ((c + 1)*SELL_C, rows); r++)
+    {
+      width = std::max (width, degree[row_node[r]]);                                                // Updating chunk width...
+    }
+
+    chunk_offset.push_back (slots);                                                                 // Setting chunk offset...
+    slots += SELL_C*width;                                                                          // Accumulating number of slots...
   }
 
+  // CHOOSING NEIGHBOUR LAYOUT (padding of the degree distribution):
+  fill = (float)neighbours/slots;                                                                   // Computing SELL-C-sigma fill...
+  sell = (fill >= SELL_FILL);                                                                       // Choosing SELL-C-sigma layout...
+  std::cout << "SELL-" << SELL_C << "-" << SELL_SIGMA << " slots = " << slots << ", links = " << neighbours
+            << " (fill = " << fill << "): " << (sell ? "SELL-C-sigma" : "CSR") << " layout" << std::endl;
+
+  if(sell)
+  {
+    link_slots = slots;                                                                             // Setting number of link slots (SELL)...
+    link_slot.resize (neighbours);                                                                  // Initializing link slots...
+    sell_row->init (2*rows);                                                                        // Initializing sorted rows...
+    sell_chunk->init (chunks);                                                                      // Initializing chunk offsets...
+    sell_nearest->init (slots);                                                                     // Initializing neighbour slots...
+
+    for(r = 0; r < rows; r++)
+    {
+      i     = row_node[r];                                                                          // Getting row node...
+      j_min = offset->get (i) - degree[i];                                                          // Setting stride minimum...
+      j_max = offset->get (i);                                                                      // Setting stride maximum...
+
+      for(j = j_min; j < j_max; j++)
+      {
+        link_slot[j] = chunk_offset[r/SELL_C] + r%SELL_C + SELL_C*(j - j_min);                      // Setting link slot...
+        sell_nearest->set (link_slot[j], neighbour[j]);                                             // Setting neighbour index...
+      }
+
+      sell_row->set (2*r, i);                                                                       // Setting row node index...
+      sell_row->set (2*r + 1, degree[i]);                                                           // Setting row # of neighbours...
+    }
+
+    for(c = 0; c < chunks; c++)
+    {
+      sell_chunk->set (c, chunk_offset[c]);                                                         // Setting chunk offset...
+    }
+  }
+#endif
+
   // INITIALIZING NEUTRINO ARRAYS ("neighbours" depending):
   nearest->init (neighbours);                                                                       // Initializing neighbour data...
-  resting->init (neighbours);                                                                       // Initializing resting position data...
-  stiffness->init (neighbours);                                                                     // Initializing stiffness data...
+#if MIXED
+  resting->init ((link_slots + 1)/2);                                                               // Initializing resting position data ("half")...
+  stiffness->init ((link_slots + 1)/2);                                                             // Initializing stiffness data ("half")...
+#else
+  resting->init (link_slots);                                                                       // Initializing resting position data...
+  stiffness->init (link_slots);                                                                     // Initializing stiffness data...
+#endif
 
   for(i = 0; i < nodes; i++)
   {
-    j_max = offset->data[i];                                                                        // Setting stride maximum...
+    j_max = offset->get (i);                                                                        // Setting stride maximum...
 
     if(i == 0)
     {
@@ -246,31 +857,201 @@ int main ()
     }
     else
     {
-      j_min = offset->data[i - 1];                                                                  // Setting stride minimum (all others)...
+      j_min = offset->get (i - 1);                                                                  // Setting stride minimum (all others)...
     }
 
     for(j = j_min; j < j_max; j++)
     {
-      nearest->data[j]   = neighbour[j];                                                            // Setting neighbour tuple data...
-      k                  = nearest->data[j];                                                        // Getting neighbour index...
-      link_x             = position->data[k].x - position->data[i].x;                               // Computing link "x" component...
-      link_y             = position->data[k].y - position->data[i].y;                               // Computing link "y" component...
-      link_z             = position->data[k].z - position->data[i].z;                               // Computing link "z" component...
-      resting->data[j]   = sqrt (pow (link_x, 2) + pow (link_y, 2) + pow (link_z, 2));              // Computing resting distace...
-      stiffness->data[j] = K;                                                                       // Setting stiffness...
+      nearest->set (j, neighbour[j]);                                                               // Setting neighbour tuple data...
+      l                  = j;                                                                       // Setting link storage index (CSR)...
+#if SELL
+      if(sell)
+      {
+        l                = link_slot[j];                                                            // Setting link storage index (SELL slot)...
+      }
+#endif
+#if MIXED
+      link_resting_half   = float_to_half (link_length[j]);                                         // Setting resting distance...
+      link_stiffness_half = float_to_half (K);                                                      // Setting stiffness...
+      std::memcpy ((cl_half*)&resting->data[0] + l, &link_resting_half, sizeof (cl_half));          // Packing resting distance...
+      std::memcpy ((cl_half*)&stiffness->data[0] + l, &link_stiffness_half, sizeof (cl_half));      // Packing stiffness...
+#else
+      resting->data[l]   = link_length[j];                                                          // Setting resting distace...
+      stiffness->data[l] = K;                                                                       // Setting stiffness...
+#endif
     }
   }
 
   // ANCHORING BORDER NODES:
-  for(int i = 0; i < border_nodes; i++)
+  for(i = 0; i < border_nodes; i++)
+  {
+    freedom->data[renumber[border[i]]] = 0;                                                         // Retting freedom flag...
+  }
+
+#if EDGE
+  // BUILDING EDGES (each link is stored twice in the neighbour tuple, its force is computed once):
+  link_edge->init (neighbours);                                                                     // Initializing link edge indexes...
+
+  for(i = 0; i < nodes; i++)
+  {
+    j_max = offset->get (i);                                                                        // Setting stride maximum...
+
+    if(i == 0)
+    {
+      j_min = 0;                                                                                    // Setting stride minimum (first stride)...
+    }
+    else
+    {
+      j_min = offset->get (i - 1);                                                                  // Setting stride minimum (all others)...
+    }
+
+    for(j = j_min; j < j_max; j++)
+    {
+      k                  = nearest->get (j);                                                        // Getting neighbour index...
+      link_edge->data[j] = link_i.size ();                                                          // Setting link edge index (new edge)...
+
+      if(k < i)
+      {
+        for(l = (k == 0) ? 0 : offset->get (k - 1); l < (size_t)offset->get (k); l++)
+        {
+          if((size_t)nearest->get (l) == i)
+          {
+            link_edge->data[j] = -1 - link_edge->data[l];                                           // Setting link edge index (reversed)...
+          }
+        }
+      }
+
+      if(link_edge->data[j] >= 0)
+      {
+        link_i.push_back (i);                                                                       // Setting edge 1st node...
+        link_j.push_back (k);                                                                       // Setting edge 2nd node...
+        link_index.push_back (j);                                                                   // Setting edge link index...
+      }
+    }
+  }
+
+  edges = link_i.size ();                                                                           // Getting number of edges...
+  edge_i->init (edges);                                                                             // Initializing edge 1st node...
+  edge_j->init (edges);                                                                             // Initializing edge 2nd node...
+  edge_link->init (edges);                                                                          // Initializing edge link index...
+  edge_force->init (edges);                                                                         // Initializing edge force...
+
+  for(e = 0; e < edges; e++)
+  {
+    edge_i->data[e]    = link_i[e];                                                                 // Setting edge 1st node...
+    edge_j->data[e]    = link_j[e];                                                                 // Setting edge 2nd node...
+    edge_link->data[e] = link_index[e];                                                             // Setting edge link index...
+  }
+
+  std::cout << "Edges = " << edges << ", links = " << neighbours << std::endl;
+#endif
+
+#if INTEGRATOR == XPBD
+  // BUILDING CONSTRAINTS (each link is stored twice in the neighbour tuple):
+  for(i = 0; i < nodes; i++)
+  {
+    j_max = offset->get (i);                                                                        // Setting stride maximum...
+
+    if(i == 0)
+    {
+      j_min = 0;                                                                                    // Setting stride minimum (first stride)...
+    }
+    else
+    {
+      j_min = offset->get (i - 1);                                                                  // Setting stride minimum (all others)...
+    }
+
+    for(j = j_min; j < j_max; j++)
+    {
+      k = nearest->get (j);                                                                         // Getting neighbour index...
+
+      if(i < k)
+      {
+        link_i.push_back (i);                                                                       // Setting constraint 1st node...
+        link_j.push_back (k);                                                                       // Setting constraint 2nd node...
+        link_resting.push_back (resting->data[j]);                                                  // Setting constraint resting length...
+        link_stiffness.push_back (stiffness->data[j]);                                              // Setting constraint stiffness...
+      }
+    }
+  }
+
+  edges = link_i.size ();                                                                           // Getting number of constraints...
+
+  // COLOURING CONSTRAINTS (greedy, no two constraints of the same colour share a node):
+  node_colours.resize (nodes);                                                                      // Initializing node colours...
+  link_colour.resize (edges);                                                                       // Initializing constraint colours...
+  colours = 0;                                                                                      // Resetting number of colours...
+
+  for(e = 0; e < edges; e++)
+  {
+    colour = 0;                                                                                     // Resetting colour...
+
+    while(
+          (std::find (node_colours[link_i[e]].begin (), node_colours[link_i[e]].end (), colour) !=
+           node_colours[link_i[e]].end ()) ||
+          (std::find (node_colours[link_j[e]].begin (), node_colours[link_j[e]].end (), colour) !=
+           node_colours[link_j[e]].end ())
+         )
+    {
+      colour++;                                                                                     // Trying next colour...
+    }
+
+    link_colour[e] = colour;                                                                        // Setting constraint colour...
+    node_colours[link_i[e]].push_back (colour);                                                     // Marking colour on 1st node...
+    node_colours[link_j[e]].push_back (colour);                                                     // Marking colour on 2nd node...
+    colours = std::max (colours, colour + 1);                                                       // Updating number of colours...
+  }
+
+  // SORTING CONSTRAINTS BY COLOUR (counting sort):
+  colour_offset.assign (colours + 1, 0);                                                            // Resetting colour batch offsets...
+
+  for(e = 0; e < edges; e++)
   {
-    freedom->data[i] = 0;                                                                           // Retting freedom flag...
+    colour_offset[link_colour[e] + 1]++;                                                            // Counting colour batch size...
   }
 
+  for(colour = 0; colour < colours; colour++)
+  {
+    colour_offset[colour + 1] += colour_offset[colour];                                             // Accumulating colour batch offsets...
+  }
+
+  colour_fill.assign (colour_offset.begin (), colour_offset.end () - 1);                            // Initializing colour batch fill counters...
+  edge_i->init (edges);                                                                             // Initializing constraint 1st node...
+  edge_j->init (edges);                                                                             // Initializing constraint 2nd node...
+  edge_resting->init (edges);                                                                       // Initializing constraint resting length...
+  edge_compliance->init (edges);                                                                    // Initializing constraint compliance...
+  lambda->init (edges);                                                                             // Initializing Lagrange multipliers...
+
+  for(e = 0; e < edges; e++)
+  {
+    k                           = colour_fill[link_colour[e]]++;                                    // Getting sorted constraint index...
+    edge_i->data[k]             = link_i[e];                                                        // Setting constraint 1st node...
+    edge_j->data[k]             = link_j[e];                                                        // Setting constraint 2nd node...
+    edge_resting->data[k]       = link_resting[e];                                                  // Setting constraint resting length...
+    edge_compliance->data[k]    = 1.0f/link_stiffness[e];                                           // Setting constraint compliance...
+  }
+
+  for(colour = 0; colour < colours; colour++)
+  {
+    batch.push_back (new int1 ());                                                                  // Creating colour batch offset...
+    batch[colour]->init (1);                                                                        // Initializing colour batch offset...
+    batch[colour]->data[0] = colour_offset[colour];                                                 // Setting colour batch offset...
+  }
+
+  std::cout << "XPBD constraints = " << edges << ", colours = " << colours << std::endl;
+#endif
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////// NEUTRINO INITIALIZATION /////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
-  bas->init (QUEUE_NUM, KERNEL_NUM);                                                                // Initializing Neutrino baseline...
+#if VENDOR_CACHE
+  vendor_cache (CACHE_HOME);                                                                        // Enabling vendor OpenCL program caches...
+#endif
+#if INTEGRATOR == XPBD
+  bas->init (QUEUE_NUM, KERNEL_NUM + colours + DT_KERNELS);                                         // Initializing Neutrino baseline...
+#else
+  bas->init (QUEUE_NUM, KERNEL_NUM + DT_KERNELS + EDGE_KERNELS);                                    // Initializing Neutrino baseline...
+#endif
   gui->init
   (
    bas,                                                                                             // Neutrino baseline.
@@ -287,10 +1068,191 @@ int main ()
   S->init (bas, SHADER_HOME, SHADER_VERT, SHADER_GEOM, SHADER_FRAG);                                // Initializing OpenGL shader...
   Q->init (bas);                                                                                    // Initializing OpenCL queue...
   kernel_home = KERNEL_HOME;                                                                        // Setting kernel home directory...
-  kernel_1.push_back ("thekernel1.cl");                                                             // Setting 1st source file...
+#if INTEGRATOR == BACKWARD_EULER
+  kernel_1.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_1.push_back ("backward_euler1.cl");                                                        // Setting 2nd source file...
+#elif INTEGRATOR == XPBD
+  kernel_1.push_back ("xpbd1.cl");                                                                  // Setting 1st source file...
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  kernel_1.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_1.push_back ("relaxation1.cl");                                                            // Setting 2nd source file...
+#else
+#if MIXED
+  kernel_1.push_back ("mixed.cl");                                                                  // Half precision history storage...
+#endif
+  kernel_1.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_1.push_back ("thekernel1.cl");                                                             // Setting 2nd source file...
+#endif
+#if INTEGRATOR == DYNAMIC_RELAXATION
+  K1->init (bas, kernel_home, kernel_1, dr_groups, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K1...
+#else
   K1->init (bas, kernel_home, kernel_1, kernel_sx, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K1...
-  kernel_2.push_back ("thekernel2.cl");                                                             // Setting 1st source file...
+#endif
+#if INTEGRATOR == BACKWARD_EULER
+  kernel_2.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_2.push_back ("backward_euler2.cl");                                                        // Setting 2nd source file...
+#elif INTEGRATOR == XPBD
+  kernel_2.push_back ("xpbd2.cl");                                                                  // Setting 1st source file...
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  kernel_2.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_2.push_back ("relaxation2.cl");                                                            // Setting 2nd source file...
+#else
+#if MIXED
+  kernel_2.push_back ("mixed.cl");                                                                  // Half precision history storage...
+#endif
+#if EDGE
+  kernel_2.push_back ("edge.cl");                                                                   // Edge-based forces...
+#endif
+#if SELL
+  if(sell)
+  {
+    kernel_2.push_back ("sell.cl");                                                                 // SELL-C-sigma neighbour layout...
+  }
+#endif
+  kernel_2.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_2.push_back ("thekernel2.cl");                                                             // Setting 2nd source file...
+#endif
   K2->init (bas, kernel_home, kernel_2, kernel_sx, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K2...
+#if INTEGRATOR == BACKWARD_EULER
+  kernel_3.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_3.push_back ("cg_matvec.cl");                                                              // Setting 2nd source file...
+  K3->init (bas, kernel_home, kernel_3, cg_groups, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K3...
+  kernel_4.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_4.push_back ("cg_alpha.cl");                                                               // Setting 2nd source file...
+  K4->init (bas, kernel_home, kernel_4, 1, kernel_sy, kernel_sz);                                   // Initializing OpenCL kernel K4...
+  kernel_5.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_5.push_back ("cg_update.cl");                                                              // Setting 2nd source file...
+  K5->init (bas, kernel_home, kernel_5, cg_groups, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K5...
+  kernel_6.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_6.push_back ("cg_beta.cl");                                                                // Setting 2nd source file...
+  K6->init (bas, kernel_home, kernel_6, 1, kernel_sy, kernel_sz);                                   // Initializing OpenCL kernel K6...
+  kernel_7.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_7.push_back ("cg_direction.cl");                                                           // Setting 2nd source file...
+  K7->init (bas, kernel_home, kernel_7, kernel_sx, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K7...
+#elif INTEGRATOR == XPBD
+  kernel_3.push_back ("xpbd_reset.cl");                                                             // Setting 1st source file...
+  K3->init (bas, kernel_home, kernel_3, edges, kernel_sy, kernel_sz);                               // Initializing OpenCL kernel K3...
+  kernel_4.push_back ("xpbd_constraint.cl");                                                        // Setting 1st source file...
+
+  for(colour = 0; colour < colours; colour++)
+  {
+    K_batch.push_back (new kernel ());                                                              // Creating colour batch kernel...
+    K_batch[colour]->init (
+                           bas,                                                                     // Neutrino baseline.
+                           kernel_home,                                                             // Kernel home directory.
+                           kernel_4,                                                                // Kernel source files.
+                           colour_offset[colour + 1] - colour_offset[colour],                       // Colour batch size [#].
+                           kernel_sy,                                                               // Kernel dimension "y" [#].
+                           kernel_sz                                                                // Kernel dimension "z" [#].
+                          );
+  }
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  kernel_3.push_back ("utilities.cl");                                                              // Setting 1st source file...
+  kernel_3.push_back ("relaxation_check.cl");                                                       // Setting 2nd source file...
+  K3->init (bas, kernel_home, kernel_3, 1, kernel_sy, kernel_sz);                                   // Initializing OpenCL kernel K3...
+#endif
+#if ADAPTIVE
+  kernel_dt_reduce.push_back ("utilities.cl");                                                      // Setting 1st source file...
+  kernel_dt_reduce.push_back ("dt_reduce.cl");                                                      // Setting 2nd source file...
+  K_dt_reduce->init (bas, kernel_home, kernel_dt_reduce, dt_groups, kernel_sy, kernel_sz);          // Initializing OpenCL kernel K_dt_reduce...
+  kernel_dt_control.push_back ("utilities.cl");                                                     // Setting 1st source file...
+  kernel_dt_control.push_back ("dt_control.cl");                                                    // Setting 2nd source file...
+  K_dt_control->init (bas, kernel_home, kernel_dt_control, 1, kernel_sy, kernel_sz);                // Initializing OpenCL kernel K_dt_control...
+#endif
+#if EDGE
+#if MIXED
+  kernel_edge.push_back ("mixed.cl");                                                               // Half precision history storage...
+#endif
+  kernel_edge.push_back ("edge.cl");                                                                // Edge-based forces...
+  kernel_edge.push_back ("utilities.cl");                                                           // Setting 1st source file...
+  kernel_edge.push_back ("edge_force.cl");                                                          // Setting 2nd source file...
+  K_edge->init (bas, kernel_home, kernel_edge, edges, kernel_sy, kernel_sz);                        // Initializing OpenCL kernel K_edge...
+#endif
+
+  // TIME STEP KERNEL SEQUENCE:
+#if INTEGRATOR == BACKWARD_EULER
+  step_kernels.push_back (K1);                                                                      // Right hand side, preconditioner...
+  step_kernels.push_back (K5);                                                                      // Initial residual norm...
+  step_kernels.push_back (K6);                                                                      // Initial convergence check...
+  step_kernels.push_back (K7);                                                                      // Initial search direction...
+
+  cg_kernels.push_back (K3);                                                                        // Matrix product...
+  cg_kernels.push_back (K4);                                                                        // Step length...
+  cg_kernels.push_back (K5);                                                                        // Solution and residual update...
+  cg_kernels.push_back (K6);                                                                        // Direction factor, convergence check...
+  cg_kernels.push_back (K7);                                                                        // Search direction...
+  cg_start = step_kernels.size ();                                                                  // Setting CG iterations position...
+  step_kernels.push_back (K2);                                                                      // Velocity and position update...
+#elif INTEGRATOR == XPBD
+  step_kernels.push_back (K1);                                                                      // Position prediction...
+  step_kernels.push_back (K3);                                                                      // Lagrange multiplier reset...
+
+  for(iteration = 0; iteration < XPBD_ITERATIONS; iteration++)
+  {
+    for(colour = 0; colour < colours; colour++)
+    {
+      step_kernels.push_back (K_batch[colour]);                                                     // Colour batch constraints...
+    }
+  }
+
+  step_kernels.push_back (K2);                                                                      // Velocity update...
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  step_kernels.push_back (K1);                                                                      // Residual force, trial velocity...
+  step_kernels.push_back (K3);                                                                      // Kinetic damping, convergence check...
+  step_kernels.push_back (K2);                                                                      // Position update or velocity reset...
+#else
+  step_kernels.push_back (K1);                                                                      // Setting 1st kernel of the time step...
+#if EDGE
+  step_kernels.push_back (K_edge);                                                                  // Setting edge forces of the time step...
+#endif
+  step_kernels.push_back (K2);                                                                      // Setting 2nd kernel of the time step...
+#endif
+
+#if ADAPTIVE
+  step_kernels.push_back (K_dt_reduce);                                                             // Time step partial maxima...
+  step_kernels.push_back (K_dt_control);                                                            // Next time step...
+#endif
+
+  // Enqueueing one time step, waiting for its last kernel if requested. With BACKWARD_EULER the CG
+  // iterations are enqueued in chunks of CG_CHECK: the convergence flag is read back after each chunk
+  // and no further iteration is enqueued once it is set.
+  auto enqueue_step = [&] (bool wait)
+  {
+    for(step_kernel = 0; step_kernel < step_kernels.size (); step_kernel++)
+    {
+#if INTEGRATOR == BACKWARD_EULER
+      if(step_kernel == cg_start)
+      {
+        for(iteration = 0; iteration < CG_ITERATIONS; iteration++)
+        {
+          for(kernel* K : cg_kernels)
+          {
+            ctx->execute (K, Q, NU_DONT_WAIT);                                                      // Enqueueing CG iteration kernel...
+          }
+
+          if(((iteration + 1)%CG_CHECK == 0) && ((iteration + 1) < CG_ITERATIONS))
+          {
+            Q->read (scalars, 21);                                                                  // Reading CG scalars from queue...
+
+            if(scalars->data[4] > 0.0f)                                                             // Checking convergence ("CG_DONE")...
+            {
+              break;                                                                                // Skipping the remaining iterations...
+            }
+          }
+        }
+      }
+
+#endif
+      if(wait && (step_kernel == step_kernels.size () - 1))
+      {
+        ctx->execute (step_kernels[step_kernel], Q, NU_WAIT);                                       // Executing last OpenCL kernel...
+      }
+      else
+      {
+        ctx->execute (step_kernels[step_kernel], Q, NU_DONT_WAIT);                                  // Enqueueing OpenCL kernel...
+      }
+    }
+  };
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////// SETTING OPENCL KERNEL ARGUMENTS /////////////////////////////////
@@ -327,6 +1289,174 @@ int main ()
   K2->setarg (freedom, 13);                                                                         // Setting freedom flag kernel argument...
   K2->setarg (dt, 14);                                                                              // Setting time step kernel argument...
 
+#if INTEGRATOR == BACKWARD_EULER
+  for(kernel* K : {K3, K4, K5, K6, K7})
+  {
+    K->setarg (color, 0);                                                                           // Setting color kernel argument...
+    K->setarg (position, 1);                                                                        // Setting position kernel argument...
+    K->setarg (position_int, 2);                                                                    // Setting intermediate position kernel argument...
+    K->setarg (velocity, 3);                                                                        // Setting velocity kernel argument...
+    K->setarg (velocity_int, 4);                                                                    // Setting intermediate velocity kernel argument...
+    K->setarg (acceleration, 5);                                                                    // Setting acceleration kernel argument...
+    K->setarg (gravity, 6);                                                                         // Setting gravity kernel argument...
+    K->setarg (stiffness, 7);                                                                       // Setting stiffness kernel argument...
+    K->setarg (resting, 8);                                                                         // Setting resting position kernel argument...
+    K->setarg (friction, 9);                                                                        // Setting friction kernel argument...
+    K->setarg (mass, 10);                                                                           // Setting mass kernel argument...
+    K->setarg (nearest, 11);                                                                        // Setting neighbour kernel argument...
+    K->setarg (offset, 12);                                                                         // Setting offset kernel argument...
+    K->setarg (freedom, 13);                                                                        // Setting freedom flag kernel argument...
+    K->setarg (dt, 14);                                                                             // Setting time step kernel argument...
+  }
+
+  for(kernel* K : {K1, K2, K3, K4, K5, K6, K7})
+  {
+    K->setarg (solution, 15);                                                                       // Setting CG solution kernel argument...
+    K->setarg (residual, 16);                                                                       // Setting CG residual kernel argument...
+    K->setarg (direction, 17);                                                                      // Setting CG search direction kernel argument...
+    K->setarg (product, 18);                                                                        // Setting CG matrix product kernel argument...
+    K->setarg (preconditioner, 19);                                                                 // Setting CG preconditioner kernel argument...
+    K->setarg (partial, 20);                                                                        // Setting CG partial sums kernel argument...
+    K->setarg (scalars, 21);                                                                        // Setting CG scalars kernel argument...
+  }
+#elif INTEGRATOR == XPBD
+  K3->setarg (color, 0);                                                                            // Setting color kernel argument...
+  K3->setarg (position, 1);                                                                         // Setting position kernel argument...
+  K3->setarg (position_int, 2);                                                                     // Setting intermediate position kernel argument...
+  K3->setarg (velocity, 3);                                                                         // Setting velocity kernel argument...
+  K3->setarg (velocity_int, 4);                                                                     // Setting intermediate velocity kernel argument...
+  K3->setarg (acceleration, 5);                                                                     // Setting acceleration kernel argument...
+  K3->setarg (gravity, 6);                                                                          // Setting gravity kernel argument...
+  K3->setarg (stiffness, 7);                                                                        // Setting stiffness kernel argument...
+  K3->setarg (resting, 8);                                                                          // Setting resting position kernel argument...
+  K3->setarg (friction, 9);                                                                         // Setting friction kernel argument...
+  K3->setarg (mass, 10);                                                                            // Setting mass kernel argument...
+  K3->setarg (nearest, 11);                                                                         // Setting neighbour kernel argument...
+  K3->setarg (offset, 12);                                                                          // Setting offset kernel argument...
+  K3->setarg (freedom, 13);                                                                         // Setting freedom flag kernel argument...
+  K3->setarg (dt, 14);                                                                              // Setting time step kernel argument...
+
+  for(kernel* K : K_batch)
+  {
+    K->setarg (color, 0);                                                                           // Setting color kernel argument...
+    K->setarg (position, 1);                                                                        // Setting position kernel argument...
+    K->setarg (position_int, 2);                                                                    // Setting intermediate position kernel argument...
+    K->setarg (velocity, 3);                                                                        // Setting velocity kernel argument...
+    K->setarg (velocity_int, 4);                                                                    // Setting intermediate velocity kernel argument...
+    K->setarg (acceleration, 5);                                                                    // Setting acceleration kernel argument...
+    K->setarg (gravity, 6);                                                                         // Setting gravity kernel argument...
+    K->setarg (stiffness, 7);                                                                       // Setting stiffness kernel argument...
+    K->setarg (resting, 8);                                                                         // Setting resting position kernel argument...
+    K->setarg (friction, 9);                                                                        // Setting friction kernel argument...
+    K->setarg (mass, 10);                                                                           // Setting mass kernel argument...
+    K->setarg (nearest, 11);                                                                        // Setting neighbour kernel argument...
+    K->setarg (offset, 12);                                                                         // Setting offset kernel argument...
+    K->setarg (freedom, 13);                                                                        // Setting freedom flag kernel argument...
+    K->setarg (dt, 14);                                                                             // Setting time step kernel argument...
+  }
+
+  for(kernel* K : {K1, K2, K3})
+  {
+    K->setarg (edge_i, 15);                                                                         // Setting constraint 1st node kernel argument...
+    K->setarg (edge_j, 16);                                                                         // Setting constraint 2nd node kernel argument...
+    K->setarg (edge_resting, 17);                                                                   // Setting constraint resting length kernel argument...
+    K->setarg (edge_compliance, 18);                                                                // Setting constraint compliance kernel argument...
+    K->setarg (lambda, 19);                                                                         // Setting Lagrange multiplier kernel argument...
+    K->setarg (batch[0], 20);                                                                       // Setting colour batch offset kernel argument...
+  }
+
+  for(colour = 0; colour < colours; colour++)
+  {
+    K_batch[colour]->setarg (edge_i, 15);                                                           // Setting constraint 1st node kernel argument...
+    K_batch[colour]->setarg (edge_j, 16);                                                           // Setting constraint 2nd node kernel argument...
+    K_batch[colour]->setarg (edge_resting, 17);                                                     // Setting constraint resting length kernel argument...
+    K_batch[colour]->setarg (edge_compliance, 18);                                                  // Setting constraint compliance kernel argument...
+    K_batch[colour]->setarg (lambda, 19);                                                           // Setting Lagrange multiplier kernel argument...
+    K_batch[colour]->setarg (batch[colour], 20);                                                    // Setting colour batch offset kernel argument...
+  }
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  K3->setarg (color, 0);                                                                            // Setting color kernel argument...
+  K3->setarg (position, 1);                                                                         // Setting position kernel argument...
+  K3->setarg (position_int, 2);                                                                     // Setting intermediate position kernel argument...
+  K3->setarg (velocity, 3);                                                                         // Setting velocity kernel argument...
+  K3->setarg (velocity_int, 4);                                                                     // Setting intermediate velocity kernel argument...
+  K3->setarg (acceleration, 5);                                                                     // Setting acceleration kernel argument...
+  K3->setarg (gravity, 6);                                                                          // Setting gravity kernel argument...
+  K3->setarg (stiffness, 7);                                                                        // Setting stiffness kernel argument...
+  K3->setarg (resting, 8);                                                                          // Setting resting position kernel argument...
+  K3->setarg (friction, 9);                                                                         // Setting friction kernel argument...
+  K3->setarg (mass, 10);                                                                            // Setting mass kernel argument...
+  K3->setarg (nearest, 11);                                                                         // Setting neighbour kernel argument...
+  K3->setarg (offset, 12);                                                                          // Setting offset kernel argument...
+  K3->setarg (freedom, 13);                                                                         // Setting freedom flag kernel argument...
+  K3->setarg (dt, 14);                                                                              // Setting time step kernel argument...
+
+  for(kernel* K : {K1, K2, K3})
+  {
+    K->setarg (dr_partial, 15);                                                                     // Setting DR partial sums kernel argument...
+    K->setarg (dr_scalars, 16);                                                                     // Setting DR scalars kernel argument...
+  }
+#endif
+
+#if SELL
+  if(sell)
+  {
+    K2->setarg (sell_row, 15);                                                                      // Setting sorted row kernel argument...
+    K2->setarg (sell_chunk, 16);                                                                    // Setting chunk offset kernel argument...
+    K2->setarg (sell_nearest, 17);                                                                  // Setting neighbour slot kernel argument...
+  }
+#endif
+
+#if EDGE
+  K_edge->setarg (color, 0);                                                                        // Setting color kernel argument...
+  K_edge->setarg (position, 1);                                                                     // Setting position kernel argument...
+  K_edge->setarg (position_int, 2);                                                                 // Setting intermediate position kernel argument...
+  K_edge->setarg (velocity, 3);                                                                     // Setting velocity kernel argument...
+  K_edge->setarg (velocity_int, 4);                                                                 // Setting intermediate velocity kernel argument...
+  K_edge->setarg (acceleration, 5);                                                                 // Setting acceleration kernel argument...
+  K_edge->setarg (gravity, 6);                                                                      // Setting gravity kernel argument...
+  K_edge->setarg (stiffness, 7);                                                                    // Setting stiffness kernel argument...
+  K_edge->setarg (resting, 8);                                                                      // Setting resting position kernel argument...
+  K_edge->setarg (friction, 9);                                                                     // Setting friction kernel argument...
+  K_edge->setarg (mass, 10);                                                                        // Setting mass kernel argument...
+  K_edge->setarg (nearest, 11);                                                                     // Setting neighbour kernel argument...
+  K_edge->setarg (offset, 12);                                                                      // Setting offset kernel argument...
+  K_edge->setarg (freedom, 13);                                                                     // Setting freedom flag kernel argument...
+  K_edge->setarg (dt, 14);                                                                          // Setting time step kernel argument...
+
+  for(kernel* K : {K2, K_edge})
+  {
+    K->setarg (edge_i, 15);                                                                         // Setting edge 1st node kernel argument...
+    K->setarg (edge_j, 16);                                                                         // Setting edge 2nd node kernel argument...
+    K->setarg (edge_link, 17);                                                                      // Setting edge link index kernel argument...
+    K->setarg (link_edge, 18);                                                                      // Setting link edge index kernel argument...
+    K->setarg (edge_force, 19);                                                                     // Setting edge force kernel argument...
+  }
+#endif
+
+#if ADAPTIVE
+  for(kernel* K : {K_dt_reduce, K_dt_control})
+  {
+    K->setarg (color, 0);                                                                           // Setting color kernel argument...
+    K->setarg (position, 1);                                                                        // Setting position kernel argument...
+    K->setarg (position_int, 2);                                                                    // Setting intermediate position kernel argument...
+    K->setarg (velocity, 3);                                                                        // Setting velocity kernel argument...
+    K->setarg (velocity_int, 4);                                                                    // Setting intermediate velocity kernel argument...
+    K->setarg (acceleration, 5);                                                                    // Setting acceleration kernel argument...
+    K->setarg (gravity, 6);                                                                         // Setting gravity kernel argument...
+    K->setarg (stiffness, 7);                                                                       // Setting stiffness kernel argument...
+    K->setarg (resting, 8);                                                                         // Setting resting position kernel argument...
+    K->setarg (friction, 9);                                                                        // Setting friction kernel argument...
+    K->setarg (mass, 10);                                                                           // Setting mass kernel argument...
+    K->setarg (nearest, 11);                                                                        // Setting neighbour kernel argument...
+    K->setarg (offset, 12);                                                                         // Setting offset kernel argument...
+    K->setarg (freedom, 13);                                                                        // Setting freedom flag kernel argument...
+    K->setarg (dt, 14);                                                                             // Setting time step kernel argument...
+    K->setarg (dt_partial, 15);                                                                     // Setting time step partial maxima kernel argument...
+    K->setarg (dt_limits, 16);                                                                      // Setting time step limits kernel argument...
+  }
+#endif
+
   color->name    = "voxel_color";                                                                   // Setting variable name for OpenGL shader...
   position->name = "voxel_center";                                                                  // Setting variable name for OpenGL shader...
 
@@ -349,6 +1479,52 @@ int main ()
   Q->write (freedom, 13);                                                                           // Writing freedom flag data on queue...
   Q->write (dt, 14);                                                                                // Writing time step data on queue...
 
+#if INTEGRATOR == BACKWARD_EULER
+  Q->write (solution, 15);                                                                          // Writing CG solution data on queue...
+  Q->write (residual, 16);                                                                          // Writing CG residual data on queue...
+  Q->write (direction, 17);                                                                         // Writing CG search direction data on queue...
+  Q->write (product, 18);                                                                           // Writing CG matrix product data on queue...
+  Q->write (preconditioner, 19);                                                                    // Writing CG preconditioner data on queue...
+  Q->write (partial, 20);                                                                           // Writing CG partial sums data on queue...
+  Q->write (scalars, 21);                                                                           // Writing CG scalars data on queue...
+#elif INTEGRATOR == XPBD
+  Q->write (edge_i, 15);                                                                            // Writing constraint 1st node data on queue...
+  Q->write (edge_j, 16);                                                                            // Writing constraint 2nd node data on queue...
+  Q->write (edge_resting, 17);                                                                      // Writing constraint resting length data on queue...
+  Q->write (edge_compliance, 18);                                                                   // Writing constraint compliance data on queue...
+  Q->write (lambda, 19);                                                                            // Writing Lagrange multiplier data on queue...
+
+  for(colour = 0; colour < colours; colour++)
+  {
+    Q->write (batch[colour], 20);                                                                   // Writing colour batch offset data on queue...
+  }
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  Q->write (dr_partial, 15);                                                                        // Writing DR partial sums on queue...
+  Q->write (dr_scalars, 16);                                                                        // Writing DR scalars on queue...
+#endif
+
+#if SELL
+  if(sell)
+  {
+    Q->write (sell_row, 15);                                                                        // Writing sorted rows on queue...
+    Q->write (sell_chunk, 16);                                                                      // Writing chunk offsets on queue...
+    Q->write (sell_nearest, 17);                                                                    // Writing neighbour slots on queue...
+  }
+#endif
+
+#if EDGE
+  Q->write (edge_i, 15);                                                                            // Writing edge 1st node on queue...
+  Q->write (edge_j, 16);                                                                            // Writing edge 2nd node on queue...
+  Q->write (edge_link, 17);                                                                         // Writing edge link index on queue...
+  Q->write (link_edge, 18);                                                                         // Writing link edge index on queue...
+  Q->write (edge_force, 19);                                                                        // Writing edge force on queue...
+#endif
+
+#if ADAPTIVE
+  Q->write (dt_partial, 15);                                                                        // Writing time step partial maxima on queue...
+  Q->write (dt_limits, 16);                                                                         // Writing time step limits on queue...
+#endif
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////// SETTING OPENGL SHADER ARGUMENTS ////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -368,8 +1544,64 @@ int main ()
 
     Q->acquire (color, 0);                                                                          // Acquiring OpenGL/CL shared argument...
     Q->acquire (position, 1);                                                                       // Acquiring OpenGL/CL shared argument...
-    ctx->execute (K1, Q, NU_WAIT);                                                                  // Executing OpenCL kernel...
-    ctx->execute (K2, Q, NU_WAIT);                                                                  // Executing OpenCL kernel...
+
+    // Enqueueing all substeps back to back, waiting only for the last one:
+    for(substep = 0; substep < SUBSTEPS - 1; substep++)
+    {
+      enqueue_step (false);                                                                         // Enqueueing time step...
+    }
+
+    enqueue_step (true);                                                                            // Executing last time step...
+
+#if CHECK_STEPS > 0
+    // CHECKING ACCURACY (same # of time steps in the float and MIXED builds):
+    if((time_step_index < CHECK_STEPS) && (time_step_index + SUBSTEPS >= CHECK_STEPS))
+    {
+      Q->read (position, 1);                                                                        // Reading position data from queue...
+#if MIXED
+      std::ifstream reference (CHECK_FILE);                                                         // Full float positions input file.
+      error_max = 0.0f;                                                                             // Resetting maximum position error [m]...
+      error_rms = 0.0;                                                                              // Resetting RMS position error [m]...
+
+      for(i = 0; (i < nodes) && (reference >> x_ref >> y_ref >> z_ref); i++)
+      {
+        k          = renumber[i];                                                                   // Getting node of original index "i"...
+        error      = sqrt (
+                           pow (position->data[k].x - x_ref, 2) +
+                           pow (position->data[k].y - y_ref, 2) +
+                           pow (position->data[k].z - z_ref, 2)
+                          );                                                                        // Computing position error [m]...
+        error_max  = fmax (error_max, error);                                                       // Updating maximum position error [m]...
+        error_rms += error*error;                                                                   // Accumulating squared position error [m^2]...
+      }
+
+      if(i < nodes)
+      {
+        std::cerr << "Error: " << CHECK_FILE << " does not contain " << nodes << " nodes." << std::endl;
+      }
+      else
+      {
+        error_rms = sqrt (error_rms/nodes);                                                         // Computing RMS position error [m]...
+        std::cout << "Position error vs " << CHECK_FILE << " after " << time_step_index + SUBSTEPS
+                  << " time steps (max, RMS) = " << error_max << ", " << error_rms << " [m]" << std::endl;
+      }
+#else
+      std::ofstream output (CHECK_FILE);                                                            // Full float positions output file.
+      output.precision (9);                                                                         // Setting float round-trip precision...
+
+      for(i = 0; i < nodes; i++)
+      {
+        k = renumber[i];                                                                            // Getting node of original index "i"...
+        output << position->data[k].x << " " << position->data[k].y << " " << position->data[k].z << "\n";
+      }
+
+      std::cout << "Positions after " << time_step_index + SUBSTEPS << " time steps saved in " << CHECK_FILE << std::endl;
+#endif
+    }
+#endif
+
+    time_step_index += SUBSTEPS;                                                                    // Updating time step index [#]...
+
     Q->release (color, 0);                                                                          // Releasing OpenGL/CL shared argument...
     Q->release (position, 1);                                                                       // Releasing OpenGL/CL shared argument...
 
@@ -393,6 +1625,21 @@ int main ()
 
     gui->plot (S);                                                                                  // Plotting shared arguments...
     gui->refresh ();                                                                                // Refreshing gui...
+
+#if INTEGRATOR == DYNAMIC_RELAXATION
+    if(!relaxed)
+    {
+      Q->read (dr_scalars, 16);                                                                     // Reading DR scalars from queue...
+      relaxed = (dr_scalars->data[3] > 0.0f);                                                       // Checking convergence ("DR_DONE")...
+
+      if(relaxed)
+      {
+        std::cout << "Static equilibrium reached after " << dr_scalars->data[4] << " relaxation steps"
+                  << " (relative residual force = " << dr_scalars->data[2] << ")" << std::endl;
+      }
+    }
+#endif
+
     bas->get_toc ();                                                                                // Getting "toc" [us]...
   }
 
@@ -408,6 +1655,29 @@ int main ()
   delete position_int;                                                                              // Deleting intermediate position data...
   delete velocity;                                                                                  // Deleting velocity data...
   delete velocity_int;                                                                              // Deleting intermediate velocity data...
+#if INTEGRATOR == BACKWARD_EULER
+  delete solution;                                                                                  // Deleting CG solution data...
+  delete residual;                                                                                  // Deleting CG residual data...
+  delete direction;                                                                                 // Deleting CG search direction data...
+  delete product;                                                                                   // Deleting CG matrix product data...
+  delete preconditioner;                                                                            // Deleting CG preconditioner data...
+  delete partial;                                                                                   // Deleting CG partial sums...
+  delete scalars;                                                                                   // Deleting CG scalars...
+#elif INTEGRATOR == XPBD
+  delete edge_i;                                                                                    // Deleting constraint 1st node data...
+  delete edge_j;                                                                                    // Deleting constraint 2nd node data...
+  delete edge_resting;                                                                              // Deleting constraint resting length data...
+  delete edge_compliance;                                                                           // Deleting constraint compliance data...
+  delete lambda;                                                                                    // Deleting Lagrange multiplier data...
+
+  for(int1* b : batch)
+  {
+    delete b;                                                                                       // Deleting colour batch offset data...
+  }
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  delete dr_partial;                                                                                // Deleting DR partial sums...
+  delete dr_scalars;                                                                                // Deleting DR scalars...
+#endif
   delete acceleration;                                                                              // Deleting acceleration data...
   delete gravity;                                                                                   // Deleting gravity data...
   delete stiffness;                                                                                 // Deleting stiffness data...
@@ -418,10 +1688,49 @@ int main ()
   delete offset;                                                                                    // Deleting offset...
   delete freedom;                                                                                   // Deleting freedom flag data...
   delete dt;                                                                                        // Deleting time step data...
+#if ADAPTIVE
+  delete dt_partial;                                                                                // Deleting time step partial maxima...
+  delete dt_limits;                                                                                 // Deleting time step limits...
+#endif
+#if SELL
+  delete sell_row;                                                                                  // Deleting sorted rows...
+  delete sell_chunk;                                                                                // Deleting chunk offsets...
+  delete sell_nearest;                                                                              // Deleting neighbour slots...
+#endif
+#if EDGE
+  delete edge_i;                                                                                    // Deleting edge 1st node...
+  delete edge_j;                                                                                    // Deleting edge 2nd node...
+  delete edge_link;                                                                                 // Deleting edge link index...
+  delete link_edge;                                                                                 // Deleting link edge index...
+  delete edge_force;                                                                                // Deleting edge force...
+#endif
 
   delete Q;                                                                                         // Deleting OpenCL queue...
   delete K1;                                                                                        // Deleting OpenCL kernel...
   delete K2;                                                                                        // Deleting OpenCL kernel...
+#if INTEGRATOR == BACKWARD_EULER
+  delete K3;                                                                                        // Deleting OpenCL kernel...
+  delete K4;                                                                                        // Deleting OpenCL kernel...
+  delete K5;                                                                                        // Deleting OpenCL kernel...
+  delete K6;                                                                                        // Deleting OpenCL kernel...
+  delete K7;                                                                                        // Deleting OpenCL kernel...
+#elif INTEGRATOR == XPBD
+  delete K3;                                                                                        // Deleting OpenCL kernel...
+
+  for(kernel* K : K_batch)
+  {
+    delete K;                                                                                       // Deleting OpenCL kernel...
+  }
+#elif INTEGRATOR == DYNAMIC_RELAXATION
+  delete K3;                                                                                        // Deleting OpenCL kernel...
+#endif
+#if ADAPTIVE
+  delete K_dt_reduce;                                                                               // Deleting OpenCL kernel...
+  delete K_dt_control;                                                                              // Deleting OpenCL kernel...
+#endif
+#if EDGE
+  delete K_edge;                                                                                    // Deleting OpenCL kernel...
+#endif
 
   return 0;
 }
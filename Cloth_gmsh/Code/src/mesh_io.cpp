@@ -0,0 +1,1546 @@
+/// @file
+
+#include "mesh_io.hpp"                                                                              // Mesh input header file.
+#include <atomic>                                                                                   // Parallel mesh adjacency.
+#include <climits>                                                                                  // gmsh parser (integer saturation).
+#include <cmath>                                                                                    // Link lengths, STL bounding box.
+#include <cstdint>                                                                                  // Binary mesh cache.
+#include <cstdio>                                                                                   // Binary mesh cache (removing partial files).
+#include <cstring>                                                                                  // gmsh parser, STL parser.
+#include <filesystem>                                                                               // Source size and modification time.
+#include <fstream>                                                                                  // Binary mesh cache, STL file.
+
+#ifndef WIN32
+  #include <fcntl.h>                                                                                // Mapped file (file descriptor).
+  #include <sys/mman.h>                                                                             // Mapped file (memory mapping).
+  #include <sys/stat.h>                                                                             // Mapped file (file size).
+  #include <unistd.h>                                                                               // Mapped file (file descriptor).
+#endif
+
+// Building the node adjacency of a mesh (CSR, 32-bit) from its elements in linear time: two nodes are
+// neighbours when they share an element. The node pairs of all elements are bucketed by 1st node
+// (counting sort, prefix sum), then each bucket is sorted and made unique, all in parallel.
+void mesh_adjacency (
+                     mesh*                 object,                                                  // Mesh object.
+                     std::vector<cl_uint>& offset,                                                  // Neighbour stride start (nodes + 1) [#].
+                     std::vector<cl_uint>& nearest                                                  // Neighbour indexes [#].
+                    )
+{
+  size_t                   nodes    = object->node.size ();                                         // Number of nodes [#].
+  size_t                   elements = object->element.size ();                                      // Number of elements [#].
+  std::vector<std::atomic<cl_uint>> fill (nodes);                                                   // Bucket fill counters [#].
+  std::vector<cl_uint>     bucket;                                                                  // Element node pairs, by 1st node [#].
+  std::vector<cl_uint>     bucket_offset (nodes + 1, 0);                                            // Bucket start [#].
+  std::vector<cl_uint>     degree (nodes, 0);                                                       // Unique # of neighbours [#].
+  size_t                   i;                                                                       // Node index [#].
+
+  // COUNTING ELEMENT NODE PAIRS (by 1st node):
+  parallel_for (elements, [&](size_t first, size_t last)
+  {
+    for(size_t e = first; e < last; e++)
+    {
+      for(size_t a = 0; a < object->element[e].node.size (); a++)
+      {
+        for(size_t b = 0; b < object->element[e].node.size (); b++)
+        {
+          if(object->element[e].node[a] != object->element[e].node[b])
+          {
+            fill[object->element[e].node[a]]++;                                                     // Counting node pair...
+          }
+        }
+      }
+    }
+  });
+
+  // COMPUTING BUCKET OFFSETS (prefix sum):
+  for(i = 0; i < nodes; i++)
+  {
+    bucket_offset[i + 1] = bucket_offset[i] + fill[i];                                              // Accumulating bucket size...
+    fill[i]              = bucket_offset[i];                                                        // Resetting bucket fill counter...
+  }
+
+  bucket.resize (bucket_offset[nodes]);                                                             // Initializing buckets...
+
+  // BUCKETING ELEMENT NODE PAIRS (by 1st node):
+  parallel_for (elements, [&](size_t first, size_t last)
+  {
+    for(size_t e = first; e < last; e++)
+    {
+      for(size_t a = 0; a < object->element[e].node.size (); a++)
+      {
+        for(size_t b = 0; b < object->element[e].node.size (); b++)
+        {
+          if(object->element[e].node[a] != object->element[e].node[b])
+          {
+            bucket[fill[object->element[e].node[a]]++] = object->element[e].node[b];                // Bucketing node pair...
+          }
+        }
+      }
+    }
+  });
+
+  // SORTING AND UNIQUING BUCKETS:
+  parallel_for (nodes, [&](size_t first, size_t last)
+  {
+    for(size_t n = first; n < last; n++)
+    {
+      std::sort (bucket.begin () + bucket_offset[n], bucket.begin () + bucket_offset[n + 1]);       // Sorting bucket...
+      degree[n] = std::unique (bucket.begin () + bucket_offset[n], bucket.begin () + bucket_offset[n + 1]) -
+                  (bucket.begin () + bucket_offset[n]);                                             // Uniquing bucket...
+    }
+  });
+
+  // COMPUTING NEIGHBOUR OFFSETS (prefix sum):
+  offset.assign (nodes + 1, 0);                                                                     // Initializing neighbour offsets...
+
+  for(i = 0; i < nodes; i++)
+  {
+    offset[i + 1] = offset[i] + degree[i];                                                          // Accumulating # of neighbours...
+  }
+
+  nearest.resize (offset[nodes]);                                                                   // Initializing neighbour indexes...
+
+  // COMPACTING BUCKETS:
+  parallel_for (nodes, [&](size_t first, size_t last)
+  {
+    for(size_t n = first; n < last; n++)
+    {
+      std::copy (
+                 bucket.begin () + bucket_offset[n],                                                // Bucket begin.
+                 bucket.begin () + bucket_offset[n] + degree[n],                                    // Bucket unique end.
+                 nearest.begin () + offset[n]                                                       // Neighbour stride.
+                );
+    }
+  });
+}
+
+// Computing the link lengths of a mesh adjacency (CSR), in parallel over the nodes:
+void mesh_lengths (
+                   mesh*                 object,                                                    // Mesh object.
+                   std::vector<cl_uint>& offset,                                                    // Neighbour stride start (nodes + 1) [#].
+                   std::vector<cl_uint>& nearest,                                                   // Neighbour indexes [#].
+                   std::vector<float>&   length                                                     // Link lengths [m].
+                  )
+{
+  length.resize (nearest.size ());                                                                  // Initializing link lengths...
+
+  parallel_for (object->node.size (), [&](size_t first, size_t last)
+  {
+    for(size_t n = first; n < last; n++)
+    {
+      for(size_t q = offset[n]; q < offset[n + 1]; q++)
+      {
+        length[q] = sqrt (
+                          pow (object->node[nearest[q]].x - object->node[n].x, 2) +
+                          pow (object->node[nearest[q]].y - object->node[n].y, 2) +
+                          pow (object->node[nearest[q]].z - object->node[n].z, 2)
+                         );                                                                         // Computing link length...
+      }
+    }
+  });
+}
+
+// Read-only file contents, memory-mapped (read into a buffer on Windows) and released when going out
+// of scope: "data" is NULL if the file is missing, empty or cannot be read.
+class mapped_file
+{
+public:
+  const char*              data;                                                                    // File data.
+  size_t                   size;                                                                    // File size [bytes].
+
+  mapped_file (
+               std::string file_name                                                                // File name.
+              );
+  ~mapped_file ();
+
+  mapped_file (const mapped_file&)            = delete;                                             // Single owner of the mapping.
+  mapped_file& operator= (const mapped_file&) = delete;                                             // Single owner of the mapping.
+
+private:
+#ifdef WIN32
+  std::vector<char>        buffer;                                                                  // File buffer.
+#endif
+};
+
+mapped_file::mapped_file (
+                          std::string file_name                                                     // File name.
+                         )
+{
+  data = NULL;                                                                                      // Resetting file data...
+  size = 0;                                                                                         // Resetting file size...
+
+#ifdef WIN32
+  std::ifstream            file (file_name, std::ios::binary | std::ios::ate);                      // File.
+
+  if(!file || (file.tellg () <= 0))
+  {
+    return;                                                                                         // Missing or empty file...
+  }
+
+  buffer.resize (file.tellg ());                                                                    // Initializing file buffer...
+  file.seekg (0);                                                                                   // Rewinding file...
+
+  if(file.read (buffer.data (), buffer.size ()))
+  {
+    data = buffer.data ();                                                                          // Setting file data...
+    size = buffer.size ();                                                                          // Setting file size...
+  }
+#else
+  int                      file = open (file_name.c_str (), O_RDONLY);                              // File descriptor.
+  struct stat              status;                                                                  // File status.
+  void*                    map;                                                                     // File mapping.
+
+  if(file < 0)
+  {
+    return;                                                                                         // Missing file...
+  }
+
+  if((fstat (file, &status) == 0) && (status.st_size > 0))
+  {
+    map = mmap (NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);                             // Mapping file...
+
+    if(map != MAP_FAILED)
+    {
+      data = (const char*)map;                                                                      // Setting file data...
+      size = status.st_size;                                                                        // Setting file size...
+    }
+  }
+
+  close (file);                                                                                     // Closing file (the mapping persists)...
+#endif
+}
+
+mapped_file::~mapped_file ()
+{
+#ifndef WIN32
+  if(data != NULL)
+  {
+    munmap ((void*)data, size);                                                                     // Unmapping file...
+  }
+#endif
+}
+
+// Hashing a file (64-bit FNV-1a of its bytes), used to invalidate the binary mesh cache:
+uint64_t source_hash (
+                      std::string file_name                                                         // File name.
+                     )
+{
+  std::ifstream            file (file_name, std::ios::binary);                                      // Source file.
+  std::vector<char>        block (1 << 20);                                                         // File block.
+  uint64_t                 hash = 14695981039346656037ULL;                                          // FNV-1a offset basis.
+  std::streamsize          bytes;                                                                   // # of bytes in block [#].
+  std::streamsize          b;                                                                       // Byte index [#].
+
+  while(file)
+  {
+    file.read (block.data (), block.size ());                                                       // Reading file block...
+    bytes = file.gcount ();                                                                         // Getting # of bytes read...
+
+    for(b = 0; b < bytes; b++)
+    {
+      hash = (hash ^ (unsigned char)block[b])*1099511628211ULL;                                     // Hashing byte (FNV-1a prime)...
+    }
+  }
+
+  return hash;                                                                                      // Returning hash...
+}
+
+// Getting the size and modification time of a file, used to validate the binary mesh cache without
+// hashing the file; "false" if the file status is unavailable:
+bool source_stamp (
+                   std::string file_name,                                                           // File name.
+                   uint64_t&   size,                                                                // File size [bytes].
+                   uint64_t&   time                                                                 // File modification time (file clock ticks).
+                  )
+{
+  std::error_code          error;                                                                   // File status error.
+
+  size = std::filesystem::file_size (file_name, error);                                             // Getting file size...
+
+  if(error)
+  {
+    return false;                                                                                   // No file status...
+  }
+
+  time = std::filesystem::last_write_time (file_name, error).time_since_epoch ().count ();          // Getting modification time...
+
+  return !error;                                                                                    // Returning file status...
+}
+
+// Binary mesh cache: a header of MESH_CACHE_COUNTS 64-bit words (magic, version, source size, time and
+// hash, then the section sizes) followed by the sections, all of 32-bit words: node positions (x, y, z,
+// w), element stride start (elements + 1), element nodes, "border", "side_x" and "side_y" physical group
+// nodes, neighbour stride start (nodes + 1), neighbour indexes and link lengths (gmsh numbering). The
+// source is hashed only when its size or modification time differ from the ones in the header.
+#define MESH_CACHE_MAGIC   0x484341434853454DULL                                                    // "MESHCACH" (little-endian).
+#define MESH_CACHE_VERSION 3                                                                        // Cache format version.
+#define MESH_CACHE_COUNTS  12                                                                       // # of header words [#].
+#define MESH_CACHE_STAMP   2                                                                        // Header index of the source size and time [#].
+
+// Saving the binary mesh cache, "false" (no cache file left) if it could not be written:
+bool mesh_cache_save (
+                      std::string           file_name,                                              // Cache file name.
+                      std::string           source_name,                                            // Mesh source file name.
+                      mesh*                 object,                                                 // Mesh object.
+                      std::vector<size_t>&  border,                                                 // Nodes on border.
+                      std::vector<size_t>&  side_x,                                                 // Nodes on "x" side.
+                      std::vector<size_t>&  side_y,                                                 // Nodes on "y" side.
+                      std::vector<cl_uint>& offset,                                                 // Neighbour stride start (nodes + 1) [#].
+                      std::vector<cl_uint>& nearest,                                                // Neighbour indexes [#].
+                      std::vector<float>&   length                                                  // Link lengths [m].
+                     )
+{
+  std::ofstream            file (file_name, std::ios::binary);                                      // Cache file.
+  uint64_t                 header[MESH_CACHE_COUNTS];                                               // Cache header.
+  std::vector<float>       node;                                                                    // Node positions [m].
+  std::vector<cl_uint>     element_offset (1, 0);                                                   // Element stride start [#].
+  std::vector<cl_uint>     element_node;                                                            // Element nodes [#].
+  std::vector<cl_uint>     group[3];                                                                // Physical group nodes [#].
+  std::vector<size_t>*     physical[3] = {&border, &side_x, &side_y};                               // Physical groups.
+  size_t                   i;                                                                       // Index [#].
+  size_t                   j;                                                                       // Index [#].
+
+  for(i = 0; i < object->node.size (); i++)
+  {
+    node.push_back (object->node[i].x);                                                             // Packing "x" position...
+    node.push_back (object->node[i].y);                                                             // Packing "y" position...
+    node.push_back (object->node[i].z);                                                             // Packing "z" position...
+    node.push_back (object->node[i].w);                                                             // Packing "w" position...
+  }
+
+  for(i = 0; i < object->element.size (); i++)
+  {
+    for(j = 0; j < object->element[i].node.size (); j++)
+    {
+      element_node.push_back (object->element[i].node[j]);                                          // Packing element node...
+    }
+
+    element_offset.push_back (element_node.size ());                                                // Packing element stride...
+  }
+
+  for(i = 0; i < 3; i++)
+  {
+    group[i].assign (physical[i]->begin (), physical[i]->end ());                                   // Packing physical group...
+  }
+
+  header[0] = MESH_CACHE_MAGIC;                                                                     // Setting magic number...
+  header[1] = MESH_CACHE_VERSION;                                                                   // Setting format version...
+
+  if(!source_stamp (source_name, header[2], header[3]))
+  {
+    return false;                                                                                   // No source file status...
+  }
+
+  header[4] = source_hash (source_name);                                                            // Setting source hash...
+  header[5] = object->node.size ();                                                                 // Setting # of nodes...
+  header[6] = object->element.size ();                                                              // Setting # of elements...
+  header[7] = element_node.size ();                                                                 // Setting # of element nodes...
+  header[8] = group[0].size ();                                                                     // Setting # of border nodes...
+  header[9] = group[1].size ();                                                                     // Setting # of side_x nodes...
+  header[10] = group[2].size ();                                                                    // Setting # of side_y nodes...
+  header[11] = nearest.size ();                                                                     // Setting # of links...
+
+  file.write ((char*)header, sizeof (header));                                                      // Writing header...
+  file.write ((char*)node.data (), node.size ()*sizeof (float));                                    // Writing node positions...
+  file.write ((char*)element_offset.data (), element_offset.size ()*sizeof (cl_uint));              // Writing element strides...
+  file.write ((char*)element_node.data (), element_node.size ()*sizeof (cl_uint));                  // Writing element nodes...
+
+  for(i = 0; i < 3; i++)
+  {
+    file.write ((char*)group[i].data (), group[i].size ()*sizeof (cl_uint));                        // Writing physical group...
+  }
+
+  file.write ((char*)offset.data (), offset.size ()*sizeof (cl_uint));                              // Writing neighbour strides...
+  file.write ((char*)nearest.data (), nearest.size ()*sizeof (cl_uint));                            // Writing neighbour indexes...
+  file.write ((char*)length.data (), length.size ()*sizeof (float));                                // Writing link lengths...
+  file.close ();                                                                                    // Closing cache file (flushing)...
+
+  if(!file.good ())
+  {
+    std::remove (file_name.c_str ());                                                               // Removing partial cache file...
+    return false;                                                                                   // Cache not written...
+  }
+
+  return true;                                                                                      // Cache written...
+}
+
+// Adding "count" items of "width" bytes to a byte total, "false" on size_t overflow:
+inline bool cache_bytes (
+                         size_t&  total,                                                            // Byte total [bytes].
+                         uint64_t count,                                                            // # of items [#].
+                         size_t   width                                                             // Item size [bytes].
+                        )
+{
+  if(count > (SIZE_MAX - total)/width)
+  {
+    return false;                                                                                   // Overflow...
+  }
+
+  total += count*width;                                                                             // Adding bytes...
+
+  return true;                                                                                      // No overflow...
+}
+
+// Checking a stride start array: starts at 0, non decreasing, ends at "last":
+inline bool cache_strides (
+                           const cl_uint* start,                                                    // Stride start [#].
+                           uint64_t       count,                                                    // # of strides [#].
+                           uint64_t       last                                                      // Last stride end [#].
+                          )
+{
+  uint64_t                 i;                                                                       // Stride index [#].
+
+  if((start[0] != 0) || (start[count] != last))
+  {
+    return false;                                                                                   // Bad stride bounds...
+  }
+
+  for(i = 0; i < count; i++)
+  {
+    if(start[i + 1] < start[i])
+    {
+      return false;                                                                                 // Decreasing stride start...
+    }
+  }
+
+  return true;                                                                                      // Valid strides...
+}
+
+// Checking that all indexes of an array are below "bound":
+inline bool cache_indexes (
+                           const cl_uint* index,                                                    // Indexes [#].
+                           uint64_t       count,                                                    // # of indexes [#].
+                           uint64_t       bound                                                     // Index bound [#].
+                          )
+{
+  return std::all_of (index, index + count, [bound](cl_uint n) {return n < bound;});                // Checking indexes...
+}
+
+// Loading the binary mesh cache (memory-mapped where available), "false" if missing, stale, truncated
+// or corrupt: the size of every section is checked against the file size and all stride starts and
+// node indexes are bounds-checked before anything is copied.
+bool mesh_cache_load (
+                      std::string           file_name,                                              // Cache file name.
+                      std::string           source_name,                                            // Mesh source file name.
+                      mesh*                 object,                                                 // Mesh object.
+                      std::vector<size_t>&  border,                                                 // Nodes on border.
+                      std::vector<size_t>&  side_x,                                                 // Nodes on "x" side.
+                      std::vector<size_t>&  side_y,                                                 // Nodes on "y" side.
+                      std::vector<cl_uint>& offset,                                                 // Neighbour stride start (nodes + 1) [#].
+                      std::vector<cl_uint>& nearest,                                                // Neighbour indexes [#].
+                      std::vector<float>&   length                                                  // Link lengths [m].
+                     )
+{
+  const char*              data;                                                                    // Cache data.
+  size_t                   size;                                                                    // Cache size [bytes].
+  const uint64_t*          header;                                                                  // Cache header.
+  const cl_uint*           word;                                                                    // Cache sections (32-bit words).
+  const float*             node;                                                                    // Node positions [m].
+  const cl_uint*           element_offset;                                                          // Element stride start [#].
+  const cl_uint*           element_node;                                                            // Element nodes [#].
+  std::vector<size_t>*     physical[3] = {&border, &side_x, &side_y};                               // Physical groups.
+  size_t                   bytes;                                                                   // Expected cache size [bytes].
+  size_t                   i;                                                                       // Index [#].
+  const cl_uint*           group[3];                                                                // Physical group nodes [#].
+  const cl_uint*           neighbour_offset;                                                        // Neighbour stride start [#].
+  const cl_uint*           neighbour;                                                               // Neighbour indexes [#].
+  const float*             link;                                                                    // Link lengths [m].
+  uint64_t                 stamp[2];                                                                // Mesh source size and time.
+  bool                     stamped;                                                                 // Source stamp match flag.
+  bool                     valid;                                                                   // Valid cache flag.
+
+  mapped_file              cache (file_name);                                                       // Cache file.
+
+  data = cache.data;                                                                                // Setting cache data...
+  size = cache.size;                                                                                // Setting cache size...
+
+  if(data == NULL)
+  {
+    return false;                                                                                   // Missing, empty or unreadable cache...
+  }
+
+  header = (const uint64_t*)data;                                                                   // Setting cache header...
+  bytes  = sizeof (uint64_t)*MESH_CACHE_COUNTS;                                                     // Setting header size...
+  valid  = (size >= bytes) &&
+           (header[0] == MESH_CACHE_MAGIC) &&
+           (header[1] == MESH_CACHE_VERSION) &&
+           source_stamp (source_name, stamp[0], stamp[1]);                                          // Checking magic number, version and source status...
+
+  // CHECKING SOURCE (size and time, then hash only if they changed):
+  stamped = valid && (header[2] == stamp[0]) && (header[3] == stamp[1]);                            // Checking source size and time...
+  valid   = valid && (stamped || (header[4] == source_hash (source_name)));                         // Checking source hash...
+
+  // CHECKING SECTION SIZES (overflow-safe, before touching the sections):
+  valid  = valid &&
+           (header[5] < UINT32_MAX) && (header[6] < SIZE_MAX/sizeof (cl_uint)) &&
+           cache_bytes (bytes, header[5], 4*sizeof (float)) &&
+           cache_bytes (bytes, header[6] + 1, sizeof (cl_uint)) &&
+           cache_bytes (bytes, header[7], sizeof (cl_uint)) &&
+           cache_bytes (bytes, header[8], sizeof (cl_uint)) &&
+           cache_bytes (bytes, header[9], sizeof (cl_uint)) &&
+           cache_bytes (bytes, header[10], sizeof (cl_uint)) &&
+           cache_bytes (bytes, header[5] + 1, sizeof (cl_uint)) &&
+           cache_bytes (bytes, header[11], sizeof (cl_uint)) &&
+           cache_bytes (bytes, header[11], sizeof (float)) &&
+           (size == bytes);                                                                         // Checking cache size...
+
+  if(valid)
+  {
+    word             = (const cl_uint*)(header + MESH_CACHE_COUNTS);                                // Setting 1st section...
+    node             = (const float*)word;                                                          // Setting node positions...
+    word            += 4*header[5];                                                                 // Skipping node positions...
+    element_offset   = word;                                                                        // Setting element strides...
+    word            += header[6] + 1;                                                               // Skipping element strides...
+    element_node     = word;                                                                        // Setting element nodes...
+    word            += header[7];                                                                   // Skipping element nodes...
+
+    for(i = 0; i < 3; i++)
+    {
+      group[i]       = word;                                                                        // Setting physical group...
+      word          += header[8 + i];                                                               // Skipping physical group...
+    }
+
+    neighbour_offset = word;                                                                        // Setting neighbour strides...
+    word            += header[5] + 1;                                                               // Skipping neighbour strides...
+    neighbour        = word;                                                                        // Setting neighbour indexes...
+    word            += header[11];                                                                  // Skipping neighbour indexes...
+    link             = (const float*)word;                                                          // Setting link lengths...
+
+    // CHECKING STRIDES AND NODE INDEXES:
+    valid = cache_strides (element_offset, header[6], header[7]) &&
+            cache_strides (neighbour_offset, header[5], header[11]) &&
+            cache_indexes (element_node, header[7], header[5]) &&
+            cache_indexes (group[0], header[8], header[5]) &&
+            cache_indexes (group[1], header[9], header[5]) &&
+            cache_indexes (group[2], header[10], header[5]) &&
+            cache_indexes (neighbour, header[11], header[5]);                                       // Checking cache contents...
+  }
+
+  if(valid)
+  {
+    object->node.resize (header[5]);                                                                // Initializing nodes...
+
+    for(i = 0; i < header[5]; i++)
+    {
+      object->node[i].x = node[4*i + 0];                                                            // Setting "x" position...
+      object->node[i].y = node[4*i + 1];                                                            // Setting "y" position...
+      object->node[i].z = node[4*i + 2];                                                            // Setting "z" position...
+      object->node[i].w = node[4*i + 3];                                                            // Setting "w" position...
+    }
+
+    object->element.resize (header[6]);                                                             // Initializing elements...
+
+    for(i = 0; i < header[6]; i++)
+    {
+      object->element[i].node.assign (
+                                      element_node + element_offset[i],                             // Element stride begin.
+                                      element_node + element_offset[i + 1]                          // Element stride end.
+                                     );                                                             // Setting element nodes...
+    }
+
+    for(i = 0; i < 3; i++)
+    {
+      physical[i]->assign (group[i], group[i] + header[8 + i]);                                     // Setting physical group...
+    }
+
+    offset.assign (neighbour_offset, neighbour_offset + header[5] + 1);                             // Setting neighbour strides...
+    nearest.assign (neighbour, neighbour + header[11]);                                             // Setting neighbour indexes...
+    length.assign (link, link + header[11]);                                                        // Setting link lengths...
+  }
+
+  // REFRESHING SOURCE STAMP (same content, new size or time: avoids hashing again next time):
+  if(valid && !stamped)
+  {
+    std::fstream           cache (file_name, std::ios::binary | std::ios::in | std::ios::out);      // Cache file.
+
+    cache.seekp (sizeof (uint64_t)*MESH_CACHE_STAMP);                                               // Seeking source stamp...
+    cache.write ((char*)stamp, sizeof (stamp));                                                     // Writing source stamp...
+  }
+
+  return valid;                                                                                     // Returning cache status...
+}
+
+// gmsh 4.1 ASCII parser: the file is memory-mapped, a serial pass finds the line starts of the
+// "$Nodes" and "$Elements" blocks (every MSH_CHUNK lines), then all chunks are parsed in parallel.
+#define MSH_CHUNK 65536                                                                             // # of lines per parser chunk [#].
+
+// Parser chunk (MSH_CHUNK lines at most, within one block):
+struct msh_chunk
+{
+  const char*              begin;                                                                   // 1st line.
+  size_t                   line;                                                                    // 1st line index (section wide) [#].
+  size_t                   lines;                                                                   // # of lines [#].
+  size_t                   width;                                                                   // # of nodes per element [#].
+  size_t                   base;                                                                    // 1st element node index [#].
+};
+
+// Element block of the "$Elements" section:
+struct msh_block
+{
+  long                     dim;                                                                     // Entity dimension.
+  long                     entity;                                                                  // Entity tag.
+  size_t                   width;                                                                   // # of nodes per element [#].
+  size_t                   first;                                                                   // 1st element index [#].
+  size_t                   count;                                                                   // # of elements [#].
+  size_t                   base;                                                                    // 1st element node index [#].
+};
+
+// Skipping to the next line:
+inline const char* msh_next_line (
+                                  const char* p,                                                    // Text pointer.
+                                  const char* end                                                   // Text end.
+                                 )
+{
+  p = (const char*)std::memchr (p, '\n', end - p);                                                  // Finding line end...
+
+  return (p == NULL) ? end : p + 1;                                                                 // Returning next line...
+}
+
+// Skipping blanks (up to the text end):
+inline void msh_blanks (
+                        const char*& p,                                                             // Text pointer.
+                        const char*  end                                                            // Text end.
+                       )
+{
+  while((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')))
+  {
+    p++;                                                                                            // Skipping blank...
+  }
+}
+
+// Checking for a decimal digit (before the text end):
+inline bool msh_digit (
+                       const char* p,                                                               // Text pointer.
+                       const char* end                                                              // Text end.
+                      )
+{
+  return (p < end) && (*p >= '0') && (*p <= '9');                                                   // Checking digit...
+}
+
+// Parsing an integer (up to the text end):
+inline long msh_int (
+                     const char*& p,                                                                // Text pointer.
+                     const char*  end                                                               // Text end.
+                    )
+{
+  long                     sign  = 1;                                                               // Sign.
+  long                     value = 0;                                                               // Value.
+
+  msh_blanks (p, end);                                                                              // Skipping blanks...
+
+  if((p < end) && ((*p == '-') || (*p == '+')))
+  {
+    sign = (*p++ == '-') ? -1 : 1;                                                                  // Setting sign...
+  }
+
+  for(; msh_digit (p, end); p++)
+  {
+    value = (value < LONG_MAX/10 - 1) ? 10*value + (*p - '0') : LONG_MAX;                           // Accumulating digit (saturated)...
+  }
+
+  return sign*value;                                                                                // Returning value...
+}
+
+// Parsing a float (no locale, no allocation, up to the text end): up to 19 significant digits are
+// accumulated as an integer, then scaled by a power of 10 in double precision and rounded to float.
+// The result is exact before the final rounding when the mantissa has at most 15 digits and the
+// exponent is within +/-22 (exact power, one correctly rounded operation); otherwise it carries an
+// error of a few double ulps, hence the float can be 1 ulp away from the correctly rounded one only
+// when the decimal value lies that close to the midpoint between two floats:
+inline float msh_float (
+                        const char*& p,                                                             // Text pointer.
+                        const char*  end                                                            // Text end.
+                       )
+{
+  static const double      power[23] = {1E0, 1E1, 1E2, 1E3, 1E4, 1E5, 1E6, 1E7, 1E8, 1E9, 1E10, 1E11,
+                                        1E12, 1E13, 1E14, 1E15, 1E16, 1E17, 1E18, 1E19, 1E20, 1E21,
+                                        1E22};                                                      // Exact powers of 10.
+  double                   sign     = 1.0;                                                          // Sign.
+  uint64_t                 mantissa = 0;                                                            // Decimal mantissa.
+  int                      digits   = 0;                                                            // # of significant digits [#].
+  long                     exponent = 0;                                                            // Decimal exponent.
+  double                   value;                                                                   // Value.
+
+  msh_blanks (p, end);                                                                              // Skipping blanks...
+
+  if((p < end) && ((*p == '-') || (*p == '+')))
+  {
+    sign = (*p++ == '-') ? -1.0 : 1.0;                                                              // Setting sign...
+  }
+
+  for(; msh_digit (p, end); p++)
+  {
+    if(digits < 19)
+    {
+      mantissa = 10*mantissa + (*p - '0');                                                          // Accumulating integer digit...
+      digits  += (mantissa != 0);                                                                   // Counting significant digit...
+    }
+    else
+    {
+      exponent++;                                                                                   // Dropping integer digit...
+    }
+  }
+
+  if((p < end) && (*p == '.'))
+  {
+    for(p++; msh_digit (p, end); p++)
+    {
+      if(digits < 19)
+      {
+        mantissa = 10*mantissa + (*p - '0');                                                        // Accumulating fractional digit...
+        digits  += (mantissa != 0);                                                                 // Counting significant digit...
+        exponent--;                                                                                 // Shifting decimal point...
+      }
+    }
+  }
+
+  if((p < end) && ((*p == 'e') || (*p == 'E')))
+  {
+    p++;                                                                                            // Skipping exponent mark...
+    exponent += std::max (-9999L, std::min (9999L, msh_int (p, end)));                              // Adding exponent (clamped, beyond float range)...
+  }
+
+  value = (double)mantissa;                                                                         // Setting value...
+
+  if((exponent >= -22) && (exponent <= 22))
+  {
+    value = (exponent < 0) ? value/power[-exponent] : value*power[exponent];                        // Scaling by exact power of 10...
+  }
+  else
+  {
+    value = value*pow (10.0, (double)exponent);                                                     // Scaling by power of 10...
+  }
+
+  return (float)(sign*value);                                                                       // Returning value...
+}
+
+// Finding a section ("$Name" line), returning its 1st line (NULL if missing):
+const char* msh_section (
+                         const char*        begin,                                                  // Text begin.
+                         const char*        end,                                                    // Text end.
+                         std::string        name                                                    // Section name.
+                        )
+{
+  const char*              p;                                                                       // Text pointer.
+
+  name = "\n" + name;                                                                               // Matching section @ line start...
+  p    = std::search (begin, end, name.begin (), name.end ());                                      // Finding section...
+
+  return (p == end) ? NULL : msh_next_line (p + 1, end);                                            // Returning 1st section line...
+}
+
+// # of nodes of a gmsh element type (0 = unsupported):
+size_t msh_element_nodes (
+                          long type                                                                 // gmsh element type.
+                         )
+{
+  switch(type)
+  {
+    case 1:  return 2;                                                                              // 2-node line.
+    case 2:  return 3;                                                                              // 3-node triangle.
+    case 3:  return 4;                                                                              // 4-node quadrangle.
+    case 4:  return 4;                                                                              // 4-node tetrahedron.
+    case 5:  return 8;                                                                              // 8-node hexahedron.
+    case 6:  return 6;                                                                              // 6-node prism.
+    case 7:  return 5;                                                                              // 5-node pyramid.
+    case 8:  return 3;                                                                              // 3-node line.
+    case 9:  return 6;                                                                              // 6-node triangle.
+    case 10: return 9;                                                                              // 9-node quadrangle.
+    case 11: return 10;                                                                             // 10-node tetrahedron.
+    case 15: return 1;                                                                              // 1-node point.
+    default: return 0;                                                                              // Unsupported.
+  }
+}
+
+// Parsing a gmsh 4.1 ASCII mesh in parallel: fills the nodes, the elements of the highest dimension and
+// the nodes of each physical group ("dim, tag" -> sorted unique node indexes), as "mesh::physical".
+// Returns "false" (nothing parsed) if the file is missing, not 4.1 ASCII or has unsupported elements,
+// if a node tag is outside the declared tag range or if an element refers to an unknown node tag. A
+// tag range wider than the file size is rejected as malformed (it would only size the tag index).
+bool msh_parse (
+                std::string                                         file_name,                      // Mesh file name.
+                mesh*                                               object,                         // Mesh object.
+                std::map<std::pair<long, long>, std::vector<size_t> >& physical                     // Physical group nodes.
+               )
+{
+  const char*              data;                                                                    // File data.
+  const char*              end;                                                                     // File end.
+  const char*              p;                                                                       // Text pointer.
+  size_t                   size;                                                                    // File size [bytes].
+  std::map<std::pair<long, long>, std::vector<long> > entity;                                       // Entity ("dim, tag") physical tags.
+  std::vector<msh_chunk>   tag_chunk;                                                               // Node tag chunks.
+  std::vector<msh_chunk>   xyz_chunk;                                                               // Node coordinate chunks.
+  std::vector<msh_chunk>   element_chunk;                                                           // Element chunks.
+  std::vector<msh_block>   block;                                                                   // Element blocks.
+  std::vector<long>        node_tag;                                                                // Node tags [#].
+  std::vector<float>       node_xyz;                                                                // Node coordinates [m].
+  std::vector<size_t>      tag_index;                                                               // Node index of each node tag [#].
+  std::vector<size_t>      element_node;                                                            // Element nodes [#].
+  std::vector<long>*       tags;                                                                    // Physical tags of an entity.
+  std::vector<size_t>*     group;                                                                   // Physical group nodes.
+  size_t                   nodes;                                                                   // # of nodes [#].
+  size_t                   elements;                                                                // # of elements [#].
+  size_t                   blocks;                                                                  // # of blocks [#].
+  size_t                   count;                                                                   // # of block lines [#].
+  size_t                   line;                                                                    // Line index [#].
+  size_t                   base;                                                                    // Element node index [#].
+  size_t                   first;                                                                   // 1st element of highest dimension [#].
+  long                     dim_max = -1;                                                            // Highest element dimension.
+  long                     numbers[4];                                                              // Entity counts (points, curves, surfaces, volumes).
+  long                     dim;                                                                     // Entity dimension.
+  long                     tag;                                                                     // Entity tag.
+  long                     min_tag = 0;                                                             // Min node tag.
+  long                     max_tag = -1;                                                            // Max node tag.
+  size_t                   b;                                                                       // Block index [#].
+  size_t                   i;                                                                       // Index [#].
+  size_t                   j;                                                                       // Index [#].
+  bool                     valid   = true;                                                          // Valid mesh flag.
+  std::atomic<bool>        known   {true};                                                          // Known node tags flag (parallel parsing).
+
+  mapped_file              file (file_name);                                                        // Mesh file.
+
+  data  = file.data;                                                                                // Setting mesh data...
+  size  = file.size;                                                                                // Setting mesh size...
+
+  if(data == NULL)
+  {
+    return false;                                                                                   // Missing, empty or unreadable mesh...
+  }
+
+  end   = data + size;                                                                              // Setting file end...
+
+  // CHECKING FORMAT (4.1 ASCII) AND SECTIONS:
+  p     = NULL;                                                                                     // Resetting text pointer...
+
+  if((size >= 11) && (std::strncmp (data, "$MeshFormat", 11) == 0))
+  {
+    p = msh_next_line (data, end);                                                                  // Skipping format header...
+  }
+
+  valid = (p != NULL) && (msh_float (p, end) == 4.1f) && (msh_int (p, end) == 0) &&
+          (msh_section (data, end, "$EndNodes") != NULL) &&
+          (msh_section (data, end, "$EndElements") != NULL);                                        // Checking format...
+
+  // PARSING ENTITIES (physical tags, serial: one line per entity):
+  p     = valid ? msh_section (data, end, "$Entities") : NULL;                                      // Finding entities...
+
+  if(p != NULL)
+  {
+    for(dim = 0; dim < 4; dim++)
+    {
+      numbers[dim] = msh_int (p, end);                                                              // Getting # of entities...
+    }
+
+    p = msh_next_line (p, end);                                                                     // Skipping to 1st entity...
+
+    for(dim = 0; dim < 4; dim++)
+    {
+      for(i = 0; i < (size_t)numbers[dim]; i++)
+      {
+        tag = msh_int (p, end);                                                                     // Getting entity tag...
+
+        for(j = 0; j < ((dim == 0) ? 3 : 6); j++)
+        {
+          msh_float (p, end);                                                                       // Skipping point or bounding box...
+        }
+
+        for(j = msh_int (p, end); j > 0; j--)
+        {
+          entity[std::make_pair (dim, tag)].push_back (msh_int (p, end));                           // Getting physical tag...
+        }
+
+        p = msh_next_line (p, end);                                                                 // Skipping bounding entities...
+      }
+    }
+  }
+
+  // FINDING NODE CHUNKS (serial: line starts only):
+  p = valid ? msh_section (data, end, "$Nodes") : NULL;                                             // Finding nodes...
+
+  if(p != NULL)
+  {
+    blocks  = msh_int (p, end);                                                                     // Getting # of node blocks...
+    nodes   = msh_int (p, end);                                                                     // Getting # of nodes...
+    min_tag = msh_int (p, end);                                                                     // Getting min node tag...
+    max_tag = msh_int (p, end);                                                                     // Getting max node tag...
+    valid   = valid && (min_tag >= 0) && (min_tag <= max_tag);                                      // Checking node tag order...
+    valid   = valid && ((size_t)(max_tag - min_tag) < size);                                        // Checking node tag range (at most one tag per byte)...
+    tag_index.assign (valid ? max_tag + 1 : 0, SIZE_MAX);                                           // Initializing node index of node tags (SIZE_MAX = unknown)...
+    p       = msh_next_line (p, end);                                                               // Skipping to 1st block...
+    line    = 0;                                                                                    // Resetting line index...
+
+    for(b = 0; b < blocks; b++)
+    {
+      msh_int (p, end);                                                                             // Skipping entity dimension...
+      msh_int (p, end);                                                                             // Skipping entity tag...
+      msh_int (p, end);                                                                             // Skipping parametric flag...
+      count = msh_int (p, end);                                                                     // Getting # of block nodes...
+      p     = msh_next_line (p, end);                                                               // Skipping to 1st node tag...
+
+      for(i = 0; i < count; i++)
+      {
+        if(i%MSH_CHUNK == 0)
+        {
+          tag_chunk.push_back ({p, line + i, std::min<size_t> (MSH_CHUNK, count - i), 0, 0});       // Adding node tag chunk...
+        }
+
+        p = msh_next_line (p, end);                                                                 // Skipping node tag...
+      }
+
+      for(i = 0; i < count; i++)
+      {
+        if(i%MSH_CHUNK == 0)
+        {
+          xyz_chunk.push_back ({p, line + i, std::min<size_t> (MSH_CHUNK, count - i), 0, 0});       // Adding node coordinate chunk...
+        }
+
+        p = msh_next_line (p, end);                                                                 // Skipping node coordinates...
+      }
+
+      line += count;                                                                                // Accumulating line index...
+    }
+
+    valid = valid && (line == nodes);                                                               // Checking # of nodes...
+  }
+  else
+  {
+    valid = false;                                                                                  // No nodes...
+  }
+
+  // FINDING ELEMENT CHUNKS (serial: line starts only):
+  p = valid ? msh_section (data, end, "$Elements") : NULL;                                          // Finding elements...
+
+  if(p != NULL)
+  {
+    blocks   = msh_int (p, end);                                                                    // Getting # of element blocks...
+    elements = msh_int (p, end);                                                                    // Getting # of elements...
+    p        = msh_next_line (p, end);                                                              // Skipping to 1st block...
+    line     = 0;                                                                                   // Resetting line index...
+    base     = 0;                                                                                   // Resetting element node index...
+
+    for(b = 0; (b < blocks) && valid; b++)
+    {
+      dim   = msh_int (p, end);                                                                     // Getting entity dimension...
+      tag   = msh_int (p, end);                                                                     // Getting entity tag...
+      j     = msh_element_nodes (msh_int (p, end));                                                 // Getting # of nodes per element...
+      count = msh_int (p, end);                                                                     // Getting # of block elements...
+      p     = msh_next_line (p, end);                                                               // Skipping to 1st element...
+      valid = (j > 0);                                                                              // Checking element type...
+      block.push_back ({dim, tag, j, line, count, base});                                           // Adding element block...
+      dim_max = std::max (dim_max, dim);                                                            // Updating highest element dimension...
+
+      for(i = 0; i < count; i++)
+      {
+        if(i%MSH_CHUNK == 0)
+        {
+          element_chunk.push_back ({
+                                    p,                                                              // 1st line.
+                                    line + i,                                                       // 1st line index (section wide) [#].
+                                    std::min<size_t> (MSH_CHUNK, count - i),                        // # of lines [#].
+                                    j,                                                              // # of nodes per element [#].
+                                    base + i*j                                                      // 1st element node index [#].
+                                   });
+        }
+
+        p = msh_next_line (p, end);                                                                 // Skipping element...
+      }
+
+      line += count;                                                                                // Accumulating line index...
+      base += count*j;                                                                              // Accumulating element node index...
+    }
+
+    valid = valid && (line == elements);                                                            // Checking # of elements...
+  }
+  else
+  {
+    valid = false;                                                                                  // No elements...
+  }
+
+  if(valid)
+  {
+    // PARSING NODES (parallel):
+    node_tag.resize (nodes);                                                                        // Initializing node tags...
+    node_xyz.resize (3*nodes);                                                                      // Initializing node coordinates...
+
+    parallel_for (tag_chunk.size (), [&](size_t first, size_t last)
+    {
+      for(size_t c = first; c < last; c++)
+      {
+        const char* q = tag_chunk[c].begin;                                                         // Text pointer.
+
+        for(size_t l = tag_chunk[c].line; l < tag_chunk[c].line + tag_chunk[c].lines; l++)
+        {
+          node_tag[l] = msh_int (q, end);                                                           // Parsing node tag...
+
+          if((node_tag[l] >= min_tag) && (node_tag[l] <= max_tag))
+          {
+            tag_index[node_tag[l]] = l;                                                             // Setting node index of node tag...
+          }
+          else
+          {
+            known = false;                                                                          // Node tag out of the declared range...
+          }
+
+          q = msh_next_line (q, end);                                                               // Skipping to next node tag...
+        }
+      }
+    });
+
+    parallel_for (xyz_chunk.size (), [&](size_t first, size_t last)
+    {
+      for(size_t c = first; c < last; c++)
+      {
+        const char* q = xyz_chunk[c].begin;                                                         // Text pointer.
+
+        for(size_t l = xyz_chunk[c].line; l < xyz_chunk[c].line + xyz_chunk[c].lines; l++)
+        {
+          node_xyz[3*l + 0] = msh_float (q, end);                                                   // Parsing "x" coordinate...
+          node_xyz[3*l + 1] = msh_float (q, end);                                                   // Parsing "y" coordinate...
+          node_xyz[3*l + 2] = msh_float (q, end);                                                   // Parsing "z" coordinate...
+          q                 = msh_next_line (q, end);                                               // Skipping parametric coordinates...
+        }
+      }
+    });
+
+    // PARSING ELEMENTS (parallel):
+    element_node.resize (base);                                                                     // Initializing element nodes...
+
+    parallel_for (element_chunk.size (), [&](size_t first, size_t last)
+    {
+      for(size_t c = first; c < last; c++)
+      {
+        const char* q = element_chunk[c].begin;                                                     // Text pointer.
+        size_t      n = element_chunk[c].base;                                                      // Element node index [#].
+
+        for(size_t l = 0; l < element_chunk[c].lines; l++)
+        {
+          msh_int (q, end);                                                                         // Skipping element tag...
+
+          for(size_t k = 0; k < element_chunk[c].width; k++)
+          {
+            long t = msh_int (q, end);                                                              // Element node tag.
+
+            if((t >= min_tag) && (t <= max_tag) && (tag_index[t] != SIZE_MAX))
+            {
+              element_node[n] = tag_index[t];                                                       // Parsing element node...
+            }
+            else
+            {
+              known = false;                                                                        // Unknown element node tag...
+            }
+
+            n++;                                                                                    // Next element node...
+          }
+
+          q = msh_next_line (q, end);                                                               // Skipping to next element...
+        }
+      }
+    });
+
+    valid = known;                                                                                  // Checking node tags...
+  }
+
+  if(valid)
+  {
+    // SETTING MESH NODES:
+    object->node.resize (nodes);                                                                    // Initializing nodes...
+
+    parallel_for (nodes, [&](size_t first, size_t last)
+    {
+      for(size_t n = first; n < last; n++)
+      {
+        object->node[n].x = node_xyz[3*n + 0];                                                      // Setting "x" position...
+        object->node[n].y = node_xyz[3*n + 1];                                                      // Setting "y" position...
+        object->node[n].z = node_xyz[3*n + 2];                                                      // Setting "z" position...
+        object->node[n].w = 1.0f;                                                                   // Setting "w" position...
+      }
+    });
+
+    // SETTING MESH ELEMENTS (highest dimension):
+    elements = 0;                                                                                   // Resetting # of elements...
+
+    for(b = 0; b < block.size (); b++)
+    {
+      elements += (block[b].dim == dim_max) ? block[b].count : 0;                                   // Counting elements of highest dimension...
+    }
+
+    object->element.resize (elements);                                                              // Initializing elements...
+    first = 0;                                                                                      // Resetting element index...
+
+    for(b = 0; b < block.size (); b++)
+    {
+      if(block[b].dim == dim_max)
+      {
+        parallel_for (block[b].count, [&](size_t e_min, size_t e_max)
+        {
+          size_t n_min;                                                                             // Element node minimum [#].
+
+          for(size_t e = e_min; e < e_max; e++)
+          {
+            n_min = block[b].base + e*block[b].width;                                               // Setting element node minimum...
+            object->element[first + e].node.assign (
+                                                    element_node.begin () + n_min,                  // Element nodes begin.
+                                                    element_node.begin () + n_min + block[b].width  // Element nodes end.
+                                                   );                                               // Setting element nodes...
+          }
+        });
+
+        first += block[b].count;                                                                    // Accumulating element index...
+      }
+    }
+
+    // SETTING PHYSICAL GROUPS (nodes of the elements of the group entities):
+    for(b = 0; b < block.size (); b++)
+    {
+      tags = &entity[std::make_pair (block[b].dim, block[b].entity)];                               // Getting block physical tags...
+
+      for(i = 0; i < tags->size (); i++)
+      {
+        group = &physical[std::make_pair (block[b].dim, (*tags)[i])];                               // Getting physical group...
+        group->insert (
+                       group->end (),                                                               // Group end.
+                       element_node.begin () + block[b].base,                                       // Block nodes begin.
+                       element_node.begin () + block[b].base + block[b].count*block[b].width        // Block nodes end.
+                      );                                                                            // Adding block nodes...
+      }
+    }
+
+    for(auto& g : physical)
+    {
+      std::sort (g.second.begin (), g.second.end ());                                               // Sorting group nodes...
+      g.second.erase (std::unique (g.second.begin (), g.second.end ()), g.second.end ());           // Uniquing group nodes...
+    }
+  }
+
+  return valid;                                                                                     // Returning parser status...
+}
+
+// STL loader: ASCII or binary triangles, duplicate vertices welded within STL_WELD times the bounding
+// box diagonal through a parallel spatial hash: vertices are sorted by grid cell (4 tolerances wide),
+// then each cell is compared with itself and with the neighbour cells its vertices are close to.
+#define STL_WELD    1.0E-6                                                                          // Weld tolerance, relative to the bounding box diagonal.
+#define STL_BUCKETS 256                                                                             // # of spatial hash sorting buckets [#].
+
+// Hashing a cell key to a hash table slot (power of 2 table size):
+inline size_t stl_hash (
+                        uint64_t key,                                                               // Cell key.
+                        size_t   table_size                                                         // Hash table size [#].
+                       )
+{
+  key ^= key >> 33;                                                                                 // Mixing bits (64-bit finalizer)...
+  key *= 0xFF51AFD7ED558CCDULL;                                                                     // Mixing bits (64-bit finalizer)...
+  key ^= key >> 33;                                                                                 // Mixing bits (64-bit finalizer)...
+
+  return key & (table_size - 1);                                                                    // Returning slot...
+}
+
+// Parsing the vertices of an ASCII STL text range (the "vertex" keywords starting in [begin, last)):
+void stl_ascii_range (
+                      const char*         begin,                                                    // Range begin.
+                      const char*         last,                                                     // Range end (keyword starts).
+                      const char*         end,                                                      // Text end.
+                      std::vector<float>& vertex                                                    // Vertex coordinates [m].
+                     )
+{
+  const std::string        keyword = "vertex";                                                      // Vertex keyword.
+  const char*              p       = begin;                                                         // Text pointer.
+
+  while((p = std::search (p, end, keyword.begin (), keyword.end ())) < last)
+  {
+    p += keyword.size ();                                                                           // Skipping keyword...
+    vertex.push_back (msh_float (p, end));                                                          // Parsing "x" coordinate...
+    vertex.push_back (msh_float (p, end));                                                          // Parsing "y" coordinate...
+    vertex.push_back (msh_float (p, end));                                                          // Parsing "z" coordinate...
+  }
+}
+
+// Loading an STL file (ASCII or binary) as a welded triangle mesh: fills the nodes and the elements.
+// Returns "false" (nothing loaded) if the file is missing or empty.
+bool stl_parse (
+                std::string file_name,                                                              // STL file name.
+                mesh*       object                                                                  // Mesh object.
+               )
+{
+  std::ifstream            file (file_name, std::ios::binary | std::ios::ate);                      // STL file.
+  std::vector<char>        data;                                                                    // STL data.
+  std::vector<float>       vertex;                                                                  // Vertex coordinates [m].
+  std::vector<std::vector<float> > part;                                                            // Vertex coordinates of each ASCII range [m].
+  std::vector<uint64_t>    cell;                                                                    // Vertex cell keys.
+  std::vector<size_t>      sorted;                                                                  // Vertices sorted by cell key [#].
+  std::vector<std::atomic<size_t> > fill (STL_BUCKETS);                                             // Bucket fill counters [#].
+  std::vector<size_t>      bucket_offset (STL_BUCKETS + 1, 0);                                      // Bucket start [#].
+  std::vector<uint64_t>    sorted_cell;                                                             // Sorted cell keys.
+  std::vector<size_t>      weld;                                                                    // Welded vertex of each vertex [#].
+  std::vector<size_t>      node;                                                                    // Node index of each welded vertex [#].
+  float                    box_min[3];                                                              // Bounding box minimum [m].
+  float                    box_max[3];                                                              // Bounding box maximum [m].
+  double                   diagonal = 0.0;                                                          // Bounding box diagonal [m].
+  double                   tolerance;                                                               // Weld tolerance [m].
+  double                   cell_size;                                                               // Spatial hash cell size [m].
+  size_t                   size;                                                                    // STL size [bytes].
+  size_t                   vertices;                                                                // # of vertices [#].
+  size_t                   triangles;                                                               // # of triangles [#].
+  size_t                   nodes;                                                                   // # of nodes [#].
+  size_t                   x_cells;                                                                 // # of "x" cells [#].
+  std::vector<size_t>      cell_start;                                                              // 1st sorted vertex of each cell [#].
+  std::vector<std::pair<uint64_t, size_t> > table;                                                  // Cell hash table (cell key, cell index).
+  size_t                   cells;                                                                   // # of cells [#].
+  size_t                   table_size;                                                              // Cell hash table size [#].
+  size_t                   slot;                                                                    // Cell hash table slot [#].
+  size_t                   parts;                                                                   // # of ASCII ranges [#].
+  cl_uint                  count;                                                                   // # of binary triangles [#].
+  size_t                   c;                                                                       // Coordinate index [#].
+  size_t                   i;                                                                       // Index [#].
+
+  if(!file)
+  {
+    return false;                                                                                   // No STL...
+  }
+
+  size = file.tellg ();                                                                             // Getting STL size...
+  data.resize (size + 1, 0);                                                                        // Initializing STL data (NUL terminated)...
+  file.seekg (0);                                                                                   // Rewinding STL file...
+  file.read (data.data (), size);                                                                   // Reading STL...
+
+  // PARSING VERTICES (binary: 50 bytes per triangle after an 84 bytes header; ASCII: in parallel):
+  if(size >= 84)
+  {
+    std::memcpy (&count, &data[80], sizeof (count));                                                // Getting # of binary triangles...
+  }
+
+  if((size >= 84) && (size == 84 + 50*(size_t)count))
+  {
+    vertex.resize (9*(size_t)count);                                                                // Initializing vertices...
+
+    parallel_for (count, [&](size_t first, size_t last)
+    {
+      for(size_t t = first; t < last; t++)
+      {
+        std::memcpy (&vertex[9*t], &data[84 + 50*t + 12], 9*sizeof (float));                        // Copying triangle vertices...
+      }
+    });
+  }
+  else
+  {
+    parts = std::max<size_t> (1, std::thread::hardware_concurrency ());                             // Setting # of ASCII ranges...
+    part.resize (parts);                                                                            // Initializing ASCII ranges...
+
+    parallel_for (parts, [&](size_t first, size_t last)
+    {
+      for(size_t r = first; r < last; r++)
+      {
+        stl_ascii_range (
+                         data.data () + r*size/parts,                                               // Range begin.
+                         data.data () + (r + 1)*size/parts,                                         // Range end.
+                         data.data () + size,                                                       // Text end.
+                         part[r]                                                                    // Range vertices.
+                        );                                                                          // Parsing range vertices...
+      }
+    });
+
+    for(i = 0; i < parts; i++)
+    {
+      vertex.insert (vertex.end (), part[i].begin (), part[i].end ());                              // Gathering range vertices...
+    }
+  }
+
+  vertices  = vertex.size ()/3;                                                                     // Setting # of vertices...
+  triangles = vertices/3;                                                                           // Setting # of triangles...
+  vertices  = 3*triangles;                                                                          // Dropping incomplete triangle...
+
+  if(triangles == 0)
+  {
+    return false;                                                                                   // Empty STL...
+  }
+
+  // COMPUTING SPATIAL HASH CELLS:
+  for(c = 0; c < 3; c++)
+  {
+    box_min[c] = vertex[c];                                                                         // Initializing bounding box minimum...
+    box_max[c] = vertex[c];                                                                         // Initializing bounding box maximum...
+
+    for(i = 0; i < vertices; i++)
+    {
+      box_min[c] = std::min (box_min[c], vertex[3*i + c]);                                          // Updating bounding box minimum...
+      box_max[c] = std::max (box_max[c], vertex[3*i + c]);                                          // Updating bounding box maximum...
+    }
+
+    diagonal += pow (box_max[c] - box_min[c], 2);                                                   // Accumulating bounding box diagonal...
+  }
+
+  tolerance = (diagonal > 0.0) ? STL_WELD*sqrt (diagonal) : 1.0;                                    // Setting weld tolerance...
+  cell_size = 4.0*tolerance;                                                                        // Setting cell size...
+  cell.resize (vertices);                                                                           // Initializing cell keys...
+
+  parallel_for (vertices, [&](size_t first, size_t last)
+  {
+    for(size_t v = first; v < last; v++)
+    {
+      cell[v] = 0;                                                                                  // Resetting cell key...
+
+      for(size_t d = 0; d < 3; d++)
+      {
+        cell[v] = (cell[v] << 21) | (uint64_t)((vertex[3*v + d] - box_min[d])/cell_size);           // Packing cell coordinate (21 bits)...
+      }
+    }
+  });
+
+  // SORTING VERTICES BY CELL (buckets by "x" cell, then each bucket sorted in parallel):
+  sorted.resize (vertices);                                                                         // Initializing sorted vertices...
+  sorted_cell.resize (vertices);                                                                    // Initializing sorted cell keys...
+
+  x_cells = (box_max[0] - box_min[0])/cell_size + 1;                                                // Setting # of "x" cells...
+
+  parallel_for (vertices, [&](size_t first, size_t last)
+  {
+    for(size_t v = first; v < last; v++)
+    {
+      fill[(cell[v] >> 42)*STL_BUCKETS/x_cells]++;                                                  // Counting bucket vertex...
+    }
+  });
+
+  for(i = 0; i < STL_BUCKETS; i++)
+  {
+    bucket_offset[i + 1] = bucket_offset[i] + fill[i];                                              // Accumulating bucket size...
+    fill[i]              = bucket_offset[i];                                                        // Resetting bucket fill counter...
+  }
+
+  parallel_for (vertices, [&](size_t first, size_t last)
+  {
+    for(size_t v = first; v < last; v++)
+    {
+      sorted[fill[(cell[v] >> 42)*STL_BUCKETS/x_cells]++] = v;                                      // Bucketing vertex...
+    }
+  });
+
+  parallel_for (STL_BUCKETS, [&](size_t first, size_t last)
+  {
+    for(size_t b = first; b < last; b++)
+    {
+      std::sort (
+                 sorted.begin () + bucket_offset[b],                                                // Bucket begin.
+                 sorted.begin () + bucket_offset[b + 1],                                            // Bucket end.
+                 [&cell](size_t u, size_t w) {return (cell[u] < cell[w]) || ((cell[u] == cell[w]) && (u < w));}
+                );                                                                                  // Sorting bucket by cell key and index...
+    }
+  });
+
+  parallel_for (vertices, [&](size_t first, size_t last)
+  {
+    for(size_t s = first; s < last; s++)
+    {
+      sorted_cell[s] = cell[sorted[s]];                                                             // Setting sorted cell key...
+    }
+  });
+
+  // HASHING CELLS (open addressing: cell key -> 1st sorted vertex of the cell):
+  for(i = 0; i < vertices; i++)
+  {
+    if((i == 0) || (sorted_cell[i] != sorted_cell[i - 1]))
+    {
+      cell_start.push_back (i);                                                                     // Adding cell...
+    }
+  }
+
+  cell_start.push_back (vertices);                                                                  // Closing last cell...
+  cells      = cell_start.size () - 1;                                                              // Setting # of cells...
+  table_size = 1;                                                                                   // Resetting hash table size...
+
+  while(table_size < 2*cells)
+  {
+    table_size *= 2;                                                                                // Doubling hash table size...
+  }
+
+  table.assign (table_size, std::make_pair (0, SIZE_MAX));                                          // Initializing hash table...
+
+  for(i = 0; i < cells; i++)
+  {
+    slot = stl_hash (sorted_cell[cell_start[i]], table_size);                                       // Hashing cell key...
+
+    while(table[slot].second != SIZE_MAX)
+    {
+      slot = (slot + 1) & (table_size - 1);                                                         // Probing next slot...
+    }
+
+    table[slot] = std::make_pair (sorted_cell[cell_start[i]], i);                                   // Inserting cell...
+  }
+
+  // WELDING VERTICES (to the lowest index vertex within tolerance, own and nearby neighbour cells):
+  weld.resize (vertices);                                                                           // Initializing welded vertices...
+
+  parallel_for (cells, [&](size_t first, size_t last)
+  {
+    uint64_t key;                                                                                   // Cell key.
+    uint64_t x[3];                                                                                  // Cell coordinates.
+    int      d_min[3];                                                                              // Neighbour cell offset minimum.
+    int      d_max[3];                                                                              // Neighbour cell offset maximum.
+    double   fraction;                                                                              // Vertex position in cell [#].
+    uint64_t neighbour_cell;                                                                        // Neighbour cell key.
+    size_t   neighbour[27];                                                                         // Neighbour cells [#].
+    size_t   neighbours;                                                                            // # of neighbour cells [#].
+    size_t   h;                                                                                     // Hash table slot [#].
+    size_t   n;                                                                                     // Neighbour cell index [#].
+    size_t   s;                                                                                     // Sorted vertex index [#].
+    size_t   r;                                                                                     // Sorted neighbour vertex index [#].
+    size_t   u;                                                                                     // Neighbour vertex [#].
+    size_t   v;                                                                                     // Vertex [#].
+
+    for(size_t c = first; c < last; c++)
+    {
+      key  = sorted_cell[cell_start[c]];                                                            // Getting cell key...
+      x[0] = key >> 42;                                                                             // Getting "x" cell coordinate...
+      x[1] = (key >> 21) & 0x1FFFFF;                                                                // Getting "y" cell coordinate...
+      x[2] = key & 0x1FFFFF;                                                                        // Getting "z" cell coordinate...
+
+      for(size_t d = 0; d < 3; d++)
+      {
+        d_min[d] = 0;                                                                               // Resetting neighbour cell offset minimum...
+        d_max[d] = 0;                                                                               // Resetting neighbour cell offset maximum...
+
+        for(s = cell_start[c]; s < cell_start[c + 1]; s++)
+        {
+          fraction = (vertex[3*sorted[s] + d] - box_min[d])/cell_size - x[d];                       // Computing vertex position in cell...
+          d_min[d] = ((fraction < 0.25) && (x[d] > 0)) ? -1 : d_min[d];                             // Setting lower neighbour cell...
+          d_max[d] = (fraction > 0.75) ? 1 : d_max[d];                                              // Setting upper neighbour cell...
+        }
+      }
+
+      neighbours = 0;                                                                               // Resetting # of neighbour cells...
+
+      for(int dx = d_min[0]; dx <= d_max[0]; dx++)
+      {
+        for(int dy = d_min[1]; dy <= d_max[1]; dy++)
+        {
+          for(int dz = d_min[2]; dz <= d_max[2]; dz++)
+          {
+            neighbour_cell = ((x[0] + dx) << 42) | ((x[1] + dy) << 21) | (x[2] + dz);               // Setting neighbour cell key...
+
+            for(h = stl_hash (neighbour_cell, table_size); table[h].second != SIZE_MAX; h = (h + 1) & (table_size - 1))
+            {
+              if(table[h].first == neighbour_cell)
+              {
+                neighbour[neighbours++] = table[h].second;                                          // Adding neighbour cell...
+                break;
+              }
+            }
+          }
+        }
+      }
+
+      for(s = cell_start[c]; s < cell_start[c + 1]; s++)
+      {
+        v       = sorted[s];                                                                        // Getting vertex...
+        weld[v] = v;                                                                                // Resetting welded vertex...
+
+        for(n = 0; n < neighbours; n++)
+        {
+          for(r = cell_start[neighbour[n]]; (r < cell_start[neighbour[n] + 1]) && (sorted[r] < weld[v]); r++)
+          {
+            u = sorted[r];                                                                          // Getting neighbour vertex...
+
+            if(pow (vertex[3*u + 0] - vertex[3*v + 0], 2) +
+               pow (vertex[3*u + 1] - vertex[3*v + 1], 2) +
+               pow (vertex[3*u + 2] - vertex[3*v + 2], 2) <= pow (tolerance, 2))
+            {
+              weld[v] = u;                                                                          // Welding vertex...
+            }
+          }
+        }
+      }
+    }
+  });
+
+  // NUMBERING NODES (welded vertices, in vertex order):
+  node.resize (vertices);                                                                           // Initializing node indexes...
+  nodes = 0;                                                                                        // Resetting # of nodes...
+
+  for(i = 0; i < vertices; i++)
+  {
+    while(weld[weld[i]] != weld[i])
+    {
+      weld[i] = weld[weld[i]];                                                                      // Following weld chain...
+    }
+
+    if(weld[i] == i)
+    {
+      node[i] = nodes++;                                                                            // Numbering node...
+    }
+  }
+
+  object->node.resize (nodes);                                                                      // Initializing nodes...
+  object->element.resize (triangles);                                                               // Initializing elements...
+
+  parallel_for (vertices, [&](size_t first, size_t last)
+  {
+    for(size_t v = first; v < last; v++)
+    {
+      if(weld[v] == v)
+      {
+        object->node[node[v]].x = vertex[3*v + 0];                                                  // Setting "x" position...
+        object->node[node[v]].y = vertex[3*v + 1];                                                  // Setting "y" position...
+        object->node[node[v]].z = vertex[3*v + 2];                                                  // Setting "z" position...
+        object->node[node[v]].w = 1.0f;                                                             // Setting "w" position...
+      }
+    }
+  });
+
+  parallel_for (triangles, [&](size_t first, size_t last)
+  {
+    for(size_t t = first; t < last; t++)
+    {
+      object->element[t].node.resize (3);                                                           // Initializing triangle nodes...
+
+      for(size_t k = 0; k < 3; k++)
+      {
+        object->element[t].node[k] = node[weld[3*t + k]];                                           // Setting triangle node...
+      }
+    }
+  });
+
+  return true;                                                                                      // Returning STL status...
+}
+
+// Finding the open boundary of a surface mesh (nodes of the edges used by a single element), which
+// stands for the "border" physical group of meshes without physical groups (e.g. STL):
+std::vector<size_t> mesh_open_boundary (
+                                        mesh* object                                                // Mesh object.
+                                       )
+{
+  std::vector<std::pair<size_t, size_t> > edge;                                                     // Element edges (lower node index first).
+  std::vector<size_t>      boundary;                                                                // Open boundary nodes.
+  size_t                   a;                                                                       // Edge 1st node [#].
+  size_t                   b;                                                                       // Edge 2nd node [#].
+  size_t                   i;                                                                       // Index [#].
+  size_t                   j;                                                                       // Index [#].
+
+  for(i = 0; i < object->element.size (); i++)
+  {
+    for(j = 0; j < object->element[i].node.size (); j++)
+    {
+      a = object->element[i].node[j];                                                               // Getting edge 1st node...
+      b = object->element[i].node[(j + 1)%object->element[i].node.size ()];                         // Getting edge 2nd node...
+      edge.push_back (std::make_pair (std::min (a, b), std::max (a, b)));                           // Adding element edge...
+    }
+  }
+
+  std::sort (edge.begin (), edge.end ());                                                           // Sorting edges (shared edges become adjacent)...
+
+  for(i = 0; i < edge.size (); i = j)
+  {
+    for(j = i + 1; (j < edge.size ()) && (edge[j] == edge[i]); j++)
+    {
+      ;                                                                                             // Skipping shared edge copies...
+    }
+
+    if(j == i + 1)
+    {
+      boundary.push_back (edge[i].first);                                                           // Adding open edge 1st node...
+      boundary.push_back (edge[i].second);                                                          // Adding open edge 2nd node...
+    }
+  }
+
+  std::sort (boundary.begin (), boundary.end ());                                                   // Sorting boundary nodes...
+  boundary.erase (std::unique (boundary.begin (), boundary.end ()), boundary.end ());               // Uniquing boundary nodes...
+
+  return boundary;                                                                                  // Returning open boundary nodes...
+}
@@ -0,0 +1,104 @@
+/// @file
+
+// Mesh input: binary mesh cache, gmsh 4.1 ASCII and STL parsers, mesh adjacency.
+#ifndef mesh_io_hpp
+#define mesh_io_hpp
+
+#include "nu.hpp"                                                                                   // Neutrino's header file.
+#include <algorithm>                                                                                // Thread ranges.
+#include <map>                                                                                      // gmsh parser physical groups.
+#include <string>                                                                                   // File names.
+#include <thread>                                                                                   // Parallel loops.
+#include <vector>                                                                                   // Mesh arrays.
+
+// Running "body (first, last)" on the index range [0, count), split in one contiguous range per hardware thread:
+template <typename F>
+void parallel_for (
+                   size_t count,                                                                    // # of indexes [#].
+                   F      body                                                                      // Range body.
+                  )
+{
+  size_t                   threads = std::max (1u, std::thread::hardware_concurrency ());           // # of threads [#].
+  size_t                   chunk   = (count + threads - 1)/threads;                                 // # of indexes per thread [#].
+  std::vector<std::thread> pool;                                                                    // Thread pool.
+  size_t                   t;                                                                       // Thread index [#].
+
+  for(t = 0; (t < threads) && (t*chunk < count); t++)
+  {
+    pool.emplace_back (body, t*chunk, std::min (count, (t + 1)*chunk));                             // Running range body...
+  }
+
+  for(t = 0; t < pool.size (); t++)
+  {
+    pool[t].join ();                                                                                // Waiting for range body...
+  }
+}
+
+// Building the node adjacency of a mesh (CSR, 32-bit) from its elements in linear time: two nodes are
+// neighbours when they share an element. The node pairs of all elements are bucketed by 1st node
+// (counting sort, prefix sum), then each bucket is sorted and made unique, all in parallel.
+void mesh_adjacency (
+                     mesh*                 object,                                                  // Mesh object.
+                     std::vector<cl_uint>& offset,                                                  // Neighbour stride start (nodes + 1) [#].
+                     std::vector<cl_uint>& nearest                                                  // Neighbour indexes [#].
+                    );
+
+// Computing the link lengths of a mesh adjacency (CSR), in parallel over the nodes:
+void mesh_lengths (
+                   mesh*                 object,                                                    // Mesh object.
+                   std::vector<cl_uint>& offset,                                                    // Neighbour stride start (nodes + 1) [#].
+                   std::vector<cl_uint>& nearest,                                                   // Neighbour indexes [#].
+                   std::vector<float>&   length                                                     // Link lengths [m].
+                  );
+
+// Saving the binary mesh cache, "false" (no cache file left) if it could not be written:
+bool mesh_cache_save (
+                      std::string           file_name,                                              // Cache file name.
+                      std::string           source_name,                                            // Mesh source file name.
+                      mesh*                 object,                                                 // Mesh object.
+                      std::vector<size_t>&  border,                                                 // Nodes on border.
+                      std::vector<size_t>&  side_x,                                                 // Nodes on "x" side.
+                      std::vector<size_t>&  side_y,                                                 // Nodes on "y" side.
+                      std::vector<cl_uint>& offset,                                                 // Neighbour stride start (nodes + 1) [#].
+                      std::vector<cl_uint>& nearest,                                                // Neighbour indexes [#].
+                      std::vector<float>&   length                                                  // Link lengths [m].
+                     );
+
+// Loading the binary mesh cache (memory-mapped where available), "false" if missing, stale, truncated
+// or corrupt: the size of every section is checked against the file size and all stride starts and
+// node indexes are bounds-checked before anything is copied.
+bool mesh_cache_load (
+                      std::string           file_name,                                              // Cache file name.
+                      std::string           source_name,                                            // Mesh source file name.
+                      mesh*                 object,                                                 // Mesh object.
+                      std::vector<size_t>&  border,                                                 // Nodes on border.
+                      std::vector<size_t>&  side_x,                                                 // Nodes on "x" side.
+                      std::vector<size_t>&  side_y,                                                 // Nodes on "y" side.
+                      std::vector<cl_uint>& offset,                                                 // Neighbour stride start (nodes + 1) [#].
+                      std::vector<cl_uint>& nearest,                                                // Neighbour indexes [#].
+                      std::vector<float>&   length                                                  // Link lengths [m].
+                     );
+
+// Parsing a gmsh 4.1 ASCII mesh in parallel: fills the nodes, the elements of the highest dimension and
+// the nodes of each physical group ("dim, tag" -> sorted unique node indexes), as "mesh::physical".
+// Returns "false" (nothing parsed) if the file is missing, not 4.1 ASCII or has unsupported elements.
+bool msh_parse (
+                std::string                                         file_name,                      // Mesh file name.
+                mesh*                                               object,                         // Mesh object.
+                std::map<std::pair<long, long>, std::vector<size_t> >& physical                     // Physical group nodes.
+               );
+
+// Loading an STL file (ASCII or binary) as a welded triangle mesh: fills the nodes and the elements.
+// Returns "false" (nothing loaded) if the file is missing or empty.
+bool stl_parse (
+                std::string file_name,                                                              // STL file name.
+                mesh*       object                                                                  // Mesh object.
+               );
+
+// Finding the open boundary of a surface mesh (nodes of the edges used by a single element), which
+// stands for the "border" physical group of meshes without physical groups (e.g. STL):
+std::vector<size_t> mesh_open_boundary (
+                                        mesh* object                                                // Mesh object.
+                                       );
+
+#endif
@@ -0,0 +1,51 @@
+/// @file
+
+// 32-bit integer buffers: Neutrino's integer buffers ("int1", "int4") hold 64-bit "long" elements.
+#ifndef int32_buffer_hpp
+#define int32_buffer_hpp
+
+#include "nu.hpp"                                                                                   // Neutrino's header file.
+#include <cstring>                                                                                  // Copying integer bits.
+
+// 32-bit integers (node indexes, offsets) stored in the 32-bit elements of a Neutrino float buffer "B"
+// ("float1" or "float4"), half the size of "int1". Layout: integer "n" occupies bytes [4n, 4n + 4)
+// of the buffer, i.e. element "n" of a "float1" and component "n%4" of element "n/4" of a "float4".
+// The kernels declare the argument as "__global int*" ("int2*", "int4*", ...) and read the integers
+// unchanged: the bits are copied, never converted to float, hence no rounding nor NaN quieting.
+template <class B>
+class int32_buffer : public B
+{
+public:
+  // Setting "count" consecutive integers from integer "n" on:
+  void set (
+            size_t        n,                                                                        // 1st integer index [#].
+            const cl_int* value,                                                                    // Integer values.
+            size_t        count                                                                     // Number of integers [#].
+           )
+  {
+    std::memcpy ((char*)&this->data[0] + n*sizeof (cl_int), value, count*sizeof (cl_int));          // Copying integer bits...
+  }
+
+  // Setting integer "n":
+  void set (
+            size_t n,                                                                               // Integer index [#].
+            cl_int value                                                                            // Integer value.
+           )
+  {
+    set (n, &value, 1);                                                                             // Copying integer bits...
+  }
+
+  // Getting integer "n":
+  cl_int get (
+              size_t n                                                                              // Integer index [#].
+             )
+  {
+    cl_int value;                                                                                   // Integer value.
+
+    std::memcpy (&value, (char*)&this->data[0] + n*sizeof (cl_int), sizeof (cl_int));               // Copying integer bits...
+
+    return value;
+  }
+};
+
+#endif
@@ -0,0 +1,210 @@
+/// @file
+
+#include "mesh_reorder.hpp"                                                                         // Node renumbering header file.
+#include <algorithm>                                                                                // Node orders.
+#include <cmath>                                                                                    // Hilbert curve bounding box.
+
+// Computing the bandwidth of a node numbering (max index distance between linked nodes):
+size_t bandwidth (
+                  std::vector<cl_uint>& offset,                                                     // Neighbour stride start (original indexes) [#].
+                  std::vector<cl_uint>& nearest,                                                    // Neighbour indexes (original indexes) [#].
+                  std::vector<size_t>&  renumber                                                    // New index of each original node [#].
+                 )
+{
+  size_t                   b = 0;                                                                   // Bandwidth [#].
+  size_t                   i;                                                                       // Node index [#].
+  size_t                   j;                                                                       // Neighbour index [#].
+  size_t                   k;                                                                       // Neighbour node index [#].
+
+  for(i = 0; i + 1 < offset.size (); i++)
+  {
+    for(j = offset[i]; j < offset[i + 1]; j++)
+    {
+      k = nearest[j];                                                                               // Getting neighbour node...
+      b = std::max (b, std::max (renumber[i], renumber[k]) - std::min (renumber[i], renumber[k]));  // Updating bandwidth...
+    }
+  }
+
+  return b;                                                                                         // Returning bandwidth...
+}
+
+// Reverse Cuthill-McKee node order (original index of each new index): breadth-first visit of each
+// connected component from a minimum degree node, neighbours by increasing degree, then reversed.
+std::vector<size_t> rcm_order (
+                               std::vector<cl_uint>& offset,                                        // Neighbour stride start (original indexes) [#].
+                               std::vector<cl_uint>& nearest                                        // Neighbour indexes (original indexes) [#].
+                              )
+{
+  size_t                   nodes = offset.size () - 1;                                              // Number of nodes [#].
+  std::vector<size_t>      order;                                                                   // Node order [#].
+  std::vector<size_t>      start (nodes);                                                           // Start candidates, by increasing degree [#].
+  std::vector<size_t>      next;                                                                    // Neighbours of the current node [#].
+  std::vector<bool>        visited (nodes, false);                                                  // Visited node flags.
+  size_t                   head;                                                                    // Visit queue head [#].
+  size_t                   node;                                                                    // Current node [#].
+  size_t                   i;                                                                       // Node index [#].
+  size_t                   j;                                                                       // Neighbour index [#].
+
+  auto                     by_degree = [&offset](size_t a, size_t b)
+                                       {
+                                         return offset[a + 1] - offset[a] < offset[b + 1] - offset[b];
+                                       };                                                           // Increasing degree order.
+
+  for(i = 0; i < nodes; i++)
+  {
+    start[i] = i;                                                                                   // Setting start candidate...
+  }
+
+  std::stable_sort (start.begin (), start.end (), by_degree);                                       // Sorting start candidates...
+
+  for(i = 0; i < nodes; i++)
+  {
+    if(visited[start[i]])
+    {
+      continue;                                                                                     // Node of an already visited component...
+    }
+
+    visited[start[i]] = true;                                                                       // Visiting component start node...
+    order.push_back (start[i]);                                                                     // Appending component start node...
+
+    for(head = order.size () - 1; head < order.size (); head++)
+    {
+      node = order[head];                                                                           // Getting current node...
+      next.assign (nearest.begin () + offset[node], nearest.begin () + offset[node + 1]);           // Getting neighbours...
+      std::stable_sort (next.begin (), next.end (), by_degree);                                     // Sorting neighbours by degree...
+
+      for(j = 0; j < next.size (); j++)
+      {
+        if(!visited[next[j]])
+        {
+          visited[next[j]] = true;                                                                  // Visiting neighbour...
+          order.push_back (next[j]);                                                                // Appending neighbour...
+        }
+      }
+    }
+  }
+
+  std::reverse (order.begin (), order.end ());                                                      // Reversing Cuthill-McKee order...
+
+  return order;                                                                                     // Returning node order...
+}
+
+// Hilbert curve index of a point on a 2^bits grid (Skilling's transpose algorithm, 3D):
+cl_ulong hilbert_index (
+                        cl_uint x,                                                                  // "x" grid coordinate [#].
+                        cl_uint y,                                                                  // "y" grid coordinate [#].
+                        cl_uint z,                                                                  // "z" grid coordinate [#].
+                        int     bits                                                                // # of bits per coordinate [#].
+                       )
+{
+  cl_uint                  X[3] = {x, y, z};                                                        // Coordinates, then transposed index.
+  cl_uint                  M    = 1u << (bits - 1);                                                 // Most significant bit.
+  cl_uint                  P;                                                                       // Lower bits mask.
+  cl_uint                  Q;                                                                       // Current bit.
+  cl_uint                  t;                                                                       // Swap bits.
+  cl_ulong                 index = 0;                                                               // Hilbert index.
+  int                      b;                                                                       // Bit index [#].
+  int                      i;                                                                       // Coordinate index [#].
+
+  for(Q = M; Q > 1; Q >>= 1)
+  {
+    P = Q - 1;                                                                                      // Setting lower bits mask...
+
+    for(i = 0; i < 3; i++)
+    {
+      if(X[i] & Q)
+      {
+        X[0] ^= P;                                                                                  // Inverting lower bits...
+      }
+      else
+      {
+        t     = (X[0] ^ X[i]) & P;                                                                  // Exchanging lower bits...
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  for(i = 1; i < 3; i++)
+  {
+    X[i] ^= X[i - 1];                                                                               // Gray encoding...
+  }
+
+  t = 0;                                                                                            // Resetting swap bits...
+
+  for(Q = M; Q > 1; Q >>= 1)
+  {
+    if(X[2] & Q)
+    {
+      t ^= Q - 1;                                                                                   // Accumulating Gray correction...
+    }
+  }
+
+  for(i = 0; i < 3; i++)
+  {
+    X[i] ^= t;                                                                                      // Applying Gray correction...
+  }
+
+  for(b = bits - 1; b >= 0; b--)
+  {
+    for(i = 0; i < 3; i++)
+    {
+      index = (index << 1) | ((X[i] >> b) & 1);                                                     // Interleaving transposed index bits...
+    }
+  }
+
+  return index;                                                                                     // Returning Hilbert index...
+}
+
+// Hilbert curve node order (original index of each new index): nodes sorted by the Hilbert index of
+// their position, quantized on a 2^10 grid spanning the mesh bounding box.
+std::vector<size_t> hilbert_order (
+                                   mesh* object                                                     // Mesh object.
+                                  )
+{
+  size_t                   nodes = object->node.size ();                                            // Number of nodes [#].
+  std::vector<size_t>      order (nodes);                                                           // Node order [#].
+  std::vector<cl_ulong>    index (nodes);                                                           // Hilbert index of each node.
+  float                    min[3] = {+INFINITY, +INFINITY, +INFINITY};                              // Bounding box minimum [m].
+  float                    max[3] = {-INFINITY, -INFINITY, -INFINITY};                              // Bounding box maximum [m].
+  float                    p[3];                                                                    // Node position [m].
+  cl_uint                  q[3];                                                                    // Node grid coordinates [#].
+  size_t                   i;                                                                       // Node index [#].
+  int                      d;                                                                       // Coordinate index [#].
+
+  for(i = 0; i < nodes; i++)
+  {
+    p[0] = object->node[i].x;                                                                       // Getting "x" position...
+    p[1] = object->node[i].y;                                                                       // Getting "y" position...
+    p[2] = object->node[i].z;                                                                       // Getting "z" position...
+
+    for(d = 0; d < 3; d++)
+    {
+      min[d] = std::min (min[d], p[d]);                                                             // Updating bounding box minimum...
+      max[d] = std::max (max[d], p[d]);                                                             // Updating bounding box maximum...
+    }
+  }
+
+  for(i = 0; i < nodes; i++)
+  {
+    p[0] = object->node[i].x;                                                                       // Getting "x" position...
+    p[1] = object->node[i].y;                                                                       // Getting "y" position...
+    p[2] = object->node[i].z;                                                                       // Getting "z" position...
+
+    for(d = 0; d < 3; d++)
+    {
+      q[d] = (max[d] > min[d]) ? (cl_uint)(1023.0f*(p[d] - min[d])/(max[d] - min[d])) : 0;          // Quantizing position...
+    }
+
+    index[i] = hilbert_index (q[0], q[1], q[2], 10);                                                // Computing Hilbert index...
+    order[i] = i;                                                                                   // Setting node (unsorted)...
+  }
+
+  std::stable_sort (
+                    order.begin (),                                                                 // Order begin.
+                    order.end (),                                                                   // Order end.
+                    [&index](size_t a, size_t b) {return index[a] < index[b];}                      // Increasing Hilbert index.
+                   );
+
+  return order;                                                                                     // Returning node order...
+}
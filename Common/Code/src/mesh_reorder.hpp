@@ -0,0 +1,30 @@
+/// @file
+
+// Node renumbering: bandwidth, reverse Cuthill-McKee and Hilbert curve orders.
+#ifndef mesh_reorder_hpp
+#define mesh_reorder_hpp
+
+#include "nu.hpp"                                                                                   // Neutrino's header file.
+#include <vector>                                                                                   // Node orders.
+
+// Computing the bandwidth of a node numbering (max index distance between linked nodes):
+size_t bandwidth (
+                  std::vector<cl_uint>& offset,                                                     // Neighbour stride start (original indexes) [#].
+                  std::vector<cl_uint>& nearest,                                                    // Neighbour indexes (original indexes) [#].
+                  std::vector<size_t>&  renumber                                                    // New index of each original node [#].
+                 );
+
+// Reverse Cuthill-McKee node order (original index of each new index): breadth-first visit of each
+// connected component from a minimum degree node, neighbours by increasing degree, then reversed.
+std::vector<size_t> rcm_order (
+                               std::vector<cl_uint>& offset,                                        // Neighbour stride start (original indexes) [#].
+                               std::vector<cl_uint>& nearest                                        // Neighbour indexes (original indexes) [#].
+                              );
+
+// Hilbert curve node order (original index of each new index): nodes sorted by the Hilbert index of
+// their position, quantized on a 2^10 grid spanning the mesh bounding box.
+std::vector<size_t> hilbert_order (
+                                   mesh* object                                                     // Mesh object.
+                                  );
+
+#endif
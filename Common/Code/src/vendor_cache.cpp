@@ -0,0 +1,88 @@
+/// @file
+
+#include "vendor_cache.hpp"                                                                         // OpenCL vendor program caches header file.
+#include <cstdlib>                                                                                  // Environment variables.
+#include <filesystem>                                                                               // Cache directories.
+#include <iostream>                                                                                 // Cache message.
+
+#ifdef __APPLE__
+  #include <mach-o/dyld.h>                                                                          // Executable path (macOS).
+  #include <climits>                                                                                // PATH_MAX.
+  #include <cstdint>                                                                                // Executable path size.
+#endif
+
+#ifdef WIN32
+  #include <windows.h>                                                                              // Executable path (Windows).
+#endif
+
+// Getting the directory of the running executable (empty if unknown):
+static std::filesystem::path executable_home ()
+{
+  std::error_code          error;                                                                   // Path error.
+  std::filesystem::path    path;                                                                    // Executable path.
+
+#if defined(__linux__)
+  path = std::filesystem::read_symlink ("/proc/self/exe", error);                                   // Getting executable path...
+#elif defined(__APPLE__)
+  char                     name[PATH_MAX];                                                          // Executable path.
+  uint32_t                 size = sizeof (name);                                                    // Executable path size.
+
+  if(_NSGetExecutablePath (name, &size) == 0)
+  {
+    path = std::filesystem::canonical (name, error);                                                // Getting executable path...
+  }
+#elif defined(WIN32)
+  char                     name[MAX_PATH];                                                          // Executable path.
+  DWORD                    size = GetModuleFileNameA (NULL, name, MAX_PATH);                        // Executable path size.
+
+  if((size > 0) && (size < MAX_PATH))
+  {
+    path = std::filesystem::path (std::string (name, size));                                        // Getting executable path...
+  }
+#endif
+
+  if(error || path.empty ())
+  {
+    return std::filesystem::path ();                                                                // Unknown executable path...
+  }
+
+  return path.parent_path ();                                                                       // Returning executable directory...
+}
+
+void vendor_cache (
+                   std::string cache_home                                                           // Cache home directory.
+                  )
+{
+  const char*              runtime[][4] =                                                           // Runtime variables (switch, value, directory, subdirectory).
+  {
+    {"NEO_CACHE_PERSISTENT",      "1",     "NEO_CACHE_DIR",         "neo"},                         // Intel compute runtime.
+    {"AMD_COMGR_CACHE",           "1",     "AMD_COMGR_CACHE_DIR",   "comgr"}                        // AMD ROCm.
+  };
+  std::filesystem::path    home = cache_home;                                                       // Cache home directory.
+  std::filesystem::path    binary = executable_home ();                                             // Executable directory.
+  std::string              directory;                                                               // Runtime cache directory.
+  std::error_code          error;                                                                   // Directory creation error.
+
+  if(home.is_relative () && !binary.empty ())
+  {
+    home = binary/home;                                                                             // Resolving against the executable directory...
+  }
+
+  home = std::filesystem::absolute (home, error);                                                   // Setting cache home directory (absolute)...
+
+  for(auto& r : runtime)
+  {
+    directory = (home/r[3]).string ();                                                              // Setting runtime cache directory...
+    std::filesystem::create_directories (directory, error);                                         // Creating runtime cache directory...
+
+#ifdef WIN32
+    if(getenv (r[0]) == NULL) _putenv_s (r[0], r[1]);                                               // Enabling runtime cache...
+    if(getenv (r[2]) == NULL) _putenv_s (r[2], directory.c_str ());                                 // Setting runtime cache directory...
+#else
+    setenv (r[0], r[1], 0);                                                                         // Enabling runtime cache...
+    setenv (r[2], directory.c_str (), 0);                                                           // Setting runtime cache directory...
+#endif
+  }
+
+  std::cout << "OpenCL vendor program caches: " << home.string () << std::endl;                     // Printing message...
+}
@@ -0,0 +1,20 @@
+/// @file
+
+// OpenCL vendor program caches: enabling the runtime caches which are off by default.
+#ifndef vendor_cache_hpp
+#define vendor_cache_hpp
+
+#include <string>                                                                                   // Cache home directory.
+
+// Enabling the persistent program binary cache of the OpenCL runtimes which do not cache by default
+// (Intel compute runtime, AMD ROCm), before the OpenCL context is created: later runs reload the
+// compiled programs instead of building them from source. pocl, NVIDIA and Mesa already cache in their
+// own directories and are left untouched, as are variables already set. A relative "cache_home" is
+// resolved against the directory of the executable, not the working directory. Only the vendors' own
+// caches are enabled: the programs are built by Neutrino inside "kernel::init", hence no program binary
+// cache of ours (clGetProgramInfo/clCreateProgramWithBinary) is implemented.
+void vendor_cache (
+                   std::string cache_home                                                           // Cache home directory.
+                  );
+
+#endif
@@ -0,0 +1,31 @@
+/// @file
+
+// Adaptive time step, 3rd kernel: copies the time step set by dt_control.cl to all nodes.
+__kernel void thekernel(__global float4*    position,                                               // Position [m].
+                        __global float4*    color,                                                  // Color [#]
+                        __global float4*    position_int,                                           // Position (intermediate) [m].
+                        __global float4*    velocity,                                               // Velocity [m/s].
+                        __global float4*    velocity_int,                                           // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                                           // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                                       // Acceleration (intermediate) [m/s^2].
+                        __global float*     stiffness,                                              // Stiffness
+                        __global float4*    resting,                                                // Resting distance [m].
+                        __global float*     friction,                                               // Friction
+                        __global float*     mass,                                                   // Mass [kg].
+                        __global int8*      neighbour,                                              // Neighbour indexes (R, U, F, L, D, B) [#].
+                        __global float*     freedom,                                                // Freedom flag [#].
+                        __global float*     radius,                                                 // Particle radius [m].
+                        __global float*     time,                                                   // Simulation time step [s].
+                        __global float4*    dt_partial,                                             // Partial maxima (speed, acceleration, strain rate).
+                        __global float*     dt_limits)                                              // Time step limits (see "DT_*" in utilities.cl).
+{
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        ///////////////////////////////////////// GLOBAL INDEX ///////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        unsigned long gid = get_global_id(0);                                                       // Global index [#].
+
+        if(gid > 0)
+        {
+                time[gid] = time[0];                                                                // Setting time step [s]...
+        }
+}
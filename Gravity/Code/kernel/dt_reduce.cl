@@ -0,0 +1,86 @@
+/// @file
+
+// Adaptive time step, 1st kernel: partial maxima of speed, acceleration and link strain rate
+// over the free nodes, one per work-item (strided loop), reduced by dt_control.cl.
+__kernel void thekernel(__global float4*    position,                                               // Position [m].
+                        __global float4*    color,                                                  // Color [#]
+                        __global float4*    position_int,                                           // Position (intermediate) [m].
+                        __global float4*    velocity,                                               // Velocity [m/s].
+                        __global float4*    velocity_int,                                           // Velocity (intermediate) [m/s].
+                        __global float4*    acceleration,                                           // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                                       // Acceleration (intermediate) [m/s^2].
+                        PARAMETER float*    stiffness,                                              // Stiffness
+                        PARAMETER float4*   resting,                                                // Resting distance [m].
+                        PARAMETER float*    friction,                                               // Friction
+                        PARAMETER float*    mass,                                                   // Mass [kg].
+                        __global int8*      neighbour,                                              // Neighbour indexes (R, U, F, L, D, B) [#].
+                        __global float*     freedom,                                                // Freedom flag [#].
+                        PARAMETER float*    radius,                                                 // Particle radius [m].
+                        PARAMETER float*    time,                                                   // Simulation time step [s].
+                        __global float4*    dt_partial,                                             // Partial maxima (speed, acceleration, strain rate).
+                        __global float*     dt_limits)                                              // Time step limits (see "DT_*" in utilities.cl).
+{
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        ///////////////////////////////////////// GLOBAL INDEX ///////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        unsigned long gid = get_global_id(0);                                                       // Global index [#].
+        unsigned long stride = get_global_size(0);                                                  // Node stride [#].
+        unsigned long nodes = (unsigned long)dt_limits[DT_NODES];                                   // # of nodes [#].
+        unsigned long i;                                                                            // Node index [#].
+
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////// PARTIAL MAXIMA //////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        float4 p;                                                                                   // Position [m].
+        float4 v;                                                                                   // Velocity [m/s].
+        float4 a;                                                                                   // Acceleration [m/s^2].
+        float4 link;                                                                                // Link vector [m].
+        float4 link_v;                                                                              // Link relative velocity [m/s].
+        float l;                                                                                    // Link length [m].
+        float v_max = 0.0f;                                                                         // Maximum speed [m/s].
+        float a_max = 0.0f;                                                                         // Maximum acceleration [m/s^2].
+        float s_max = 0.0f;                                                                         // Maximum link strain rate [1/s].
+        int8        neighbours;                                                                     // Neighbour indexes (R, U, F, L, D, B) [#].
+        long n[6];                                                                                  // Neighbour indexes [#].
+        int k;                                                                                      // Neighbour index [#].
+
+        for(i = gid; i < nodes; i += stride)
+        {
+                if((freedom[i] == 0.0f) || (mass[PARAM(i)] == 0.0f))
+                {
+                        continue;                                                                   // Constrained or dummy node: skipping...
+                }
+
+                p = position[i];                                                                    // Getting position [m]...
+                v = velocity[i];                                                                    // Getting velocity [m/s]...
+                a = acceleration[i];                                                                // Getting acceleration [m/s^2]...
+                v.w = 0.0f;                                                                         // Discarding projective component...
+                a.w = 0.0f;                                                                         // Discarding projective component...
+                neighbours = neighbour[i];                                                          // Getting neighbour indexes (single load) [#]...
+                n[0] = neighbours.s0;                                                               // Getting right neighbour index [#]...
+                n[1] = neighbours.s1;                                                               // Getting up neighbour index [#]...
+                n[2] = neighbours.s2;                                                               // Getting front neighbour index [#]...
+                n[3] = neighbours.s3;                                                               // Getting left neighbour index [#]...
+                n[4] = neighbours.s4;                                                               // Getting down neighbour index [#]...
+                n[5] = neighbours.s5;                                                               // Getting back neighbour index [#]...
+
+                v_max = fmax(v_max, length(v));                                                     // Updating maximum speed [m/s]...
+                a_max = fmax(a_max, length(a));                                                     // Updating maximum acceleration [m/s^2]...
+
+                for(k = 0; k < 6; k++)
+                {
+                        link = position[n[k]] - p;                                                  // Computing link vector [m]...
+                        link_v = velocity[n[k]] - v;                                                // Computing link relative velocity [m/s]...
+                        link.w = 0.0f;                                                              // Discarding projective component...
+                        link_v.w = 0.0f;                                                            // Discarding projective component...
+                        l = length(link);                                                           // Computing link length [m]...
+
+                        if(l > 0.0f)
+                        {
+                                s_max = fmax(s_max, fabs(dot(link, link_v))/(l*l));                 // Updating maximum strain rate [1/s]...
+                        }
+                }
+        }
+
+        dt_partial[gid] = (float4)(v_max, a_max, s_max, 0.0f);                                      // Updating partial maxima...
+}
@@ -0,0 +1,74 @@
+/// @file
+
+// Device grid generation (DEVICE_INIT): one work-item per node of a 3D NDRange spanning the lattice
+// sets the initial position, color, state, parameters, neighbour indexes and freedom flag from the
+// "GRID_*" scalars, in place of the host loop and of the upload of the node arrays. The faces are fixed.
+__kernel void thekernel(__global float4*    position,                                               // Position [m].
+                        __global float4*    color,                                                  // Color [#]
+                        __global float4*    position_int,                                           // Position (intermediate) [m].
+                        __global float4*    velocity,                                               // Velocity [m/s].
+                        __global float4*    velocity_int,                                           // Velocity (intermediate) [m/s].
+                        __global HISTORY4*  acceleration,                                           // Acceleration [m/s^2].
+                        __global float4*    acceleration_int,                                       // Acceleration (intermediate) [m/s^2].
+                        __global HISTORY*   stiffness,                                              // Stiffness
+                        __global HISTORY4*  resting,                                                // Resting distance [m].
+                        __global float*     friction,                                               // Friction
+                        __global float*     mass,                                                   // Mass [kg].
+                        __global int8*      neighbour,                                              // Neighbour indexes (R, U, F, L, D, B) [#].
+                        __global float*     freedom,                                                // Freedom flag [#].
+                        __global float*     radius,                                                 // Particle radius [m].
+                        __global float*     time,                                                   // Simulation time step [s].
+                        __global float*     grid)                                                   // Grid scalars (see "GRID_*" in utilities.cl).
+{
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        ///////////////////////////////////////// GLOBAL INDEX ///////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        int i       = get_global_id(0);                                                             // "x" lattice index [#].
+        int j       = get_global_id(1);                                                             // "y" lattice index [#].
+        int k       = get_global_id(2);                                                             // "z" lattice index [#].
+        int nodes_x = get_global_size(0);                                                           // # of nodes in "x" direction [#].
+        int nodes_y = get_global_size(1);                                                           // # of nodes in "y" direction [#].
+        int nodes_z = get_global_size(2);                                                           // # of nodes in "z" direction [#].
+        int gid     = i + nodes_x*j + nodes_x*nodes_y*k;                                            // Global index [#].
+
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        /////////////////////////////////////// MESH CONNECTIVITY ////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        // NOTE: the index of a neighbour beyond a face is the index of the node (dummy link).
+        int8 n = (int8)(gid);                                                                       // Neighbour indexes [#].
+
+        n.s0 = (i < nodes_x - 1) ? gid + 1 : gid;                                                   // Setting right neighbour index [#]...
+        n.s1 = (j < nodes_y - 1) ? gid + nodes_x : gid;                                             // Setting up neighbour index [#]...
+        n.s2 = (k < nodes_z - 1) ? gid + nodes_x*nodes_y : gid;                                     // Setting front neighbour index [#]...
+        n.s3 = (i > 0) ? gid - 1 : gid;                                                             // Setting left neighbour index [#]...
+        n.s4 = (j > 0) ? gid - nodes_x : gid;                                                       // Setting down neighbour index [#]...
+        n.s5 = (k > 0) ? gid - nodes_x*nodes_y : gid;                                               // Setting back neighbour index [#]...
+
+        neighbour[gid] = n;                                                                         // Setting neighbour indexes [#]...
+        freedom[gid]   = ((n.s0 != gid) && (n.s1 != gid) && (n.s2 != gid) &&
+                          (n.s3 != gid) && (n.s4 != gid) && (n.s5 != gid)) ? 1.0f : 0.0f;           // Setting freedom flag (faces fixed) [#]...
+
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////// NODE KINEMATICS /////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        position[gid] = (float4)(grid[GRID_X_MIN] + i*grid[GRID_DX],
+                                 grid[GRID_Y_MIN] + j*grid[GRID_DY],
+                                 grid[GRID_Z_MIN] + k*grid[GRID_DZ], 1.0f);                         // Setting position [m]...
+        color[gid]    = (float4)(0.0f, 0.0f, 1.0f, 0.8f);                                           // Setting color [#]...
+        velocity[gid] = (float4)(0.0f, 0.0f, 0.0f, 1.0f);                                           // Setting velocity [m/s]...
+        store_history4(acceleration, gid, (float4)(0.0f, 0.0f, 0.0f, 1.0f));                        // Setting acceleration [m/s^2]...
+
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////// NODE PARAMETERS /////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////////////////////
+        // NOTE: with UNIFORM parameters only node 0 writes the single value.
+        if(PARAM(gid) == gid)
+        {
+                store_history(stiffness, gid, grid[GRID_K]);                                        // Setting stiffness...
+                store_history4(resting, gid, (float4)(grid[GRID_DX], grid[GRID_DY], grid[GRID_DZ], 1.0f));// Setting resting distance [m]...
+                friction[gid] = grid[GRID_C];                                                       // Setting friction...
+                mass[gid]     = grid[GRID_M];                                                       // Setting mass [kg]...
+                radius[gid]   = grid[GRID_R0];                                                      // Setting particle radius [m]...
+                time[gid]     = grid[GRID_DT];                                                      // Setting time step [s]...
+        }
+}
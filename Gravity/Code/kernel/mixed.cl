@@ -0,0 +1,7 @@
+/// @file
+
+// Prepended (before utilities.cl) to thekernel1.cl/thekernel2.cl when MIXED is enabled: acceleration,
+// resting distance and stiffness are then stored as "half" (vload_half and vstore_half, no fp16
+// extension needed) while all the arithmetic stays in "float". The intermediate velocity and
+// acceleration stay in "float": rounding them every time step dominated the position error.
+#define MIXED
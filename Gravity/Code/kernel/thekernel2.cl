@@ -5,21 +5,16 @@ __kernel void thekernel(__global float4*    position,
                         __global float4*    position_int,                                           // Position (intermediate) [m].
                         __global float4*    velocity,                                               // Velocity [m/s].
                         __global float4*    velocity_int,                                           // Velocity (intermediate) [m/s].
-                        __global float4*    acceleration,                                           // Acceleration [m/s^2].
+                        __global HISTORY4*  acceleration,                                           // Acceleration [m/s^2].
                         __global float4*    acceleration_int,                                       // Acceleration (intermediate) [m/s^2].
-                        __global float*     stiffness,                                              // Stiffness
-                        __global float4*    resting,                                                // Resting distance [m].
-                        __global float*     friction,                                               // Friction
-                        __global float*     mass,                                                   // Mass [kg].
-                        __global long*      neighbour_R,                                            // Right neighbour [#].
-                        __global long*      neighbour_U,                                            // Up neighbour [#].
-                        __global long*      neighbour_F,                                            // Front neighbour [#].
-                        __global long*      neighbour_L,                                            // Left neighbour [#].
-                        __global long*      neighbour_D,                                            // Down neighbour [#].
-                        __global long*      neighbour_B,                                            // Back neighbour [#].
+                        PARAMETER HISTORY*  stiffness,                                              // Stiffness
+                        PARAMETER HISTORY4* resting,                                                // Resting distance [m].
+                        PARAMETER float*    friction,                                               // Friction
+                        PARAMETER float*    mass,                                                   // Mass [kg].
+                        __global int8*      neighbour,                                              // Neighbour indexes (R, U, F, L, D, B) [#].
                         __global float*     freedom,                                                // Freedom flag [#].
-                        __global float*     radius,                                                 // Particle radius [m].
-                        __global float*     time)                                                   // Simulation time step [s].
+                        PARAMETER float*    radius,                                                 // Particle radius [m].
+                        PARAMETER float*    time)                                                   // Simulation time step [s].
 {
         //////////////////////////////////////////////////////////////////////////////////////////////
         ///////////////////////////////////////// GLOBAL INDEX ///////////////////////////////////////
@@ -39,32 +34,33 @@ __kernel void thekernel(__global float4*    position,
         //////////////////////////////////////////////////////////////////////////////////////////////
         ///////////////////////////// SYNERGIC MOLECULE: DYNAMIC VARIABLES ///////////////////////////
         //////////////////////////////////////////////////////////////////////////////////////////////
-        float m   = mass[gid];                                                                      // Current node mass.
+        float m   = mass[PARAM(gid)];                                                               // Current node mass.
         float fr  = freedom[gid];                                                                   // Current freedom flag.
-        float dt  = time[gid];                                                                      // Current dt.
-        float R0  = radius[gid];                                                                    // Current particle radius.
+        float dt  = time[PARAM(gid)];                                                               // Current dt.
+        float R0  = radius[PARAM(gid)];                                                             // Current particle radius.
         float4 F;                                                                                   // Current particle force [N].
 
         //////////////////////////////////////////////////////////////////////////////////////////////
         //////////////////////////////// SYNERGIC MOLECULE: LINK INDEXES /////////////////////////////
         //////////////////////////////////////////////////////////////////////////////////////////////
         // NOTE: the index of a dummy node neighbour must be set to the index of the node.
-        long i_R = neighbour_R[gid];                                                                // Setting right neighbour index [#]...
-        long i_U = neighbour_U[gid];                                                                // Setting up neighbour index [#]...
-        long i_F = neighbour_F[gid];                                                                // Setting front neighbour index [#]...
-        long i_L = neighbour_L[gid];                                                                // Setting left neighbour index [#]...
-        long i_D = neighbour_D[gid];                                                                // Setting down neighbour index [#]...
-        long i_B = neighbour_B[gid];                                                                // Setting back neighbour index [#]...
+        int8 neighbours = neighbour[gid];                                                            // Getting neighbour indexes (single load) [#]...
+        long i_R = neighbours.s0;                                                                   // Setting right neighbour index [#]...
+        long i_U = neighbours.s1;                                                                   // Setting up neighbour index [#]...
+        long i_F = neighbours.s2;                                                                   // Setting front neighbour index [#]...
+        long i_L = neighbours.s3;                                                                   // Setting left neighbour index [#]...
+        long i_D = neighbours.s4;                                                                   // Setting down neighbour index [#]...
+        long i_B = neighbours.s5;                                                                   // Setting back neighbour index [#]...
 
         //////////////////////////////////////////////////////////////////////////////////////////////
         ////////////////////////////// SYNERGIC MOLECULE: NEIGHBOUR MASSES ///////////////////////////
         //////////////////////////////////////////////////////////////////////////////////////////////
-        float m_R = mass[i_R];                                                                      // Setting right neighbour mass [kg]...
-        float m_U = mass[i_U];                                                                      // Setting up neighbour mass [kg]...
-        float m_F = mass[i_F];                                                                      // Setting front neighbour mass [kg]...
-        float m_L = mass[i_L];                                                                      // Setting left neighbour mass [kg]...
-        float m_D = mass[i_D];                                                                      // Setting down neighbour mass [kg]...
-        float m_B = mass[i_B];                                                                      // Setting back neighbour mass [kg]...
+        float m_R = mass[PARAM(i_R)];                                                               // Setting right neighbour mass [kg]...
+        float m_U = mass[PARAM(i_U)];                                                               // Setting up neighbour mass [kg]...
+        float m_F = mass[PARAM(i_F)];                                                               // Setting front neighbour mass [kg]...
+        float m_L = mass[PARAM(i_L)];                                                               // Setting left neighbour mass [kg]...
+        float m_D = mass[PARAM(i_D)];                                                               // Setting down neighbour mass [kg]...
+        float m_B = mass[PARAM(i_B)];                                                               // Setting back neighbour mass [kg]...
 
         //////////////////////////////////////////////////////////////////////////////////////////////
         ///////////////////////////// SYNERGIC MOLECULE: NEIGHBOUR POSITIONS /////////////////////////
@@ -79,12 +75,12 @@ __kernel void thekernel(__global float4*    position,
         //////////////////////////////////////////////////////////////////////////////////////////////
         ///////////////////////// SYNERGIC MOLECULE: NEIGHBOUR RESTING DISTANCES /////////////////////
         //////////////////////////////////////////////////////////////////////////////////////////////
-        float r_R_mag = resting[i_R].x;                                                             // Setting right neighbour position coordinates [m]...
-        float r_U_mag = resting[i_U].y;                                                             // Setting up neighbour position coordinates [m]...
-        float r_F_mag = resting[i_F].z;                                                             // Setting front neighbour position coordinates [m]...
-        float r_L_mag = resting[i_L].x;                                                             // Setting left neighbour position coordinates [m]...
-        float r_D_mag = resting[i_D].y;                                                             // Setting down neighbour position coordinates [m]...
-        float r_B_mag = resting[i_B].z;                                                             // Setting back neighbour position coordinates [m]...
+        float r_R_mag = load_history4(resting, PARAM(i_R)).x;                                       // Setting right neighbour position coordinates [m]...
+        float r_U_mag = load_history4(resting, PARAM(i_U)).y;                                       // Setting up neighbour position coordinates [m]...
+        float r_F_mag = load_history4(resting, PARAM(i_F)).z;                                       // Setting front neighbour position coordinates [m]...
+        float r_L_mag = load_history4(resting, PARAM(i_L)).x;                                       // Setting left neighbour position coordinates [m]...
+        float r_D_mag = load_history4(resting, PARAM(i_D)).y;                                       // Setting down neighbour position coordinates [m]...
+        float r_B_mag = load_history4(resting, PARAM(i_B)).z;                                       // Setting back neighbour position coordinates [m]...
 
         //////////////////////////////////////////////////////////////////////////////////////////////
         ////////////////////////////////// SYNERGIC MOLECULE: LINK VECTORS ///////////////////////////
@@ -178,13 +174,13 @@ __kernel void thekernel(__global float4*    position,
         /////////////////////////////// SYNERGIC MOLECULE: LINK STIFFNESS ////////////////////////////
         //////////////////////////////////////////////////////////////////////////////////////////////
         // NOTE: the stiffness of a dummy zero-length link must be 0.
-        float K = stiffness[gid];                                                                   // Setting link stiffness...
+        float K = load_history(stiffness, PARAM(gid));                                              // Setting link stiffness...
 
         //////////////////////////////////////////////////////////////////////////////////////////////
         /////////////////////////////// SYNERGIC MOLECULE: LINK FRICTION /////////////////////////////
         //////////////////////////////////////////////////////////////////////////////////////////////
         // NOTE: the friction of a dummy zero-length link must be 0.
-        float B = friction[gid];                                                                    // Setting particle friction...
+        float B = friction[PARAM(gid)];                                                             // Setting particle friction...
 
         //////////////////////////////////////////////////////////////////////////////////////////////
         ///////////////////////////////// SYNERGIC MOLECULE: ELASTIC FORCE ///////////////////////////
@@ -257,6 +253,6 @@ __kernel void thekernel(__global float4*    position,
         // UPDATING KINEMATICS:
         position[gid] = p;                                                                          // Updating position [m]...
         velocity[gid] = v;                                                                          // Updating velocity [m/s]...
-        acceleration[gid] = a;                                                                      // Updating acceleration [m/s^2]...
+        store_history4(acceleration, gid, a);                                                       // Updating acceleration [m/s^2]...
         color[gid] = c;                                                                             // Updating color [#]...
 }
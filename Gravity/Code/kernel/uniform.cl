@@ -0,0 +1,6 @@
+/// @file
+
+// Prepended (before utilities.cl) to the kernels reading the node parameters when UNIFORM is
+// enabled: stiffness, resting distance, friction, mass, radius and time step are then a single value
+// in constant memory, shared by all nodes.
+#define UNIFORM
@@ -5,6 +5,54 @@
 
 #define ONE4 (float4)(1.0f, 1.0f, 1.0f, 1.0f)                                                       // Vector of 4 ones.
 
+// Node parameters (stiffness, resting distance, friction, mass, radius, time step):
+#ifdef UNIFORM
+  #define PARAMETER __constant                                                                      // Single value for all nodes (see uniform.cl).
+  #define PARAM(n)  0                                                                               // Parameter index of node "n" [#].
+#else
+  #define PARAMETER __global                                                                        // One value per node.
+  #define PARAM(n)  (n)                                                                             // Parameter index of node "n" [#].
+#endif
+
+// History quantities (acceleration, intermediate velocity and acceleration, resting distance, stiffness):
+#ifdef MIXED
+  #define HISTORY   half                                                                            // "half" storage, "float" arithmetic (see mixed.cl).
+  #define HISTORY4  half                                                                            // "half" storage of "float4" vectors (see mixed.cl).
+  #define load_history(a, i)      vload_half((i), (a))                                              // Loading element "i".
+  #define load_history4(a, i)     vload_half4((i), (a))                                             // Loading vector "i".
+  #define store_history(a, i, v)  vstore_half((v), (i), (a))                                        // Storing element "i" (rounded to nearest).
+  #define store_history4(a, i, v) vstore_half4((v), (i), (a))                                       // Storing vector "i" (rounded to nearest).
+#else
+  #define HISTORY   float                                                                           // "float" storage.
+  #define HISTORY4  float4                                                                          // "float4" storage.
+  #define load_history(a, i)      (a)[i]                                                            // Loading element "i".
+  #define load_history4(a, i)     (a)[i]                                                            // Loading vector "i".
+  #define store_history(a, i, v)  (a)[i] = (v)                                                      // Storing element "i".
+  #define store_history4(a, i, v) (a)[i] = (v)                                                      // Storing vector "i".
+#endif
+
+// Adaptive time step limits (set by host):
+#define DT_MIN    0                                                                                 // Minimum time step [s].
+#define DT_MAX    1                                                                                 // Maximum time step (stability bound) [s].
+#define DT_LENGTH 2                                                                                 // Mesh size [m].
+#define DT_CFL    3                                                                                 // Maximum node travel and link strain per time step.
+#define DT_GROWTH 4                                                                                 // Maximum time step growth per time step.
+#define DT_GROUPS 5                                                                                 // # of partial maxima.
+#define DT_NODES  6                                                                                 // # of nodes.
+
+// Device grid generation (set by host, see grid_init.cl):
+#define GRID_X_MIN 0                                                                                // "x_min" spatial boundary [m].
+#define GRID_Y_MIN 1                                                                                // "y_min" spatial boundary [m].
+#define GRID_Z_MIN 2                                                                                // "z_min" spatial boundary [m].
+#define GRID_DX    3                                                                                // x-axis mesh spatial size [m].
+#define GRID_DY    4                                                                                // y-axis mesh spatial size [m].
+#define GRID_DZ    5                                                                                // z-axis mesh spatial size [m].
+#define GRID_K     6                                                                                // Space elastic constant [kg/s^2].
+#define GRID_C     7                                                                                // Space damping [kg*s*m].
+#define GRID_M     8                                                                                // Space mass [kg].
+#define GRID_R0    9                                                                                // Particle radius [m].
+#define GRID_DT    10                                                                               // Simulation time step [s].
+
 // Determinant of 3x3 matrix.
 float det(float4 row_1, float4 row_2, float4 row_3)
 {
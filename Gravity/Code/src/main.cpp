@@ -28,9 +28,118 @@
 // OPENCL:
 #define QUEUE_NUM   1                                                                               // # of OpenCL queues [#].
 #define KERNEL_NUM  2                                                                               // # of OpenCL kernel [#].
+#define VENDOR_CACHE true                                                                           // "true" = persistent program binary cache of the vendor OpenCL runtimes ("CACHE_HOME").
+#define CACHE_HOME   "vendor_cache"                                                                 // Vendor OpenCL program cache directory (relative to the executable).
+
+// ADAPTIVE TIME STEP:
+#define ADAPTIVE    false                                                                           // "true" = time step driven by an on-device CFL reduction.
+#define DT_CFL      0.05f                                                                           // Max node travel (in mesh sizes) and link strain change per time step.
+#define DT_GROWTH   1.02f                                                                           // Max time step growth per time step [#].
+#define DT_MIN      0.01f                                                                           // Min time step, in units of the critical time step [#].
+#define DT_MAX      0.5f                                                                            // Max time step, in units of the critical time step [#] (stability limit ~0.65).
+#define DT_GROUPS   1024                                                                            // # of time step partial maxima (reduction work-items) [#].
+
+#if ADAPTIVE
+  #define DT_KERNELS 3                                                                              // # of adaptive time step OpenCL kernels [#].
+#else
+  #define DT_KERNELS 0                                                                              // # of adaptive time step OpenCL kernels [#].
+#endif
+
+// UNIFORM NODE PARAMETERS:
+#define UNIFORM     false                                                                           // "true" = stiffness, resting, friction, mass, radius and time step stored once.
+
+#if UNIFORM
+  #define PARAM(n)  0                                                                               // Node parameter index (single value for all nodes) [#].
+#else
+  #define PARAM(n)  (n)                                                                             // Node parameter index (one value per node) [#].
+#endif
+
+// MIXED PRECISION:
+#define MIXED       false                                                                           // "true" = acceleration, resting and stiffness stored as "half".
+#define CHECK_STEPS 0                                                                               // # of time steps before saving (float) or comparing (MIXED) positions [#] (0 = no check).
+#define CHECK_FILE  "positions_float.txt"                                                           // Full float positions (reference of the MIXED build).
+
+#if MIXED && ADAPTIVE
+  #error "Mixed precision storage is implemented by the integrator kernels only: set ADAPTIVE to false."
+#endif
+
+#if MIXED
+  #define HISTORY_SIZE 2                                                                            // # of float buffer elements per "half4" node vector [#].
+#else
+  #define HISTORY_SIZE 1                                                                            // # of float4 buffer elements per node vector [#].
+#endif
+
+// DEVICE GRID GENERATION:
+#define DEVICE_INIT false                                                                           // "true" = lattice generated on the device by grid_init.cl (no host loop, no upload).
+
+#if DEVICE_INIT
+  #define INIT_KERNELS 1                                                                            // # of grid generation OpenCL kernels [#].
+#else
+  #define INIT_KERNELS 0                                                                            // # of grid generation OpenCL kernels [#].
+#endif
 
 // INCLUDES:
 #include "nu.hpp"                                                                                   // Neutrino's header file.
+#include "vendor_cache.hpp"                                                                         // OpenCL vendor program caches.
+#include "int32_buffer.hpp"                                                                         // 32-bit integer buffers.
+#include <algorithm>                                                                                // Reduction work-items.
+#include <cstring>                                                                                  // Packing "half" values.
+#include <fstream>                                                                                  // Position files for accuracy checks.
+
+// Converting a float to the nearest "half" (IEEE 754 binary16, ties to even), returned as bits:
+cl_half float_to_half (
+                       float value                                                                  // Value.
+                      )
+{
+  cl_uint                  bits;                                                                    // Float bits.
+  cl_uint                  sign;                                                                    // Half sign bit.
+  cl_int                   exponent;                                                                // Half biased exponent.
+  cl_uint                  mantissa;                                                                // Float mantissa.
+  cl_uint                  shift;                                                                   // Mantissa shift [#].
+  cl_uint                  half;                                                                    // Half exponent and mantissa bits.
+  cl_uint                  rest;                                                                    // Shifted out mantissa bits.
+
+  std::memcpy (&bits, &value, sizeof (bits));                                                       // Getting float bits...
+  sign     = (bits >> 16) & 0x8000;                                                                 // Getting sign bit...
+  exponent = (cl_int)((bits >> 23) & 0xFF) - 127 + 15;                                              // Rebiasing exponent...
+  mantissa = bits & 0x7FFFFF;                                                                       // Getting mantissa...
+
+  if(((bits >> 23) & 0xFF) == 0xFF)
+  {
+    return (cl_half)(sign | 0x7C00 | (mantissa ? 0x200 : 0));                                       // Infinity or NaN...
+  }
+
+  if(exponent >= 31)
+  {
+    return (cl_half)(sign | 0x7C00);                                                                // Overflow: infinity...
+  }
+
+  if(exponent <= 0)
+  {
+    if(exponent < -10)
+    {
+      return (cl_half)sign;                                                                         // Underflow: zero...
+    }
+
+    mantissa |= 0x800000;                                                                           // Adding implicit bit...
+    shift     = 14 - exponent;                                                                      // Setting subnormal shift...
+  }
+  else
+  {
+    mantissa |= (cl_uint)exponent << 23;                                                            // Adding exponent (carried by rounding)...
+    shift     = 13;                                                                                 // Setting normal shift...
+  }
+
+  half = mantissa >> shift;                                                                         // Truncating mantissa...
+  rest = mantissa & ((1u << shift) - 1);                                                            // Getting shifted out bits...
+
+  if((rest > (1u << (shift - 1))) || ((rest == (1u << (shift - 1))) && (half & 1)))
+  {
+    half++;                                                                                         // Rounding to nearest even...
+  }
+
+  return (cl_half)(sign | half);                                                                    // Returning half bits...
+}
 
 int main ()
 {
@@ -38,6 +147,14 @@ int main ()
   std::string              kernel_home;                                                             // Kernel home directory.
   std::vector<std::string> kernel_1;                                                                // Kernel_1 source files.
   std::vector<std::string> kernel_2;                                                                // Kernel_2 source files.
+#if DEVICE_INIT
+  std::vector<std::string> kernel_init;                                                             // Grid generation kernel source files.
+#endif
+#if ADAPTIVE
+  std::vector<std::string> kernel_dt_reduce;                                                        // Adaptive time step reduction kernel source files.
+  std::vector<std::string> kernel_dt_control;                                                       // Adaptive time step control kernel source files.
+  std::vector<std::string> kernel_dt_broadcast;                                                     // Adaptive time step broadcast kernel source files.
+#endif
 
   // DATA:
   float                    x_min              = -1.0f;                                              // "x_min" spatial boundary [m].
@@ -50,13 +167,15 @@ int main ()
   size_t                   nodes_y            = 25;                                                 // Number of nodes in "Y" direction [].
   size_t                   nodes_z            = 25;                                                 // Number of nodes in "Y" direction [].
   size_t                   nodes              = nodes_x * nodes_y * nodes_z;                        // Total # of nodes [#].
+  size_t                   parameters         = UNIFORM ? 1 : nodes;                                // # of values per node parameter [#].
   float                    dx                 = (x_max - x_min) / (nodes_x - 1);                    // x-axis mesh spatial size [m].
   float                    dy                 = (y_max - y_min) / (nodes_y - 1);                    // y-axis mesh spatial size [m].
   float                    dz                 = (z_max - z_min) / (nodes_z - 1);                    // z-axis mesh spatial size [m].
+  size_t                   gid;                                                                     // Global index [].
+#if !DEVICE_INIT
   size_t                   i;                                                                       // "x" direction index [].
   size_t                   j;                                                                       // "y" direction index [].
   size_t                   k;                                                                       // "z" direction index [].
-  size_t                   gid;                                                                     // Global index [].
   size_t                   face_R             = nodes_x - 1;                                        // Right face index [].
   size_t                   face_U             = nodes_y - 1;                                        // Up face index [].
   size_t                   face_F             = nodes_z - 1;                                        // Front face index [].
@@ -69,6 +188,8 @@ int main ()
   size_t                   neighbour_L;                                                             // Left neighbour index [].
   size_t                   neighbour_D;                                                             // Down neighbour index [].
   size_t                   neighbour_B;                                                             // Back neighbour index [].
+  cl_int8                  neighbours;                                                              // Current node neighbour indexes (R, U, F, L, D, B) [#].
+#endif
 
   // GUI PARAMETERS (orbit):
   float                    orbit_x_init       = 0.0f;                                               // x-axis orbit initial rotation.
@@ -98,6 +219,15 @@ int main ()
   queue*                   Q                  = new queue ();                                       // OpenCL queue.
   kernel*                  K1                 = new kernel ();                                      // OpenCL kernel array.
   kernel*                  K2                 = new kernel ();                                      // OpenCL kernel array.
+#if DEVICE_INIT
+  kernel*                  K_init             = new kernel ();                                      // OpenCL kernel (grid generation).
+#endif
+#if ADAPTIVE
+  kernel*                  K_dt_reduce        = new kernel ();                                      // OpenCL kernel (time step partial maxima).
+  kernel*                  K_dt_control       = new kernel ();                                      // OpenCL kernel (next time step).
+  kernel*                  K_dt_broadcast     = new kernel ();                                      // OpenCL kernel (time step broadcast).
+  size_t                   dt_groups          = std::min<size_t> (DT_GROUPS, nodes);                // Time step reduction work-items [#].
+#endif
   size_t                   kernel_sx          = nodes;                                              // Kernel dimension "x" [#].
   size_t                   kernel_sy          = 0;                                                  // Kernel dimension "y" [#].
   size_t                   kernel_sz          = 0;                                                  // Kernel dimension "z" [#].
@@ -105,7 +235,11 @@ int main ()
   // NODE KINEMATICS:
   float4G*                 position           = new float4G ();                                     // Position [m].
   float4*                  velocity           = new float4 ();                                      // Velocity [m/s].
+#if MIXED
+  float1*                  acceleration       = new float1 ();                                      // Acceleration, "half4" [m/s^2].
+#else
   float4*                  acceleration       = new float4 ();                                      // Acceleration [m/s^2].
+#endif
 
   // NODE KINEMATICS (INTERMEDIATE):
   float4*                  position_int       = new float4 ();                                      // Position (intermediate) [m].
@@ -128,61 +262,113 @@ int main ()
   float                    K                  = E * dz * dx / dy;                                   // Space elastic constant [kg/s^2].
   float                    C                  = mu * dx * dy * dz;                                  // Space damping [kg*s*m].
   float1*                  friction           = new float1 ();                                      // Friction.
+#if MIXED
+  float1*                  resting            = new float1 ();                                      // Resting distance, "half4" [m].
+  float1*                  stiffness          = new float1 ();                                      // Stiffness, 2 "half" per element.
+#if !DEVICE_INIT
+  cl_half                  history[4];                                                              // "half4" history vector.
+  cl_half                  stiffness_half;                                                          // "half" stiffness.
+#endif
+#else
   float4*                  resting            = new float4 ();                                      // Resting distance [m].
   float1*                  stiffness          = new float1 ();                                      // Stiffness.
+#endif
 
   // SIMULATION PARAMETERS:
   float                    dt_critical        = sqrt (m / K);                                       // Critical time step [s].
   float                    dt_simulation      = 0.1f * dt_critical;                                 // Simulation time step [s].
   float1*                  time               = new float1 ();                                      // Time [s].
+#if DEVICE_INIT
+  float1*                  grid               = new float1 ();                                      // Grid generation scalars (see "GRID_*" in utilities.cl).
+#endif
+#if ADAPTIVE
+  float4*                  dt_partial         = new float4 ();                                      // Time step partial maxima (speed, acceleration, strain rate).
+  float1*                  dt_limits          = new float1 ();                                      // Time step limits (see "DT_*" in utilities.cl).
+#endif
 
   // MESH CONNECTIVITY:
-  int1*                    index_R            = new int1 ();                                        // Right neighbour index [].
-  int1*                    index_U            = new int1 ();                                        // Up neighbour index [].
-  int1*                    index_F            = new int1 ();                                        // Front neighbour index [].
-  int1*                    index_L            = new int1 ();                                        // Left neighbour index [].
-  int1*                    index_D            = new int1 ();                                        // Down neighbour index [].
-  int1*                    index_B            = new int1 ();                                        // Back neighbour index [].
+  int32_buffer<float4>*    neighbour          = new int32_buffer<float4> ();                        // Neighbour indexes (R, U, F, L, D, B), 8 per node [#].
   float1*                  freedom            = new float1 ();                                      // Freedom/constrain flag [].
 
+  // ACCURACY CHECK:
+  int                      time_step_index    = 0;                                                  // Time step index [#].
+#if CHECK_STEPS > 0
+  float                    x_ref;                                                                   // Reference "x" position [m].
+  float                    y_ref;                                                                   // Reference "y" position [m].
+  float                    z_ref;                                                                   // Reference "z" position [m].
+  float                    error;                                                                   // Position error [m].
+  float                    error_max;                                                               // Maximum position error [m].
+  double                   error_rms;                                                               // RMS position error [m].
+#endif
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   ///////////////////////////////////////// DATA INITIALIZATION //////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   // NODE KINEMATICS:
   position->init (nodes);                                                                           // Initializing position data...
   velocity->init (nodes);                                                                           // Initializing velocity data...
-  acceleration->init (nodes);                                                                       // Initializing acceleration data...
+  acceleration->init (HISTORY_SIZE*nodes);                                                          // Initializing acceleration data...
 
   // NODE KINEMATICS (INTERMEDIATE):
   position_int->init (nodes);                                                                       // Initializing intermediate position data...
-  velocity_int->init (nodes);                                                                       // Initializing intermediate position data...
-  acceleration_int->init (nodes);                                                                   // Initializing intermediate position data...
+  velocity_int->init (nodes);                                                                       // Initializing intermediate velocity data...
+  acceleration_int->init (nodes);                                                                   // Initializing intermediate acceleration data...
 
   // NODE PROPERTIES:
   color->init (nodes);                                                                              // Initializing color data...
-  mass->init (nodes);                                                                               // Initializing mass data...
-  radius->init (nodes);                                                                             // Initializing radius data...
+  mass->init (parameters);                                                                          // Initializing mass data...
+  radius->init (parameters);                                                                        // Initializing radius data...
 
   // LINK PROPERTIES:
-  stiffness->init (nodes);                                                                          // Initializing stiffness data...
-  resting->init (nodes);                                                                            // Initializing resiting position data...
-  friction->init (nodes);                                                                           // Initializing friction data...
+#if MIXED
+  stiffness->init ((parameters + 1)/2);                                                             // Initializing stiffness data ("half")...
+#else
+  stiffness->init (parameters);                                                                     // Initializing stiffness data...
+#endif
+  resting->init (HISTORY_SIZE*parameters);                                                          // Initializing resiting position data...
+  friction->init (parameters);                                                                      // Initializing friction data...
 
   // MESH CONNECTIVITY:
-  index_R->init (nodes);                                                                            // Initializing right neighbour index...
-  index_U->init (nodes);                                                                            // Initializing up neighbour index...
-  index_F->init (nodes);                                                                            // Initializing front neighbour index...
-  index_L->init (nodes);                                                                            // Initializing left neighbour index...
-  index_D->init (nodes);                                                                            // Initializing down neighbour index...
-  index_B->init (nodes);                                                                            // Initializing back neighbour index...
+  neighbour->init (2*nodes);                                                                        // Initializing packed neighbour indexes...
   freedom->init (nodes);                                                                            // Initializing freedom flag data...
 
   // TIME:
-  time->init (nodes);                                                                               // Initializing time...
+  time->init (parameters);                                                                          // Initializing time...
+
+#if DEVICE_INIT
+  grid->init (11);                                                                                  // Initializing grid generation scalars...
+  grid->data[0]  = x_min;                                                                           // Setting "x_min" spatial boundary ("GRID_X_MIN") [m]...
+  grid->data[1]  = y_min;                                                                           // Setting "y_min" spatial boundary ("GRID_Y_MIN") [m]...
+  grid->data[2]  = z_min;                                                                           // Setting "z_min" spatial boundary ("GRID_Z_MIN") [m]...
+  grid->data[3]  = dx;                                                                              // Setting x-axis mesh spatial size ("GRID_DX") [m]...
+  grid->data[4]  = dy;                                                                              // Setting y-axis mesh spatial size ("GRID_DY") [m]...
+  grid->data[5]  = dz;                                                                              // Setting z-axis mesh spatial size ("GRID_DZ") [m]...
+  grid->data[6]  = K;                                                                               // Setting elastic constant ("GRID_K") [kg/s^2]...
+  grid->data[7]  = C;                                                                               // Setting damping ("GRID_C") [kg*s*m]...
+  grid->data[8]  = m;                                                                               // Setting mass ("GRID_M") [kg]...
+  grid->data[9]  = R0;                                                                              // Setting particle radius ("GRID_R0") [m]...
+  grid->data[10] = dt_simulation;                                                                   // Setting time step ("GRID_DT") [s]...
+#endif
+
+#if ADAPTIVE
+  dt_partial->init (dt_groups);                                                                     // Initializing time step partial maxima...
+  dt_limits->init (7);                                                                              // Initializing time step limits...
+  dt_limits->data[0] = DT_MIN * dt_critical;                                                        // Setting minimum time step ("DT_MIN") [s]...
+  dt_limits->data[1] = DT_MAX * dt_critical;                                                        // Setting maximum time step ("DT_MAX") [s]...
+  dt_limits->data[2] = std::min ({dx, dy, dz});                                                     // Setting mesh size ("DT_LENGTH") [m]...
+  dt_limits->data[3] = DT_CFL;                                                                      // Setting maximum travel and strain per step ("DT_CFL")...
+  dt_limits->data[4] = DT_GROWTH;                                                                   // Setting maximum time step growth ("DT_GROWTH")...
+  dt_limits->data[5] = dt_groups;                                                                   // Setting # of partial maxima ("DT_GROUPS")...
+  dt_limits->data[6] = nodes;                                                                       // Setting # of nodes ("DT_NODES")...
+#endif
 
   std::cout << "Critical time step = " << dt_critical << "[s]" << std::endl;
   std::cout << "Simulation time step = " << dt_simulation << "[s]" << std::endl;
+#if ADAPTIVE
+  std::cout << "Adaptive time step range = " << DT_MIN * dt_critical << ", " << DT_MAX * dt_critical << "[s]" << std::endl;
+#endif
 
+#if !DEVICE_INIT
   for(k = 0; k < nodes_z; k++)
   {
     for(j = 0; j < nodes_y; j++)
@@ -199,50 +385,73 @@ int main ()
         neighbour_D               = (i + 0) + nodes_x * (j - 1) + nodes_x * nodes_y * (k + 0);      // Computing down neighbour index...
         neighbour_B               = (i + 0) + nodes_x * (j + 0) + nodes_x * nodes_y * (k - 1);      // Computing front neighbour index...
 
-        freedom->data[gid]        = 1.0f;                                                           // Setting freedom flag...
+        freedom->data[gid]          = 1.0f;                                                         // Setting freedom flag...
 
         // Setting initial position:
-        position->data[gid].x     = x_min + i * dx;                                                 // Setting "x" position...
-        position->data[gid].y     = y_min + j * dy;                                                 // Setting "y" position...
-        position->data[gid].z     = z_min + k * dz;                                                 // Setting "z" position...
-        position->data[gid].w     = 1.0f;                                                           // Setting "w" position...
+        position->data[gid].x       = x_min + i * dx;                                               // Setting "x" position...
+        position->data[gid].y       = y_min + j * dy;                                               // Setting "y" position...
+        position->data[gid].z       = z_min + k * dz;                                               // Setting "z" position...
+        position->data[gid].w       = 1.0f;                                                         // Setting "w" position...
 
         // Setting initial velocity:
-        velocity->data[gid].x     = 0.0f;                                                           // Setting "x" velocity...
-        velocity->data[gid].y     = 0.0f;                                                           // Setting "y" velocity...
-        velocity->data[gid].z     = 0.0f;                                                           // Setting "z" velocity...
-        velocity->data[gid].w     = 1.0f;                                                           // Setting "w" velocity...
+        velocity->data[gid].x       = 0.0f;                                                         // Setting "x" velocity...
+        velocity->data[gid].y       = 0.0f;                                                         // Setting "y" velocity...
+        velocity->data[gid].z       = 0.0f;                                                         // Setting "z" velocity...
+        velocity->data[gid].w       = 1.0f;                                                         // Setting "w" velocity...
 
         // Setting initial acceleration:
-        acceleration->data[gid].x = 0.0f;                                                           // Setting "x" acceleration...
-        acceleration->data[gid].y = 0.0f;                                                           // Setting "y" acceleration...
-        acceleration->data[gid].z = 0.0f;                                                           // Setting "z" acceleration...
-        acceleration->data[gid].w = 1.0f;                                                           // Setting "w" acceleration...
+#if MIXED
+        history[0]                  = float_to_half (0.0f);                                         // Setting "x" acceleration...
+        history[1]                  = float_to_half (0.0f);                                         // Setting "y" acceleration...
+        history[2]                  = float_to_half (0.0f);                                         // Setting "z" acceleration...
+        history[3]                  = float_to_half (1.0f);                                         // Setting "w" acceleration...
+        std::memcpy (&acceleration->data[HISTORY_SIZE*gid], history, sizeof (history));             // Packing acceleration...
+#else
+        acceleration->data[gid].x   = 0.0f;                                                         // Setting "x" acceleration...
+        acceleration->data[gid].y   = 0.0f;                                                         // Setting "y" acceleration...
+        acceleration->data[gid].z   = 0.0f;                                                         // Setting "z" acceleration...
+        acceleration->data[gid].w   = 1.0f;                                                         // Setting "w" acceleration...
+#endif
 
         // Setting initial node properties:
         //color->data[gid].x        = 0.005f*(rand () % 100);                                         // Setting "x" initial color...
         //color->data[gid].y        = 0.005f*(rand () % 100);                                         // Setting "y" initial color...
         //color->data[gid].z        = 0.5f + 0.005f*(rand () % 100);                                  // Setting "z" initial color...
-        color->data[gid].x        = 0.0f;
-        color->data[gid].y        = 0.0f;
-        color->data[gid].z        = 1.0f;
-        color->data[gid].w        = 0.8f;                                                           // Setting "w" initial color...
+        color->data[gid].x          = 0.0f;
+        color->data[gid].y          = 0.0f;
+        color->data[gid].z          = 1.0f;
+        color->data[gid].w          = 0.8f;                                                         // Setting "w" initial color...
 
-        mass->data[gid]           = m;                                                              // Setting mass...
-        radius->data[gid]         = R0;                                                             // Setting particle radius [m]...
+        mass->data[PARAM(gid)]      = m;                                                            // Setting mass...
+        radius->data[PARAM(gid)]    = R0;                                                           // Setting particle radius [m]...
 
         // Setting initial link properties:
-        stiffness->data[gid]      = K;                                                              // Setting stiffness...
-
-        resting->data[gid].x      = dx;                                                             // Setting "x" resting position...
-        resting->data[gid].y      = dy;                                                             // Setting "y" resting position...
-        resting->data[gid].z      = dz;                                                             // Setting "z" resting position...
-        resting->data[gid].w      = 1.0f;                                                           // Setting "w" resting position...
+#if MIXED
+        stiffness_half              = float_to_half (K);                                            // Setting stiffness...
+        std::memcpy (
+                     (cl_half*)&stiffness->data[0] + PARAM(gid),                                    // Stiffness "half" slot.
+                     &stiffness_half,                                                               // "half" stiffness.
+                     sizeof (cl_half)                                                               // "half" size [bytes].
+                    );                                                                              // Packing stiffness...
+
+        history[0]                  = float_to_half (dx);                                           // Setting "x" resting position...
+        history[1]                  = float_to_half (dy);                                           // Setting "y" resting position...
+        history[2]                  = float_to_half (dz);                                           // Setting "z" resting position...
+        history[3]                  = float_to_half (1.0f);                                         // Setting "w" resting position...
+        std::memcpy (&resting->data[HISTORY_SIZE*PARAM(gid)], history, sizeof (history));           // Packing resting position...
+#else
+        stiffness->data[PARAM(gid)] = K;                                                            // Setting stiffness...
+
+        resting->data[PARAM(gid)].x = dx;                                                           // Setting "x" resting position...
+        resting->data[PARAM(gid)].y = dy;                                                           // Setting "y" resting position...
+        resting->data[PARAM(gid)].z = dz;                                                           // Setting "z" resting position...
+        resting->data[PARAM(gid)].w = 1.0f;                                                         // Setting "w" resting position...
+#endif
 
-        friction->data[gid]       = C;                                                              // Setting friction...
+        friction->data[PARAM(gid)]  = C;                                                            // Setting friction...
 
         // Setting time:
-        time->data[gid]           = dt_simulation;                                                  // Setting time...
+        time->data[PARAM(gid)]      = dt_simulation;                                                // Setting time...
 
         // When on bulk:
         if(
@@ -254,12 +463,12 @@ int main ()
            (k != face_F)                                                                            // Not on front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         else // When on all faces:
@@ -276,12 +485,12 @@ int main ()
            (k != face_F)                                                                            // Not on front border.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = gid;                                                                 // Setting index to central node...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = gid;                                                                    // Setting index to central node...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on right face (excluding borders and corners):
@@ -293,12 +502,12 @@ int main ()
            (k != face_F)                                                                            // Not on front face.
           )
         {
-          index_R->data[gid] = gid;                                                                 // Setting index to central node...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = gid;                                                                    // Setting index to central node...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on down face (excluding borders and corners):
@@ -310,12 +519,12 @@ int main ()
            (k != face_F)                                                                            // Not on front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = gid;                                                                 // Setting index to central node...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = gid;                                                                    // Setting index to central node...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on up face (excluding borders and corners):
@@ -327,12 +536,12 @@ int main ()
            (k != face_F)                                                                            // Not on front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = gid;                                                                 // Setting index to central node...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = gid;                                                                    // Setting index to central node...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on back face (excluding borders and corners):
@@ -344,12 +553,12 @@ int main ()
            (k == face_B)                                                                            // On back face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = gid;                                                                 // Setting index to central node...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = gid;                                                                    // Setting index to central node...
         }
 
         // When on front face (excluding borders and corners):
@@ -361,12 +570,12 @@ int main ()
            (k == face_F)                                                                            // On front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = gid;                                                                 // Setting index to central node...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = gid;                                                                    // Setting index to central node...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on left-down edge (excluding corners):
@@ -377,12 +586,12 @@ int main ()
            (k != face_F)                                                                            // Not on front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = gid;                                                                 // Setting index to central node...
-          index_D->data[gid] = gid;                                                                 // Setting index to central node...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = gid;                                                                    // Setting index to central node...
+          neighbours.s[4] = gid;                                                                    // Setting index to central node...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on left-up edge (excluding corners):
@@ -393,12 +602,12 @@ int main ()
            (k != face_F)                                                                            // Not on front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = gid;                                                                 // Setting index to central node...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = gid;                                                                 // Setting index to central node...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = gid;                                                                    // Setting index to central node...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = gid;                                                                    // Setting index to central node...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on right-down edge (excluding corners):
@@ -409,12 +618,12 @@ int main ()
            (k != face_F)                                                                            // Not on front face.
           )
         {
-          index_R->data[gid] = gid;                                                                 // Setting index to central node...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = gid;                                                                 // Setting index to central node...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = gid;                                                                    // Setting index to central node...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = gid;                                                                    // Setting index to central node...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on right-up edge (excluding corners):
@@ -425,12 +634,12 @@ int main ()
            (k != face_F)                                                                            // Not on front face.
           )
         {
-          index_R->data[gid] = gid;                                                                 // Setting index to central node...
-          index_U->data[gid] = gid;                                                                 // Setting index to central node...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = gid;                                                                    // Setting index to central node...
+          neighbours.s[1] = gid;                                                                    // Setting index to central node...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on back-down edge (excluding corners):
@@ -441,12 +650,12 @@ int main ()
            (k == face_B)                                                                            // On back face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = gid;                                                                 // Setting index to central node...
-          index_B->data[gid] = gid;                                                                 // Setting index to central node...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = gid;                                                                    // Setting index to central node...
+          neighbours.s[5] = gid;                                                                    // Setting index to central node...
         }
 
         // When on back-up edge (excluding corners):
@@ -457,12 +666,12 @@ int main ()
            (k == face_B)                                                                            // On back face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = gid;                                                                 // Setting index to central node...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = gid;                                                                 // Setting index to central node...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = gid;                                                                    // Setting index to central node...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = gid;                                                                    // Setting index to central node...
         }
 
         // When on front-down edge (excluding corners):
@@ -473,12 +682,12 @@ int main ()
            (k == face_F)                                                                            // On front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = gid;                                                                 // Setting index to central node...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = gid;                                                                 // Setting index to central node...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = gid;                                                                    // Setting index to central node...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = gid;                                                                    // Setting index to central node...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on front-up edge (excluding corners):
@@ -489,12 +698,12 @@ int main ()
            (k == face_F)                                                                            // On front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = gid;                                                                 // Setting index to central node...
-          index_F->data[gid] = gid;                                                                 // Setting index to central node...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = gid;                                                                    // Setting index to central node...
+          neighbours.s[2] = gid;                                                                    // Setting index to central node...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on left-down-back corner:
@@ -504,12 +713,12 @@ int main ()
            (k == face_B)                                                                            // On back face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = gid;                                                                 // Setting index to central node...
-          index_D->data[gid] = gid;                                                                 // Setting index to central node...
-          index_B->data[gid] = gid;                                                                 // Setting index to central node...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = gid;                                                                    // Setting index to central node...
+          neighbours.s[4] = gid;                                                                    // Setting index to central node...
+          neighbours.s[5] = gid;                                                                    // Setting index to central node...
         }
 
         // When on right-down-back corner:
@@ -519,12 +728,12 @@ int main ()
            (k == face_B)                                                                            // On back face.
           )
         {
-          index_R->data[gid] = gid;                                                                 // Setting index to central node...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = gid;                                                                 // Setting index to central node...
-          index_B->data[gid] = gid;                                                                 // Setting index to central node...
+          neighbours.s[0] = gid;                                                                    // Setting index to central node...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = gid;                                                                    // Setting index to central node...
+          neighbours.s[5] = gid;                                                                    // Setting index to central node...
         }
 
         // When on left-up-back corner:
@@ -534,12 +743,12 @@ int main ()
            (k == face_B)                                                                            // On back face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = gid;                                                                 // Setting index to central node...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = gid;                                                                 // Setting index to central node...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = gid;                                                                 // Setting index to central node...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = gid;                                                                    // Setting index to central node...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = gid;                                                                    // Setting index to central node...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = gid;                                                                    // Setting index to central node...
         }
 
         // When on right-up-back corner:
@@ -549,12 +758,12 @@ int main ()
            (k == face_B)                                                                            // On back face.
           )
         {
-          index_R->data[gid] = gid;                                                                 // Setting index to central node...
-          index_U->data[gid] = gid;                                                                 // Setting index to central node...
-          index_F->data[gid] = neighbour_F;                                                         // Setting index to front neighbour...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = gid;                                                                 // Setting index to central node...
+          neighbours.s[0] = gid;                                                                    // Setting index to central node...
+          neighbours.s[1] = gid;                                                                    // Setting index to central node...
+          neighbours.s[2] = neighbour_F;                                                            // Setting index to front neighbour...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = gid;                                                                    // Setting index to central node...
         }
 
         // When on left-down-front corner:
@@ -564,12 +773,12 @@ int main ()
            (k == face_F)                                                                            // On front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = gid;                                                                 // Setting index to central node...
-          index_L->data[gid] = gid;                                                                 // Setting index to central node...
-          index_D->data[gid] = gid;                                                                 // Setting index to central node...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = gid;                                                                    // Setting index to central node...
+          neighbours.s[3] = gid;                                                                    // Setting index to central node...
+          neighbours.s[4] = gid;                                                                    // Setting index to central node...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on right-down-front corner:
@@ -579,12 +788,12 @@ int main ()
            (k == face_F)                                                                            // On front face.
           )
         {
-          index_R->data[gid] = gid;                                                                 // Setting index to central node...
-          index_U->data[gid] = neighbour_U;                                                         // Setting index to up neighbour...
-          index_F->data[gid] = gid;                                                                 // Setting index to central node...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = gid;                                                                 // Setting index to central node...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = gid;                                                                    // Setting index to central node...
+          neighbours.s[1] = neighbour_U;                                                            // Setting index to up neighbour...
+          neighbours.s[2] = gid;                                                                    // Setting index to central node...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = gid;                                                                    // Setting index to central node...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on left-up-front corner:
@@ -594,12 +803,12 @@ int main ()
            (k == face_F)                                                                            // On front face.
           )
         {
-          index_R->data[gid] = neighbour_R;                                                         // Setting index to right neighbour...
-          index_U->data[gid] = gid;                                                                 // Setting index to central node...
-          index_F->data[gid] = gid;                                                                 // Setting index to central node...
-          index_L->data[gid] = gid;                                                                 // Setting index to central node...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = neighbour_R;                                                            // Setting index to right neighbour...
+          neighbours.s[1] = gid;                                                                    // Setting index to central node...
+          neighbours.s[2] = gid;                                                                    // Setting index to central node...
+          neighbours.s[3] = gid;                                                                    // Setting index to central node...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
 
         // When on right-up-front corner:
@@ -609,21 +818,27 @@ int main ()
            (k == face_F)                                                                            // On front face.
           )
         {
-          index_R->data[gid] = gid;                                                                 // Setting index to central node...
-          index_U->data[gid] = gid;                                                                 // Setting index to central node...
-          index_F->data[gid] = gid;                                                                 // Setting index to central node...
-          index_L->data[gid] = neighbour_L;                                                         // Setting index to left neighbour...
-          index_D->data[gid] = neighbour_D;                                                         // Setting index to down neighbour...
-          index_B->data[gid] = neighbour_B;                                                         // Setting index to back neighbour...
+          neighbours.s[0] = gid;                                                                    // Setting index to central node...
+          neighbours.s[1] = gid;                                                                    // Setting index to central node...
+          neighbours.s[2] = gid;                                                                    // Setting index to central node...
+          neighbours.s[3] = neighbour_L;                                                            // Setting index to left neighbour...
+          neighbours.s[4] = neighbour_D;                                                            // Setting index to down neighbour...
+          neighbours.s[5] = neighbour_B;                                                            // Setting index to back neighbour...
         }
+
+        neighbour->set (8*gid, neighbours.s, 8);                                                    // Setting neighbour indexes...
       }
     }
   }
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////// NEUTRINO INITIALIZATION /////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
-  bas->init (QUEUE_NUM, KERNEL_NUM);                                                                // Initializing Neutrino baseline...
+#if VENDOR_CACHE
+  vendor_cache (CACHE_HOME);                                                                        // Enabling vendor OpenCL program caches...
+#endif
+  bas->init (QUEUE_NUM, KERNEL_NUM + DT_KERNELS + INIT_KERNELS);                                    // Initializing Neutrino baseline...
   gui->init (
              bas,                                                                                   // Neutrino baseline.
              GUI_SIZE_X,                                                                            // GUI x-size [px].
@@ -639,12 +854,49 @@ int main ()
   S->init (bas, SHADER_HOME, SHADER_VERT, SHADER_GEOM, SHADER_FRAG);                                // Initializing OpenGL shader...
   Q->init (bas);                                                                                    // Initializing OpenCL queue...
   kernel_home = KERNEL_HOME;                                                                        // Setting kernel home directory...
+#if UNIFORM
+  kernel_1.push_back ("uniform.cl");                                                                // Single value node parameters...
+#endif
+#if MIXED
+  kernel_1.push_back ("mixed.cl");                                                                  // Half precision history storage...
+#endif
   kernel_1.push_back ("utilities.cl");                                                              // Setting 1st source file...
   kernel_1.push_back ("thekernel1.cl");                                                             // Setting 2nd source file...
   K1->init (bas, kernel_home, kernel_1, kernel_sx, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K1...
+#if UNIFORM
+  kernel_2.push_back ("uniform.cl");                                                                // Single value node parameters...
+#endif
+#if MIXED
+  kernel_2.push_back ("mixed.cl");                                                                  // Half precision history storage...
+#endif
   kernel_2.push_back ("utilities.cl");                                                              // Setting 1st source file...
   kernel_2.push_back ("thekernel2.cl");                                                             // Setting 2nd source file...
   K2->init (bas, kernel_home, kernel_2, kernel_sx, kernel_sy, kernel_sz);                           // Initializing OpenCL kernel K2...
+#if DEVICE_INIT
+#if UNIFORM
+  kernel_init.push_back ("uniform.cl");                                                             // Single value node parameters...
+#endif
+#if MIXED
+  kernel_init.push_back ("mixed.cl");                                                               // Half precision history storage...
+#endif
+  kernel_init.push_back ("utilities.cl");                                                           // Setting 1st source file...
+  kernel_init.push_back ("grid_init.cl");                                                           // Setting 2nd source file...
+  K_init->init (bas, kernel_home, kernel_init, nodes_x, nodes_y, nodes_z);                          // Initializing OpenCL kernel K_init (3D lattice NDRange)...
+#endif
+#if ADAPTIVE
+#if UNIFORM
+  kernel_dt_reduce.push_back ("uniform.cl");                                                        // Single value node parameters...
+#endif
+  kernel_dt_reduce.push_back ("utilities.cl");                                                      // Setting 1st source file...
+  kernel_dt_reduce.push_back ("dt_reduce.cl");                                                      // Setting 2nd source file...
+  K_dt_reduce->init (bas, kernel_home, kernel_dt_reduce, dt_groups, kernel_sy, kernel_sz);          // Initializing OpenCL kernel K_dt_reduce...
+  kernel_dt_control.push_back ("utilities.cl");                                                     // Setting 1st source file...
+  kernel_dt_control.push_back ("dt_control.cl");                                                    // Setting 2nd source file...
+  K_dt_control->init (bas, kernel_home, kernel_dt_control, 1, kernel_sy, kernel_sz);                // Initializing OpenCL kernel K_dt_control...
+  kernel_dt_broadcast.push_back ("utilities.cl");                                                   // Setting 1st source file...
+  kernel_dt_broadcast.push_back ("dt_broadcast.cl");                                                // Setting 2nd source file...
+  K_dt_broadcast->init (bas, kernel_home, kernel_dt_broadcast, kernel_sx, kernel_sy, kernel_sz);    // Initializing OpenCL kernel K_dt_broadcast...
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////// SETTING OPENCL KERNEL ARGUMENTS /////////////////////////////////
@@ -660,15 +912,10 @@ int main ()
   K1->setarg (resting, 8);                                                                          // Setting resting position kernel argument...
   K1->setarg (friction, 9);                                                                         // Setting friction kernel argument...
   K1->setarg (mass, 10);                                                                            // Setting mass kernel argument...
-  K1->setarg (index_R, 11);                                                                         // Setting right neighbour index kernel argument...
-  K1->setarg (index_U, 12);                                                                         // Setting up neighbour index kernel argument...
-  K1->setarg (index_F, 13);                                                                         // Setting front neighbour index kernel argument...
-  K1->setarg (index_L, 14);                                                                         // Setting left neighbour index kernel argument...
-  K1->setarg (index_D, 15);                                                                         // Setting down neighbour index kernel argument...
-  K1->setarg (index_B, 16);                                                                         // Setting back neighbour index kernel argument...
-  K1->setarg (freedom, 17);                                                                         // Setting freedom flag kernel argument...
-  K1->setarg (radius, 18);                                                                          // Setting particle radius kernel argument...
-  K1->setarg (time, 19);                                                                            // Setting time step kernel argument...
+  K1->setarg (neighbour, 11);                                                                       // Setting packed neighbour indexes kernel argument...
+  K1->setarg (freedom, 12);                                                                         // Setting freedom flag kernel argument...
+  K1->setarg (radius, 13);                                                                          // Setting particle radius kernel argument...
+  K1->setarg (time, 14);                                                                            // Setting time step kernel argument...
 
   K2->setarg (position, 0);                                                                         // Setting position kernel argument...
   K2->setarg (color, 1);                                                                            // Setting depth kernel argument...
@@ -681,15 +928,52 @@ int main ()
   K2->setarg (resting, 8);                                                                          // Setting resting position kernel argument...
   K2->setarg (friction, 9);                                                                         // Setting friction kernel argument...
   K2->setarg (mass, 10);                                                                            // Setting mass kernel argument...
-  K2->setarg (index_R, 11);                                                                         // Setting right neighbour index kernel argument...
-  K2->setarg (index_U, 12);                                                                         // Setting up neighbour index kernel argument...
-  K2->setarg (index_F, 13);                                                                         // Setting front neighbour index kernel argument...
-  K2->setarg (index_L, 14);                                                                         // Setting left neighbour index kernel argument...
-  K2->setarg (index_D, 15);                                                                         // Setting down neighbour index kernel argument...
-  K2->setarg (index_B, 16);                                                                         // Setting back neighbour index kernel argument...
-  K2->setarg (freedom, 17);                                                                         // Setting freedom flag kernel argument...
-  K2->setarg (radius, 18);                                                                          // Setting particle radius kernel argument...
-  K2->setarg (time, 19);                                                                            // Setting time step kernel argument...
+  K2->setarg (neighbour, 11);                                                                       // Setting packed neighbour indexes kernel argument...
+  K2->setarg (freedom, 12);                                                                         // Setting freedom flag kernel argument...
+  K2->setarg (radius, 13);                                                                          // Setting particle radius kernel argument...
+  K2->setarg (time, 14);                                                                            // Setting time step kernel argument...
+
+#if ADAPTIVE
+  for(kernel* K : {K_dt_reduce, K_dt_control, K_dt_broadcast})
+  {
+    K->setarg (position, 0);                                                                        // Setting position kernel argument...
+    K->setarg (color, 1);                                                                           // Setting depth kernel argument...
+    K->setarg (position_int, 2);                                                                    // Setting intermediate position kernel argument...
+    K->setarg (velocity, 3);                                                                        // Setting velocity kernel argument...
+    K->setarg (velocity_int, 4);                                                                    // Setting intermediate velocity kernel argument...
+    K->setarg (acceleration, 5);                                                                    // Setting acceleration kernel argument...
+    K->setarg (acceleration_int, 6);                                                                // Setting intermediate acceleration kernel argument...
+    K->setarg (stiffness, 7);                                                                       // Setting stiffness kernel argument...
+    K->setarg (resting, 8);                                                                         // Setting resting position kernel argument...
+    K->setarg (friction, 9);                                                                        // Setting friction kernel argument...
+    K->setarg (mass, 10);                                                                           // Setting mass kernel argument...
+    K->setarg (neighbour, 11);                                                                      // Setting packed neighbour indexes kernel argument...
+    K->setarg (freedom, 12);                                                                        // Setting freedom flag kernel argument...
+    K->setarg (radius, 13);                                                                         // Setting particle radius kernel argument...
+    K->setarg (time, 14);                                                                           // Setting time step kernel argument...
+    K->setarg (dt_partial, 15);                                                                     // Setting time step partial maxima kernel argument...
+    K->setarg (dt_limits, 16);                                                                      // Setting time step limits kernel argument...
+  }
+#endif
+
+#if DEVICE_INIT
+  K_init->setarg (position, 0);                                                                     // Setting position kernel argument...
+  K_init->setarg (color, 1);                                                                        // Setting depth kernel argument...
+  K_init->setarg (position_int, 2);                                                                 // Setting intermediate position kernel argument...
+  K_init->setarg (velocity, 3);                                                                     // Setting velocity kernel argument...
+  K_init->setarg (velocity_int, 4);                                                                 // Setting intermediate velocity kernel argument...
+  K_init->setarg (acceleration, 5);                                                                 // Setting acceleration kernel argument...
+  K_init->setarg (acceleration_int, 6);                                                             // Setting intermediate acceleration kernel argument...
+  K_init->setarg (stiffness, 7);                                                                    // Setting stiffness kernel argument...
+  K_init->setarg (resting, 8);                                                                      // Setting resting position kernel argument...
+  K_init->setarg (friction, 9);                                                                     // Setting friction kernel argument...
+  K_init->setarg (mass, 10);                                                                        // Setting mass kernel argument...
+  K_init->setarg (neighbour, 11);                                                                   // Setting packed neighbour indexes kernel argument...
+  K_init->setarg (freedom, 12);                                                                     // Setting freedom flag kernel argument...
+  K_init->setarg (radius, 13);                                                                      // Setting particle radius kernel argument...
+  K_init->setarg (time, 14);                                                                        // Setting time step kernel argument...
+  K_init->setarg (grid, 15);                                                                        // Setting grid generation scalars kernel argument...
+#endif
 
   position->name = "voxel_center";                                                                  // Setting variable name for OpenGL shader...
   color->name    = "voxel_color";                                                                   // Setting variable name for OpenGL shader...
@@ -697,6 +981,15 @@ int main ()
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   //////////////////////////////////// WRITING DATA ON OPENCL QUEUE //////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
+#if DEVICE_INIT
+  // Node arrays generated on the device by K_init: only the intermediate state and the scalars written...
+  Q->write (position, 0);                                                                           // Writing position data (OpenGL buffer) on queue...
+  Q->write (color, 1);                                                                              // Writing depth data (OpenGL buffer) on queue...
+  Q->write (position_int, 2);                                                                       // Writing intermediate position data on queue...
+  Q->write (velocity_int, 4);                                                                       // Writing intermediate velocity data on queue...
+  Q->write (acceleration_int, 6);                                                                   // Writing intermediate acceleration data on queue...
+  Q->write (grid, 15);                                                                              // Writing grid generation scalars on queue...
+#else
   Q->write (position, 0);                                                                           // Writing position data on queue...
   Q->write (color, 1);                                                                              // Writing depth data on queue...
   Q->write (position_int, 2);                                                                       // Writing intermediate position data on queue...
@@ -708,16 +1001,28 @@ int main ()
   Q->write (resting, 8);                                                                            // Writing resting position data on queue...
   Q->write (friction, 9);                                                                           // Writing friction data on queue...
   Q->write (mass, 10);                                                                              // Writing mass data on queue...
-  Q->write (index_R, 11);                                                                           // Writing right neighbour index on queue...
-  Q->write (index_U, 12);                                                                           // Writing up neighbour index on queue...
-  Q->write (index_F, 13);                                                                           // Writing front neighbour index on queue...
-  Q->write (index_L, 14);                                                                           // Writing left neighbour index on queue...
-  Q->write (index_D, 15);                                                                           // Writing down neighbour index on queue...
-  Q->write (index_B, 16);                                                                           // Writing back neighbour index on queue...
-  Q->write (freedom, 17);                                                                           // Writing freedom flag data on queue...
-  Q->write (radius, 18);                                                                            // Writing particle radius data on queue...
-  Q->write (time, 19);                                                                              // Writing time step data on queue...
+  Q->write (neighbour, 11);                                                                         // Writing packed neighbour indexes on queue...
+  Q->write (freedom, 12);                                                                           // Writing freedom flag data on queue...
+  Q->write (radius, 13);                                                                            // Writing particle radius data on queue...
+  Q->write (time, 14);                                                                              // Writing time step data on queue...
+#endif
+
+#if ADAPTIVE
+  Q->write (dt_partial, 15);                                                                        // Writing time step partial maxima on queue...
+  Q->write (dt_limits, 16);                                                                         // Writing time step limits on queue...
+#endif
 
+#if DEVICE_INIT
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////// DEVICE GRID GENERATION //////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  Q->acquire (position, 0);                                                                         // Acquiring OpenGL/CL shared argument...
+  Q->acquire (color, 1);                                                                            // Acquiring OpenGL/CL shared argument...
+  ctx->execute (K_init, Q, NU_WAIT);                                                                // Generating the lattice on the device...
+  Q->release (position, 0);                                                                         // Releasing OpenGL/CL shared argument...
+  Q->release (color, 1);                                                                            // Releasing OpenGL/CL shared argument...
+
+#endif
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////// SETTING OPENGL SHADER ARGUMENTS ////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -739,6 +1044,61 @@ int main ()
     Q->acquire (color, 1);                                                                          // Acquiring OpenGL/CL shared argument...
     ctx->execute (K1, Q, NU_WAIT);                                                                  // Executing OpenCL kernel...
     ctx->execute (K2, Q, NU_WAIT);                                                                  // Executing OpenCL kernel...
+#if ADAPTIVE
+    ctx->execute (K_dt_reduce, Q, NU_WAIT);                                                         // Executing OpenCL kernel (time step partial maxima)...
+    ctx->execute (K_dt_control, Q, NU_WAIT);                                                        // Executing OpenCL kernel (next time step)...
+#if !UNIFORM
+    ctx->execute (K_dt_broadcast, Q, NU_WAIT);                                                      // Executing OpenCL kernel (time step broadcast)...
+#endif
+#endif
+
+#if CHECK_STEPS > 0
+    // CHECKING ACCURACY (same # of time steps in the float and MIXED builds):
+    if(time_step_index + 1 == CHECK_STEPS)
+    {
+      Q->read (position, 0);                                                                        // Reading position data from queue...
+#if MIXED
+      std::ifstream reference (CHECK_FILE);                                                         // Full float positions input file.
+      error_max = 0.0f;                                                                             // Resetting maximum position error [m]...
+      error_rms = 0.0;                                                                              // Resetting RMS position error [m]...
+
+      for(gid = 0; (gid < nodes) && (reference >> x_ref >> y_ref >> z_ref); gid++)
+      {
+        error      = sqrt (
+                           pow (position->data[gid].x - x_ref, 2) +
+                           pow (position->data[gid].y - y_ref, 2) +
+                           pow (position->data[gid].z - z_ref, 2)
+                          );                                                                        // Computing position error [m]...
+        error_max  = fmax (error_max, error);                                                       // Updating maximum position error [m]...
+        error_rms += error*error;                                                                   // Accumulating squared position error [m^2]...
+      }
+
+      if(gid < nodes)
+      {
+        std::cerr << "Error: " << CHECK_FILE << " does not contain " << nodes << " nodes." << std::endl;
+      }
+      else
+      {
+        error_rms = sqrt (error_rms/nodes);                                                         // Computing RMS position error [m]...
+        std::cout << "Position error vs " << CHECK_FILE << " after " << CHECK_STEPS
+                  << " time steps (max, RMS) = " << error_max << ", " << error_rms << " [m]" << std::endl;
+      }
+#else
+      std::ofstream output (CHECK_FILE);                                                            // Full float positions output file.
+      output.precision (9);                                                                         // Setting float round-trip precision...
+
+      for(gid = 0; gid < nodes; gid++)
+      {
+        output << position->data[gid].x << " " << position->data[gid].y << " " << position->data[gid].z << "\n";
+      }
+
+      std::cout << "Positions after " << CHECK_STEPS << " time steps saved in " << CHECK_FILE << std::endl;
+#endif
+    }
+#endif
+
+    time_step_index++;                                                                              // Updating time step index [#]...
+
     Q->release (position, 0);                                                                       // Releasing OpenGL/CL shared argument...
     Q->release (color, 1);                                                                          // Releasing OpenGL/CL shared argument...
 
@@ -788,19 +1148,29 @@ int main ()
   delete mass;                                                                                      // Deleting mass data...
   delete radius;                                                                                    // Deleting particle radius data...
 
-  delete index_R;                                                                                   // Deleting right neighbour index...
-  delete index_U;                                                                                   // Deleting up neighbour index...
-  delete index_F;                                                                                   // Deleting front neighbour index...
-  delete index_L;                                                                                   // Deleting left neighbour index...
-  delete index_D;                                                                                   // Deleting down neighbour index...
-  delete index_B;                                                                                   // Deleting back neighbour index...
+  delete neighbour;                                                                                 // Deleting packed neighbour indexes...
 
   delete freedom;                                                                                   // Deleting freedom flag data...
   delete time;                                                                                      // Deleting time step data...
+#if DEVICE_INIT
+  delete grid;                                                                                      // Deleting grid generation scalars...
+#endif
+#if ADAPTIVE
+  delete dt_partial;                                                                                // Deleting time step partial maxima...
+  delete dt_limits;                                                                                 // Deleting time step limits...
+#endif
 
   delete Q;                                                                                         // Deleting OpenCL queue...
   delete K1;                                                                                        // Deleting OpenCL kernel...
   delete K2;                                                                                        // Deleting OpenCL kernel...
+#if DEVICE_INIT
+  delete K_init;                                                                                    // Deleting OpenCL kernel...
+#endif
+#if ADAPTIVE
+  delete K_dt_reduce;                                                                               // Deleting OpenCL kernel...
+  delete K_dt_control;                                                                              // Deleting OpenCL kernel...
+  delete K_dt_broadcast;                                                                            // Deleting OpenCL kernel...
+#endif
 
   return 0;
 }
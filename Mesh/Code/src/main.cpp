@@ -29,12 +29,21 @@
 #define SHADER_FRAG   "voxel_fragment.frag"                                                         // OpenGL fragment shader.
 #define GMSH_MESH     "Utah_teapot.msh"                                                             // GMSH mesh.
 
+// NODE RENUMBERING (after loading the mesh):
+#define RENUMBER_NONE    0                                                                          // gmsh node numbering.
+#define RENUMBER_RCM     1                                                                          // Reverse Cuthill-McKee (minimum bandwidth).
+#define RENUMBER_HILBERT 2                                                                          // Hilbert curve of the node positions (spatial locality).
+#define RENUMBER      RENUMBER_NONE                                                                 // Node renumbering.
+#define RENUMBER_FILE "renumbering.txt"                                                             // New to original (gmsh) node index mapping output file.
+
 // OPENCL:
 #define QUEUE_NUM     1                                                                             // # of OpenCL queues [#].
 #define KERNEL_NUM    1                                                                             // # of OpenCL kernel [#].
 
 // INCLUDES:
 #include "nu.hpp"                                                                                   // Neutrino's header file.
+#include "mesh_reorder.hpp"                                                                         // Node renumbering.
+#include <fstream>                                                                                  // Node index mapping file.
 
 int main ()
 {
@@ -88,6 +97,11 @@ int main ()
   size_t                   border_nodes;                                                            // Number of border nodes.
   std::vector<size_t>      neighbour;                                                               // Neighbours.
   std::vector<size_t>      border;                                                                  // Border nodes.
+  std::vector<cl_uint>     mesh_offset;                                                             // Neighbour stride start (original indexes) [#].
+  std::vector<cl_uint>     mesh_nearest;                                                            // Neighbour indexes (original indexes) [#].
+  std::vector<size_t>      original;                                                                // Original (gmsh) index of each node [#].
+  std::vector<size_t>      renumber;                                                                // New index of each original node [#].
+  size_t                   bandwidth_gmsh;                                                          // Bandwidth of the gmsh numbering [#].
 
   // NODE KINEMATICS:
   float4G*                 color              = new float4G ();                                     // Color.
@@ -100,6 +114,44 @@ int main ()
   nodes       = object->node.size ();
   elements    = object->element.size ();
 
+  // RENUMBERING NODES:
+  mesh_offset.push_back (0);                                                                        // Setting first stride start...
+
+  for(gid = 0; gid < nodes; gid++)
+  {
+    neighbour = object->neighbours (gid);                                                           // Getting neighbourhood (original indexes)...
+    mesh_nearest.insert (mesh_nearest.end (), neighbour.begin (), neighbour.end ());                // Appending neighbour indexes...
+    mesh_offset.push_back (mesh_nearest.size ());                                                   // Setting next stride start...
+    original.push_back (gid);                                                                       // Setting gmsh order...
+  }
+
+  bandwidth_gmsh = bandwidth (mesh_offset, mesh_nearest, original);                                 // Computing gmsh numbering bandwidth...
+
+#if RENUMBER == RENUMBER_RCM
+  original = rcm_order (mesh_offset, mesh_nearest);                                                 // Ordering nodes by reverse Cuthill-McKee...
+#elif RENUMBER == RENUMBER_HILBERT
+  original = hilbert_order (object);                                                                // Ordering nodes along a Hilbert curve...
+#endif
+
+  renumber.resize (nodes);                                                                          // Initializing new node indexes...
+
+  for(gid = 0; gid < nodes; gid++)
+  {
+    renumber[original[gid]] = gid;                                                                  // Inverting node order...
+  }
+
+#if RENUMBER != RENUMBER_NONE
+  std::cout << "Node bandwidth: gmsh = " << bandwidth_gmsh << ", renumbered = " << bandwidth (mesh_offset, mesh_nearest, renumber)
+            << std::endl;
+
+  std::ofstream renumbering (RENUMBER_FILE);                                                        // Node index mapping output file.
+
+  for(gid = 0; gid < nodes; gid++)
+  {
+    renumbering << gid << " " << original[gid] << "\n";                                             // Writing new and original node index...
+  }
+#endif
+
   color->init (nodes);                                                                              // Initializing depth data...
   node->init (nodes);                                                                               // Initializing position data...
 
@@ -114,9 +166,9 @@ int main ()
   for(gid = 0; gid < nodes; gid++)
   {
     std::cout << "Node " << gid << ": has coordinates: ";                                           // Printing message...
-    std::cout << "x = " << object->node[gid].x << " ";                                              // Printing message...
-    std::cout << "y = " << object->node[gid].y << " ";                                              // Printing message...
-    std::cout << "z = " << object->node[gid].z << std::endl;                                        // Printing message...
+    std::cout << "x = " << object->node[original[gid]].x << " ";                                    // Printing message...
+    std::cout << "y = " << object->node[original[gid]].y << " ";                                    // Printing message...
+    std::cout << "z = " << object->node[original[gid]].z << std::endl;                              // Printing message...
   }
 
   std::cout << std::endl;                                                                           // Printing message...
@@ -126,13 +178,12 @@ int main ()
 
   for(gid = 0; gid < nodes; gid++)
   {
-    neighbour  = object->neighbours (gid);
-    neighbours = neighbour.size ();
+    neighbours = mesh_offset[original[gid] + 1];
     std::cout << "Node " << gid << ": has neighbour nodes: ";                                       // Printing message...
 
-    for(int i = 0; i < neighbours; i++)
+    for(size_t i = mesh_offset[original[gid]]; i < neighbours; i++)
     {
-      std::cout << neighbour[i] << " ";                                                             // Printing message...
+      std::cout << renumber[mesh_nearest[i]] << " ";                                                // Printing message...
     }
 
     std::cout << std::endl;                                                                         // Printing message...
@@ -149,7 +200,7 @@ int main ()
 
   for(int i = 0; i < border_nodes; i++)
   {
-    std::cout << border[i] << " ";                                                                  // Printing message...
+    std::cout << renumber[border[i]] << " ";                                                        // Printing message...
   }
 
   std::cout << std::endl;                                                                           // Printing message...
@@ -163,9 +214,9 @@ int main ()
   {
     std::cout << "Node " << gid << ": is in a group of elements: ";                                 // Printing message...
 
-    for(int i = 0; i < object->group[gid].element.size (); i++)
+    for(int i = 0; i < object->group[original[gid]].element.size (); i++)
     {
-      std::cout << object->group[gid].element[i] << " ";                                            // Printing message...
+      std::cout << object->group[original[gid]].element[i] << " ";                                  // Printing message...
     }
 
     std::cout << std::endl;                                                                         // Printing message...
@@ -182,7 +233,7 @@ int main ()
 
     for(int i = 0; i < object->element[gid].node.size (); i++)
     {
-      std::cout << object->element[gid].node[i] << " ";                                             // Printing message...
+      std::cout << renumber[object->element[gid].node[i]] << " ";                                   // Printing message...
     }
 
     std::cout << std::endl;                                                                         // Printing message...
@@ -192,10 +243,10 @@ int main ()
 
   for(gid = 0; gid < nodes; gid++)
   {
-    node->data[gid].x  = object->node[gid].x;                                                       // Setting "x" node coordinate...
-    node->data[gid].y  = object->node[gid].y;                                                       // Setting "y" node coordinate...
-    node->data[gid].z  = object->node[gid].z;                                                       // Setting "z" node coordinate...
-    node->data[gid].w  = object->node[gid].w;                                                       // Setting "w" node coordinate...
+    node->data[gid].x  = object->node[original[gid]].x;                                             // Setting "x" node coordinate...
+    node->data[gid].y  = object->node[original[gid]].y;                                             // Setting "y" node coordinate...
+    node->data[gid].z  = object->node[original[gid]].z;                                             // Setting "z" node coordinate...
+    node->data[gid].w  = object->node[original[gid]].w;                                             // Setting "w" node coordinate...
 
     color->data[gid].x = 0.01f*(rand () % 100);                                                     // Setting "r" color coordinate...
     color->data[gid].y = 0.01f*(rand () % 100);                                                     // Setting "g" color coordinate...
@@ -12,7 +12,7 @@
 __kernel void thekernel (
         __global float4*    voxel_point,                                                            ///< Voxel point coordinates.
         __global float4*    voxel_color,                                                            ///< Voxel color coordinates.
-        __global float*     time                                                                    ///< Time [s].
+        __constant float*   time                                                                    ///< Time [s] (single value for all nodes).
         )
 {
         //////////////////////////////////////////////////////////////////////////////////////////////
@@ -30,13 +30,10 @@ __kernel void thekernel (
         P = voxel_point[gid];                                                                       // Getting voxel point...
         C = voxel_color[gid];                                                                       // Getting voxel color...
 
-        t = time[gid];                                                                              // Getting simulation time...
+        t = time[0];                                                                                // Getting simulation time...
 
         P.z = 0.1f*sin(10.0f*P.x - 0.1f*t) + 0.1f*cos(10.0f*P.y - 0.1f*t);                          // Computing "z" point coordinate...
-        t += 0.1;                                                                                   // Incrementing simulation time...
 
         voxel_point[gid] = P;                                                                       // Setting voxel point...
         voxel_color[gid] = C;                                                                       // Setting voxel color...
-
-        time[gid] = t;                                                                              // Setting simulation time...
 }
@@ -94,7 +94,8 @@ int main ()
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   position->init (nodes);                                                                           // Initializing OpenGL point array...
   color->init (nodes);                                                                              // Initializing OpenGL color array...
-  t->init (nodes);                                                                                  // Initializing time...
+  t->init (1);                                                                                      // Initializing time (single value for all nodes)...
+  t->data[0] = 0.0f;                                                                                // Setting time...
 
   position->name = "voxel_center";                                                                  // Setting variable name in OpenGL shader...
   color->name    = "voxel_color";                                                                   // Setting variable name in OpenGL shader...
@@ -117,9 +118,6 @@ int main ()
       color->data[gid].y    = 0.01f*(rand () % 100);                                                // Setting "g" color coordinate...
       color->data[gid].z    = 0.01f*(rand () % 100);                                                // Setting "b" color coordinate...
       color->data[gid].w    = 1.0f;                                                                 // Setting "a" color coordinate...
-
-      // Setting time:
-      t->data[gid]          = 0.0f;                                                                 // Setting time...
     }
   }
 
@@ -234,7 +232,7 @@ int main ()
 
     gui->plot (S);                                                                                  // Plotting shared arguments...
 
-    Q->read (t, 2);                                                                                 // Reading time from OpenCL queue...
+    t->data[0] += 0.1f;                                                                             // Incrementing simulation time...
 
     gui->refresh ();                                                                                // Refreshing gui...
     bas->get_toc ();                                                                                // Getting "toc" [us]...